@@ -0,0 +1,8 @@
+CREATE TABLE IF NOT EXISTS audio_analysis (
+  content_key TEXT PRIMARY KEY,
+  fingerprint TEXT,
+  ebur128_integrated_loudness_lufs REAL,
+  ebur128_loudness_range_lu REAL
+);
+
+UPDATE schema_version SET version=23;
@@ -0,0 +1,8 @@
+CREATE TABLE IF NOT EXISTS compilation_groups (
+  songs_table TEXT NOT NULL,
+  album TEXT NOT NULL,
+  directory TEXT NOT NULL,
+  PRIMARY KEY (songs_table, album, directory)
+);
+
+UPDATE schema_version SET version=24;
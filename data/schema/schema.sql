@@ -4,7 +4,7 @@ CREATE TABLE IF NOT EXISTS schema_version (
 
 DELETE FROM schema_version;
 
-INSERT INTO schema_version (version) VALUES (22);
+INSERT INTO schema_version (version) VALUES (24);
 
 CREATE TABLE IF NOT EXISTS directories (
   path TEXT NOT NULL,
@@ -1389,6 +1389,20 @@ CREATE TABLE IF NOT EXISTS radio_channels (
   thumbnail_url TEXT
 );
 
+CREATE TABLE IF NOT EXISTS audio_analysis (
+  content_key TEXT PRIMARY KEY,
+  fingerprint TEXT,
+  ebur128_integrated_loudness_lufs REAL,
+  ebur128_loudness_range_lu REAL
+);
+
+CREATE TABLE IF NOT EXISTS compilation_groups (
+  songs_table TEXT NOT NULL,
+  album TEXT NOT NULL,
+  directory TEXT NOT NULL,
+  PRIMARY KEY (songs_table, album, directory)
+);
+
 CREATE INDEX IF NOT EXISTS idx_url ON songs (url);
 
 CREATE INDEX IF NOT EXISTS idx_comp_artist ON songs (compilation_effective, artist);
@@ -29,6 +29,7 @@
 #include <QApplication>
 #include <QThread>
 #include <QMutex>
+#include <QTimer>
 #include <QSet>
 #include <QMap>
 #include <QList>
@@ -48,8 +49,10 @@
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
 #include "core/database.h"
+#include "core/tracing.h"
 #include "core/scopedtransaction.h"
 #include "core/song.h"
+#include "covermanager/covercacheindex.h"
 
 #include "collectiondirectory.h"
 #include "collectionbackend.h"
@@ -59,15 +62,26 @@
 
 using namespace Qt::Literals::StringLiterals;
 
+namespace {
+constexpr int kFlushStatisticsDelayMsec = 1000;
+constexpr qsizetype kMaxPendingStatistics = 500;
+constexpr qsizetype kMaxUrlsPerQuery = 200;
+}  // namespace
+
 CollectionBackend::CollectionBackend(QObject *parent)
     : CollectionBackendInterface(parent),
       db_(nullptr),
       task_manager_(nullptr),
       source_(Song::Source::Unknown),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      timer_flush_statistics_(new QTimer(this)) {
 
   original_thread_ = thread();
 
+  timer_flush_statistics_->setSingleShot(true);
+  timer_flush_statistics_->setInterval(kFlushStatisticsDelayMsec);
+  QObject::connect(timer_flush_statistics_, &QTimer::timeout, this, &CollectionBackend::FlushStatistics);
+
 }
 
 CollectionBackend::~CollectionBackend() {
@@ -92,7 +106,7 @@ void CollectionBackend::Init(SharedPtr<Database> db, SharedPtr<TaskManager> task
 void CollectionBackend::Close() {
 
   if (db_) {
-    QMutexLocker l(db_->Mutex());
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
     db_->Close();
   }
 
@@ -106,6 +120,8 @@ void CollectionBackend::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
 
+  FlushStatistics();
+
   moveToThread(original_thread_);
   Q_EMIT ExitFinished();
 
@@ -130,8 +146,7 @@ void CollectionBackend::GetAllSongsAsync(const int id) {
 
 void CollectionBackend::GetAllSongs(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.setForwardOnly(true);
@@ -143,10 +158,13 @@ void CollectionBackend::GetAllSongs(const int id) {
   }
 
   SongList songs;
-  while (q.next()) {
-    Song song(source_);
-    song.InitFromQuery(q, true);
-    songs << song;
+  {
+    CoverCacheIndex::Batch cover_cache_batch;
+    while (q.next()) {
+      Song song(source_);
+      song.InitFromQuery(q, true);
+      songs << song;
+    }
   }
 
   Q_EMIT GotSongs(songs, id);
@@ -189,8 +207,7 @@ void CollectionBackend::LoadDirectories() {
 
   const CollectionDirectoryList dirs = GetAllDirectories();
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   for (const CollectionDirectory &dir : dirs) {
     Q_EMIT DirectoryAdded(dir, SubdirsInDirectory(dir.id, db));
@@ -200,7 +217,7 @@ void CollectionBackend::LoadDirectories() {
 
 void CollectionBackend::ChangeDirPath(const int id, const QString &old_path, const QString &new_path) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
   ScopedTransaction t(&db);
 
@@ -251,8 +268,7 @@ void CollectionBackend::ChangeDirPath(const int id, const QString &old_path, con
 
 CollectionDirectoryList CollectionBackend::GetAllDirectories() {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionDirectoryList ret;
 
@@ -276,8 +292,7 @@ CollectionDirectoryList CollectionBackend::GetAllDirectories() {
 
 CollectionSubdirectoryList CollectionBackend::SubdirsInDirectory(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db = db_->Connect();
+  QSqlDatabase db = db_->ConnectReadOnly();
   return SubdirsInDirectory(id, db);
 
 }
@@ -307,8 +322,7 @@ CollectionSubdirectoryList CollectionBackend::SubdirsInDirectory(const int id, Q
 
 void CollectionBackend::UpdateTotalSongCount() {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT COUNT(*) FROM %1 WHERE unavailable = 0").arg(songs_table_));
@@ -327,8 +341,7 @@ void CollectionBackend::UpdateTotalSongCount() {
 
 void CollectionBackend::UpdateTotalArtistCount() {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT COUNT(DISTINCT artist) FROM %1 WHERE unavailable = 0").arg(songs_table_));
@@ -347,8 +360,7 @@ void CollectionBackend::UpdateTotalArtistCount() {
 
 void CollectionBackend::UpdateTotalAlbumCount() {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT COUNT(*) FROM (SELECT DISTINCT effective_albumartist, album FROM %1 WHERE unavailable = 0)").arg(songs_table_));
@@ -371,7 +383,7 @@ void CollectionBackend::AddDirectoryAsync(const QString &path) {
 
 void CollectionBackend::AddDirectory(const QString &path) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   {
@@ -412,7 +424,7 @@ void CollectionBackend::RemoveDirectory(const CollectionDirectory &dir) {
   // Remove songs first
   DeleteSongs(FindSongsInDirectory(dir.id));
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -447,8 +459,7 @@ void CollectionBackend::RemoveDirectory(const CollectionDirectory &dir) {
 
 SongList CollectionBackend::FindSongsInDirectory(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE directory_id = :directory_id").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -470,8 +481,7 @@ SongList CollectionBackend::FindSongsInDirectory(const int id) {
 
 SongList CollectionBackend::SongsWithMissingFingerprint(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE directory_id = :directory_id AND unavailable = 0 AND (fingerprint IS NULL OR fingerprint = '')").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -493,8 +503,7 @@ SongList CollectionBackend::SongsWithMissingFingerprint(const int id) {
 
 SongList CollectionBackend::SongsWithMissingLoudnessCharacteristics(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE directory_id = :directory_id AND unavailable = 0 AND (ebur128_integrated_loudness_lufs IS NULL OR ebur128_loudness_range_lu IS NULL)").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -532,7 +541,7 @@ void CollectionBackend::SongPathChanged(const Song &song, const QFileInfo &new_f
 
 void CollectionBackend::AddOrUpdateSubdirs(const CollectionSubdirectoryList &subdirs) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -594,8 +603,7 @@ void CollectionBackend::AddOrUpdateSubdirs(const CollectionSubdirectoryList &sub
 
 SongList CollectionBackend::GetAllSongs() {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -605,6 +613,7 @@ SongList CollectionBackend::GetAllSongs() {
   }
 
   SongList songs;
+  CoverCacheIndex::Batch cover_cache_batch;
   while (q.next()) {
     Song song;
     song.InitFromQuery(q, true);
@@ -620,7 +629,7 @@ void CollectionBackend::AddOrUpdateSongsAsync(const SongList &songs) {
 
 void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   CollectionTask task(task_manager_, tr("Updating %1 database.").arg(Song::TextForSource(source_)));
@@ -649,7 +658,7 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
     if (song.id() != -1) {  // This song exists in the DB.
 
       // Get the previous song data first
-      Song old_song(GetSongById(song.id()));
+      Song old_song(GetSongById(song.id(), db));
       if (!old_song.is_valid()) continue;
 
       // Update
@@ -664,6 +673,8 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
         }
       }
 
+      AddCompilationGroup(db, old_song);
+      AddCompilationGroup(db, song);
       changed_songs << song;
 
       continue;
@@ -672,7 +683,7 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
     else if (!song.song_id().isEmpty()) {  // Song has a unique id, check if the song exists.
 
       // Get the previous song data first
-      Song old_song(GetSongBySongId(song.song_id()));
+      Song old_song(GetSongBySongId(song.song_id(), db));
 
       if (old_song.is_valid() && old_song.id() != -1) {
 
@@ -691,6 +702,8 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
           }
         }
 
+        AddCompilationGroup(db, old_song);
+        AddCompilationGroup(db, new_song);
         changed_songs << new_song;
 
         continue;
@@ -716,6 +729,7 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
     Song song_copy(song);
     song_copy.set_id(id);
+    AddCompilationGroup(db, song_copy);
     added_songs << song_copy;
 
   }
@@ -737,7 +751,7 @@ void CollectionBackend::UpdateSongsBySongIDAsync(const SongMap &new_songs) {
 
 void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   CollectionTask task(task_manager_, tr("Updating %1 database.").arg(Song::TextForSource(source_)));
@@ -778,6 +792,8 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
         Song new_song_copy(new_song);
         new_song_copy.set_id(old_song.id());
+        AddCompilationGroup(db, old_song);
+        AddCompilationGroup(db, new_song_copy);
         changed_songs << new_song_copy;
 
       }
@@ -801,6 +817,7 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
       Song new_song_copy(new_song);
       new_song_copy.set_id(id);
+      AddCompilationGroup(db, new_song_copy);
       added_songs << new_song_copy;
     }
   }
@@ -818,6 +835,7 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
           return;
         }
       }
+      AddCompilationGroup(db, old_song);
       deleted_songs << old_song;
     }
   }
@@ -836,7 +854,7 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
 void CollectionBackend::UpdateMTimesOnly(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -860,7 +878,7 @@ void CollectionBackend::DeleteSongsAsync(const SongList &songs) {
 
 void CollectionBackend::DeleteSongs(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -872,6 +890,7 @@ void CollectionBackend::DeleteSongs(const SongList &songs) {
       db_->ReportErrors(q);
       return;
     }
+    AddCompilationGroup(db, song);
   }
 
   transaction.Commit();
@@ -904,7 +923,7 @@ void CollectionBackend::DeleteSongsByUrls(const QList<QUrl> &urls) {
 
 void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool unavailable) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   SqlQuery query(db);
@@ -917,6 +936,7 @@ void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool u
       db_->ReportErrors(query);
       return;
     }
+    AddCompilationGroup(db, song);
   }
   transaction.Commit();
 
@@ -935,8 +955,7 @@ void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool u
 
 QStringList CollectionBackend::GetAll(const QString &column, const CollectionFilterOptions &filter_options) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, filter_options);
   query.SetColumnSpec(u"DISTINCT "_s + column);
@@ -963,8 +982,7 @@ QStringList CollectionBackend::GetAllArtists(const CollectionFilterOptions &opt)
 
 QStringList CollectionBackend::GetAllArtistsWithAlbums(const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   // Albums with 'albumartist' field set:
   CollectionQuery query(db, songs_table_, opt);
@@ -1011,8 +1029,7 @@ CollectionBackend::AlbumList CollectionBackend::GetAlbumsByArtist(const QString
 
 SongList CollectionBackend::GetArtistSongs(const QString &effective_albumartist, const CollectionFilterOptions &opt) {
 
-  QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1029,8 +1046,7 @@ SongList CollectionBackend::GetArtistSongs(const QString &effective_albumartist,
 
 SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist, const QString &album, const CollectionFilterOptions &opt) {
 
-  QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1048,8 +1064,7 @@ SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist,
 
 SongList CollectionBackend::GetSongsByAlbum(const QString &album, const CollectionFilterOptions &opt) {
 
-  QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1070,6 +1085,7 @@ bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &so
 
   if (!query->Exec()) return false;
 
+  CoverCacheIndex::Batch cover_cache_batch;
   while (query->Next()) {
     Song song(source_);
     song.InitFromQuery(*query, true);
@@ -1085,6 +1101,7 @@ bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &son
 
   if (!query->Exec()) return false;
 
+  CoverCacheIndex::Batch cover_cache_batch;
   while (query->Next()) {
     Song song(source_);
     song.InitFromQuery(*query, true);
@@ -1096,16 +1113,14 @@ bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &son
 
 Song CollectionBackend::GetSongById(const int id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
   return GetSongById(id, db);
 
 }
 
 SongList CollectionBackend::GetSongsById(const QList<int> &ids) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   QStringList str_ids;
   str_ids.reserve(ids.count());
@@ -1119,8 +1134,7 @@ SongList CollectionBackend::GetSongsById(const QList<int> &ids) {
 
 SongList CollectionBackend::GetSongsById(const QStringList &ids) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   return GetSongsById(ids, db);
 
@@ -1128,8 +1142,7 @@ SongList CollectionBackend::GetSongsById(const QStringList &ids) {
 
 SongList CollectionBackend::GetSongsByForeignId(const QStringList &ids, const QString &table, const QString &column) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   QString in = ids.join(u',');
 
@@ -1183,8 +1196,7 @@ SongList CollectionBackend::GetSongsById(const QStringList &ids, QSqlDatabase &d
 
 Song CollectionBackend::GetSongByUrl(const QUrl &url, const qint64 beginning) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE (url = :url1 OR url = :url2 OR url = :url3 OR url = :url4) AND beginning = :beginning AND unavailable = 0").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -1212,8 +1224,7 @@ Song CollectionBackend::GetSongByUrl(const QUrl &url, const qint64 beginning) {
 
 Song CollectionBackend::GetSongByUrlAndTrack(const QUrl &url, const int track) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE (url = :url1 OR url = :url2 OR url = :url3 OR url = :url4) AND track = :track AND unavailable = 0").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -1239,10 +1250,94 @@ Song CollectionBackend::GetSongByUrlAndTrack(const QUrl &url, const int track) {
 
 }
 
+SongList CollectionBackend::GetSongsByUrls(const QList<QUrl> &urls) {
+
+  QSqlDatabase db(db_->ConnectReadOnly());
+
+  SongList songs;
+  // Each URL is bound in the same four encodings as in GetSongByUrl(), keep below the SQLite limit of 999 parameters.
+  for (qsizetype i = 0; i < urls.count(); i += kMaxUrlsPerQuery) {
+    const QList<QUrl> urls_chunk = urls.mid(i, kMaxUrlsPerQuery);
+    QStringList placeholders;
+    placeholders.reserve(urls_chunk.count() * 4);
+    for (qsizetype j = 0; j < urls_chunk.count() * 4; ++j) {
+      placeholders << u":url%1"_s.arg(j);
+    }
+
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE url IN (%3) AND unavailable = 0").arg(Song::kRowIdColumnSpec, songs_table_, placeholders.join(u',')));
+    for (qsizetype j = 0; j < urls_chunk.count(); ++j) {
+      const QUrl &url = urls_chunk[j];
+      q.BindValue(placeholders[j * 4], url.toString());
+      q.BindValue(placeholders[j * 4 + 1], url.toString(QUrl::FullyEncoded));
+      q.BindValue(placeholders[j * 4 + 2], url.toEncoded(QUrl::FullyDecoded));
+      q.BindValue(placeholders[j * 4 + 3], url.toEncoded(QUrl::FullyEncoded));
+    }
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return SongList();
+    }
+
+    CoverCacheIndex::Batch cover_cache_batch;
+    while (q.next()) {
+      Song song(source_);
+      song.InitFromQuery(q, true);
+      songs << song;
+    }
+  }
+
+  return songs;
+
+}
+
+SongList CollectionBackend::SearchSongs(const QStringList &tokens, const QStringList &columns, const int limit) {
+
+  if (columns.isEmpty()) return SongList();
+
+  QStringList patterns;
+  QStringList where;
+  for (const QString &token : tokens) {
+    if (token.isEmpty()) continue;
+    QString pattern = token;
+    pattern.replace(u'\\', "\\\\"_L1).replace(u'%', "\\%"_L1).replace(u'_', "\\_"_L1);
+    QStringList columns_where;
+    for (const QString &column : columns) {
+      columns_where << u"%1 LIKE :token%2_%3 ESCAPE '\\'"_s.arg(column).arg(patterns.count()).arg(columns_where.count());
+    }
+    where << u"(%1)"_s.arg(columns_where.join(" OR "_L1));
+    patterns << u"%%1%"_s.arg(pattern);
+  }
+  if (where.isEmpty()) return SongList();
+
+  QSqlDatabase db(db_->ConnectReadOnly());
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE unavailable = 0 AND %3 LIMIT :limit").arg(Song::kRowIdColumnSpec, songs_table_, where.join(" AND "_L1)));
+  for (qsizetype i = 0; i < patterns.count(); ++i) {
+    for (qsizetype j = 0; j < columns.count(); ++j) {
+      q.BindValue(u":token%1_%2"_s.arg(i).arg(j), patterns[i]);
+    }
+  }
+  q.BindValue(u":limit"_s, limit);
+
+  SongList songs;
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return SongList();
+  }
+  while (q.next()) {
+    Song song(source_);
+    song.InitFromQuery(q, true);
+    songs << song;
+  }
+
+  return songs;
+
+}
+
 SongList CollectionBackend::GetSongsByUrl(const QUrl &url, const bool unavailable) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE (url = :url1 OR url = :url2 OR url = :url3 OR url = :url4) AND unavailable = :unavailable").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -1270,16 +1365,14 @@ SongList CollectionBackend::GetSongsByUrl(const QUrl &url, const bool unavailabl
 
 Song CollectionBackend::GetSongBySongId(const QString &song_id) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
   return GetSongBySongId(song_id, db);
 
 }
 
 SongList CollectionBackend::GetSongsBySongId(const QStringList &song_ids) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   return GetSongsBySongId(song_ids, db);
 
@@ -1322,8 +1415,7 @@ SongList CollectionBackend::GetSongsBySongId(const QStringList &song_ids, QSqlDa
 
 SongList CollectionBackend::GetSongsByFingerprint(const QString &fingerprint) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE fingerprint = :fingerprint").arg(Song::kRowIdColumnSpec, songs_table_));
@@ -1344,6 +1436,84 @@ SongList CollectionBackend::GetSongsByFingerprint(const QString &fingerprint) {
 
 }
 
+bool CollectionBackend::GetAudioAnalysis(const QString &content_key, QString *fingerprint, std::optional<EBUR128Measures> *ebur128_measures) {
+
+  QSqlDatabase db(db_->ConnectReadOnly());
+
+  SqlQuery q(db);
+  q.prepare(u"SELECT fingerprint, ebur128_integrated_loudness_lufs, ebur128_loudness_range_lu FROM audio_analysis WHERE content_key = :content_key"_s);
+  q.BindValue(u":content_key"_s, content_key);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return false;
+  }
+
+  if (!q.next()) return false;
+
+  bool found = true;
+
+  if (fingerprint) {
+    if (q.value(0).isNull()) {
+      found = false;
+    }
+    else {
+      *fingerprint = q.value(0).toString();
+    }
+  }
+
+  // The loudness range is not measured for very short tracks, the integrated loudness is enough.
+  if (ebur128_measures) {
+    if (q.value(1).isNull()) {
+      found = false;
+    }
+    else {
+      EBUR128Measures measures;
+      measures.loudness_lufs = q.value(1).toDouble();
+      if (!q.value(2).isNull()) {
+        measures.range_lu = q.value(2).toDouble();
+      }
+      *ebur128_measures = measures;
+    }
+  }
+
+  return found;
+
+}
+
+void CollectionBackend::AddAudioAnalysis(const QString &content_key, const QString &fingerprint, const std::optional<EBUR128Measures> &ebur128_measures) {
+
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
+  QSqlDatabase db(db_->Connect());
+
+  ScopedTransaction t(&db);
+
+  {
+    SqlQuery q(db);
+    q.prepare(u"INSERT OR IGNORE INTO audio_analysis (content_key) VALUES (:content_key)"_s);
+    q.BindValue(u":content_key"_s, content_key);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  // Results that were not computed this time keep their cached value.
+  {
+    SqlQuery q(db);
+    q.prepare(u"UPDATE audio_analysis SET fingerprint = COALESCE(:fingerprint, fingerprint), ebur128_integrated_loudness_lufs = COALESCE(:ebur128_integrated_loudness_lufs, ebur128_integrated_loudness_lufs), ebur128_loudness_range_lu = COALESCE(:ebur128_loudness_range_lu, ebur128_loudness_range_lu) WHERE content_key = :content_key"_s);
+    q.BindValue(u":fingerprint"_s, fingerprint.isEmpty() ? QVariant() : QVariant(fingerprint));
+    q.BindValue(u":ebur128_integrated_loudness_lufs"_s, ebur128_measures && ebur128_measures->loudness_lufs ? QVariant(*ebur128_measures->loudness_lufs) : QVariant());
+    q.BindValue(u":ebur128_loudness_range_lu"_s, ebur128_measures && ebur128_measures->range_lu ? QVariant(*ebur128_measures->range_lu) : QVariant());
+    q.BindValue(u":content_key"_s, content_key);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  t.Commit();
+
+}
 
 CollectionBackend::AlbumList CollectionBackend::GetCompilationAlbums(const CollectionFilterOptions &opt) {
   return GetAlbums(QString(), true, opt);
@@ -1351,8 +1521,7 @@ CollectionBackend::AlbumList CollectionBackend::GetCompilationAlbums(const Colle
 
 SongList CollectionBackend::GetCompilationSongs(const QString &album, const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, opt);
   query.SetColumnSpec(u"%songs_table.ROWID, "_s + Song::kColumnSpec);
@@ -1374,40 +1543,107 @@ SongList CollectionBackend::GetCompilationSongs(const QString &album, const Coll
 
 }
 
-void CollectionBackend::CompilationsNeedUpdating() {
+QStringList CollectionBackendInterface::UrlEncodings(const QUrl &url) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QStringList encodings = QStringList() << url.toString()
+                                        << url.toString(QUrl::FullyEncoded)
+                                        << QString::fromUtf8(url.toEncoded(QUrl::FullyDecoded))
+                                        << QString::fromUtf8(url.toEncoded(QUrl::FullyEncoded));
+  encodings.removeDuplicates();
 
-  // Look for albums that have songs by more than one 'effective album artist' in the same directory
+  return encodings;
+
+}
+
+QString CollectionBackend::CompilationDirectory(const QUrl &url) {
+
+  return url.toString(QUrl::PreferLocalFile | QUrl::RemoveFilename);
+
+}
+
+void CollectionBackend::AddCompilationGroup(const QSqlDatabase &db, const Song &song) {
 
+  // Songs without an album are never part of a compilation
+  if (song.album().isEmpty()) return;
+
+  const QString directory = CompilationDirectory(song.url());
+  QSet<QString> &directories = compilation_groups_[song.album()];
+  if (directories.contains(directory)) return;
+  directories.insert(directory);
+
+  // Written in the same transaction as the song, so the update isn't lost if the scan is interrupted.
   SqlQuery q(db);
-  q.prepare(QStringLiteral("SELECT effective_albumartist, album, url, compilation_detected FROM %1 WHERE unavailable = 0 ORDER BY album").arg(songs_table_));
+  q.prepare(u"INSERT OR IGNORE INTO compilation_groups (songs_table, album, directory) VALUES (:songs_table, :album, :directory)"_s);
+  q.BindValue(u":songs_table"_s, songs_table_);
+  q.BindValue(u":album"_s, song.album());
+  q.BindValue(u":directory"_s, directory);
   if (!q.Exec()) {
     db_->ReportErrors(q);
-    return;
   }
 
-  QMap<QString, CompilationInfo> compilation_info;
-  while (q.next()) {
-    QString artist = q.value(0).toString();
-    QString album = q.value(1).toString();
-    QUrl url = QUrl::fromEncoded(q.value(2).toString().toUtf8());
-    bool compilation_detected = q.value(3).toBool();
+}
+
+void CollectionBackend::CompilationsNeedUpdatingAsync() {
+  QMetaObject::invokeMethod(this, &CollectionBackend::CompilationsNeedUpdating, Qt::QueuedConnection);
+}
+
+void CollectionBackend::CompilationsNeedUpdating() {
 
-    // Ignore songs that don't have an album field set
-    if (album.isEmpty()) continue;
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
 
-    // Find the directory the song is in
-    QString directory = url.toString(QUrl::PreferLocalFile | QUrl::RemoveFilename);
+  QSqlDatabase db(db_->Connect());
 
-    CompilationInfo &info = compilation_info[directory + album];
-    info.urls << url;
-    if (!info.artists.contains(artist)) {
-      info.artists << artist;
+  // Only the albums in the directories that were touched since the last update need to be looked at again.
+  // Groups left over from a scan that was interrupted before the update are read back from the database.
+  QMap<QString, QSet<QString>> compilation_groups = compilation_groups_;
+  compilation_groups_.clear();
+  {
+    SqlQuery q(db);
+    q.prepare(u"SELECT album, directory FROM compilation_groups WHERE songs_table = :songs_table"_s);
+    q.BindValue(u":songs_table"_s, songs_table_);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+    while (q.next()) {
+      compilation_groups[q.value(0).toString()].insert(q.value(1).toString());
+    }
+  }
+  if (compilation_groups.isEmpty()) return;
+
+  // Look for albums that have songs by more than one 'effective album artist' in the same directory
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("SELECT effective_albumartist, url, compilation_detected FROM %1 WHERE album = :album AND unavailable = 0").arg(songs_table_));
+
+  QMap<QString, CompilationInfo> compilation_info;
+  for (QMap<QString, QSet<QString>>::const_iterator group_it = compilation_groups.constBegin(); group_it != compilation_groups.constEnd(); ++group_it) {
+    const QString &album = group_it.key();
+    const QSet<QString> &directories = group_it.value();
+
+    q.BindValue(u":album"_s, album);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+
+    while (q.next()) {
+      QString artist = q.value(0).toString();
+      QUrl url = QUrl::fromEncoded(q.value(1).toString().toUtf8());
+      bool compilation_detected = q.value(2).toBool();
+
+      // Find the directory the song is in, other directories with the same album name were not changed
+      QString directory = CompilationDirectory(url);
+      if (!directories.contains(directory)) continue;
+
+      CompilationInfo &info = compilation_info[directory + album];
+      info.urls << url;
+      if (!info.artists.contains(artist)) {
+        info.artists << artist;
+      }
+      if (compilation_detected) info.has_compilation_detected++;
+      else info.has_not_compilation_detected++;
     }
-    if (compilation_detected) info.has_compilation_detected++;
-    else info.has_not_compilation_detected++;
   }
 
   // Now mark the songs that we think are in compilations
@@ -1435,6 +1671,16 @@ void CollectionBackend::CompilationsNeedUpdating() {
     }
   }
 
+  {
+    SqlQuery q(db);
+    q.prepare(u"DELETE FROM compilation_groups WHERE songs_table = :songs_table"_s);
+    q.BindValue(u":songs_table"_s, songs_table_);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
   transaction.Commit();
 
   if (!changed_songs.isEmpty()) {
@@ -1485,8 +1731,7 @@ bool CollectionBackend::UpdateCompilations(const QSqlDatabase &db, SongList &cha
 
 CollectionBackend::AlbumList CollectionBackend::GetAlbums(const QString &artist, const bool compilation_required, const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   CollectionQuery query(db, songs_table_, opt);
   query.SetColumnSpec(u"url, filetype, cue_path, effective_albumartist, album, compilation_effective, art_embedded, art_automatic, art_manual, art_unset"_s);
@@ -1573,8 +1818,7 @@ CollectionBackend::AlbumList CollectionBackend::GetAlbums(const QString &artist,
 
 CollectionBackend::Album CollectionBackend::GetAlbumArt(const QString &effective_albumartist, const QString &album) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   Album ret;
   ret.album = album;
@@ -1612,7 +1856,7 @@ void CollectionBackend::UpdateEmbeddedAlbumArtAsync(const QString &effective_alb
 
 void CollectionBackend::UpdateEmbeddedAlbumArt(const QString &effective_albumartist, const QString &album, const bool art_embedded) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1658,7 +1902,7 @@ void CollectionBackend::UpdateManualAlbumArtAsync(const QString &effective_album
 
 void CollectionBackend::UpdateManualAlbumArt(const QString &effective_albumartist, const QString &album, const QUrl &art_manual) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1673,6 +1917,9 @@ void CollectionBackend::UpdateManualAlbumArt(const QString &effective_albumartis
     }
   }
 
+  // The cover may have been written or deleted in the cache outside the index.
+  CoverCacheIndex::Clear();
+
   SongList songs;
   {
     CollectionQuery q(db, songs_table_);
@@ -1704,7 +1951,7 @@ void CollectionBackend::UnsetAlbumArtAsync(const QString &effective_albumartist,
 
 void CollectionBackend::UnsetAlbumArt(const QString &effective_albumartist, const QString &album) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1718,6 +1965,9 @@ void CollectionBackend::UnsetAlbumArt(const QString &effective_albumartist, cons
     }
   }
 
+  // The cover may have been written or deleted in the cache outside the index.
+  CoverCacheIndex::Clear();
+
   SongList songs;
   {
     CollectionQuery q(db, songs_table_);
@@ -1749,7 +1999,7 @@ void CollectionBackend::ClearAlbumArtAsync(const QString &effective_albumartist,
 
 void CollectionBackend::ClearAlbumArt(const QString &effective_albumartist, const QString &album, const bool art_unset) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1764,6 +2014,9 @@ void CollectionBackend::ClearAlbumArt(const QString &effective_albumartist, cons
     }
   }
 
+  // The cover may have been written or deleted in the cache outside the index.
+  CoverCacheIndex::Clear();
+
   SongList songs;
   {
     CollectionQuery q(db, songs_table_);
@@ -1789,7 +2042,7 @@ void CollectionBackend::ClearAlbumArt(const QString &effective_albumartist, cons
 
 void CollectionBackend::ForceCompilation(const QString &album, const QStringList &artists, const bool on) {
 
-  QMutexLocker l(db_->Mutex());
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
   SongList songs;
 
@@ -1840,20 +2093,11 @@ void CollectionBackend::IncrementPlayCount(const int id) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET playcount = playcount + 1, lastplayed = :now WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(u":now"_s, QDateTime::currentSecsSinceEpoch());
-  q.BindValue(u":id"_s, id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
-  }
+  PendingStatistics &statistics = pending_statistics_[id];
+  ++statistics.playcount_increment;
+  statistics.lastplayed = qMax(statistics.lastplayed, QDateTime::currentSecsSinceEpoch());
 
-  Song new_song = GetSongById(id, db);
-  Q_EMIT SongsStatisticsChanged(SongList() << new_song);
+  ScheduleFlushStatistics();
 
 }
 
@@ -1863,19 +2107,9 @@ void CollectionBackend::IncrementSkipCount(const int id, const float progress) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET skipcount = skipcount + 1 WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(u":id"_s, id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
-  }
+  ++pending_statistics_[id].skipcount_increment;
 
-  Song new_song = GetSongById(id, db);
-  Q_EMIT SongsStatisticsChanged(SongList() << new_song);
+  ScheduleFlushStatistics();
 
 }
 
@@ -1909,7 +2143,10 @@ bool CollectionBackend::ResetPlayStatistics(const QStringList &id_str_list) {
 
   if (id_str_list.isEmpty()) return false;
 
-  QMutexLocker l(db_->Mutex());
+  // Write the queued changes first so they are not applied on top of the reset.
+  FlushStatistics();
+
+  tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1933,7 +2170,7 @@ void CollectionBackend::DeleteAllAsync() {
 void CollectionBackend::DeleteAll() {
 
   {
-    QMutexLocker l(db_->Mutex());
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
     QSqlDatabase db(db_->Connect());
     ScopedTransaction t(&db);
 
@@ -1946,17 +2183,29 @@ void CollectionBackend::DeleteAll() {
       }
     }
 
+    {
+      SqlQuery q(db);
+      q.prepare(u"DELETE FROM compilation_groups WHERE songs_table = :songs_table"_s);
+      q.BindValue(u":songs_table"_s, songs_table_);
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+    }
+
     t.Commit();
+    compilation_groups_.clear();
   }
 
+  CoverCacheIndex::Clear();
+
   Q_EMIT DatabaseReset();
 
 }
 
 SongList CollectionBackend::ExecuteQuery(const QString &sql) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SqlQuery query(db);
   query.prepare(sql);
@@ -1978,8 +2227,7 @@ SongList CollectionBackend::ExecuteQuery(const QString &sql) {
 
 SongList CollectionBackend::GetSongsBy(const QString &artist, const QString &album, const QString &title) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  QSqlDatabase db(db_->ConnectReadOnly());
 
   SongList songs;
   SqlQuery q(db);
@@ -2006,58 +2254,96 @@ SongList CollectionBackend::GetSongsBy(const QString &artist, const QString &alb
 
 }
 
-void CollectionBackend::UpdateLastPlayed(const QString &artist, const QString &album, const QString &title, const qint64 lastplayed) {
+void CollectionBackend::ImportPlayStatistics(const ImportedPlayStatisticsList &statistics) {
 
-  const SongList songs = GetSongsBy(artist, album, title);
-  if (songs.isEmpty()) {
-    qLog(Debug) << "Could not find a matching song in the database for" << artist << album << title;
-    return;
-  }
+  if (statistics.isEmpty()) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  TRACE_SCOPE("database", "Import play statistics");
 
-  for (const Song &song : songs) {
-    if (song.lastplayed() >= lastplayed) {
-      continue;
+  SongList songs;
+  {
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
+    QSqlDatabase db(db_->Connect());
+    ScopedTransaction t(&db);
+
+    // The imported statistics are matched against the songs with an indexed temporary table, instead of looking up every track.
+    const QStringList create_queries = QStringList()
+      << u"CREATE TEMP TABLE IF NOT EXISTS imported_statistics (artist TEXT NOT NULL COLLATE NOCASE, album TEXT NOT NULL COLLATE NOCASE, title TEXT NOT NULL COLLATE NOCASE, playcount INTEGER NOT NULL, lastplayed INTEGER NOT NULL)"_s
+      << u"CREATE INDEX IF NOT EXISTS temp.idx_imported_statistics_artist_title ON imported_statistics (artist, title)"_s
+      << u"CREATE TEMP TABLE IF NOT EXISTS imported_matches (song_id INTEGER PRIMARY KEY, playcount INTEGER NOT NULL, lastplayed INTEGER NOT NULL)"_s
+      << u"DELETE FROM imported_statistics"_s
+      << u"DELETE FROM imported_matches"_s;
+    for (const QString &create_query : create_queries) {
+      SqlQuery q(db);
+      q.prepare(create_query);
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
     }
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(u":lastplayed"_s, lastplayed);
-    q.BindValue(u":id"_s, song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      continue;
+
+    SqlQuery insert_query(db);
+    insert_query.prepare(u"INSERT INTO imported_statistics (artist, album, title, playcount, lastplayed) VALUES (:artist, :album, :title, :playcount, :lastplayed)"_s);
+    for (const ImportedPlayStatistics &imported_statistics : statistics) {
+      insert_query.BindValue(u":artist"_s, imported_statistics.artist);
+      insert_query.BindValue(u":album"_s, imported_statistics.album);
+      insert_query.BindValue(u":title"_s, imported_statistics.title);
+      insert_query.BindValue(u":playcount"_s, imported_statistics.playcount);
+      insert_query.BindValue(u":lastplayed"_s, imported_statistics.lastplayed);
+      if (!insert_query.Exec()) {
+        db_->ReportErrors(insert_query);
+        return;
+      }
     }
-  }
 
-  Q_EMIT SongsStatisticsChanged(SongList() << songs);
+    const QStringList update_queries = QStringList()
+      << QStringLiteral("INSERT INTO imported_matches (song_id, playcount, lastplayed) "
+                        "SELECT songs.ROWID, MAX(imported_statistics.playcount), MAX(imported_statistics.lastplayed) FROM %1 AS songs "
+                        "JOIN imported_statistics ON imported_statistics.artist = songs.artist AND imported_statistics.title = songs.title AND (imported_statistics.album = '' OR imported_statistics.album = songs.album) "
+                        "GROUP BY songs.ROWID").arg(songs_table_)
+      << QStringLiteral("DELETE FROM imported_matches WHERE playcount <= 0 AND lastplayed <= (SELECT lastplayed FROM %1 WHERE ROWID = imported_matches.song_id)").arg(songs_table_)
+      << QStringLiteral("UPDATE %1 SET playcount = (SELECT playcount FROM imported_matches WHERE song_id = %1.ROWID) "
+                        "WHERE ROWID IN (SELECT song_id FROM imported_matches WHERE playcount > 0)").arg(songs_table_)
+      << QStringLiteral("UPDATE %1 SET lastplayed = MAX(lastplayed, (SELECT lastplayed FROM imported_matches WHERE song_id = %1.ROWID)) "
+                        "WHERE ROWID IN (SELECT song_id FROM imported_matches WHERE lastplayed > 0)").arg(songs_table_);
+    for (const QString &update_query : update_queries) {
+      SqlQuery q(db);
+      q.prepare(update_query);
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+    }
 
-}
+    {
+      SqlQuery q(db);
+      q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE ROWID IN (SELECT song_id FROM imported_matches)").arg(Song::kRowIdColumnSpec, songs_table_));
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+      while (q.next()) {
+        Song song(source_);
+        song.InitFromQuery(q, true);
+        songs << song;
+      }
+    }
 
-void CollectionBackend::UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags) {
+    for (const QString &drop_query : QStringList() << u"DROP TABLE imported_statistics"_s << u"DROP TABLE imported_matches"_s) {
+      SqlQuery q(db);
+      q.prepare(drop_query);
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+    }
 
-  const SongList songs = GetSongsBy(artist, QString(), title);
-  if (songs.isEmpty()) {
-    qLog(Debug) << "Could not find a matching song in the database for" << artist << title;
-    return;
+    t.Commit();
   }
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
-  for (const Song &song : songs) {
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(u":playcount"_s, playcount);
-    q.BindValue(u":id"_s, song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      return;
-    }
-  }
+  qLog(Debug) << "Imported play statistics for" << songs.count() << "songs from" << statistics.count() << "tracks";
 
-  Q_EMIT SongsStatisticsChanged(SongList() << songs, save_tags);
+  if (!songs.isEmpty()) Q_EMIT SongsStatisticsChanged(songs, false);
 
 }
 
@@ -2073,26 +2359,110 @@ void CollectionBackend::UpdateSongsRating(const QList<int> &id_list, const float
 
   if (id_list.isEmpty()) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  for (const int id : id_list) {
+    PendingStatistics &statistics = pending_statistics_[id];
+    statistics.rating = rating;
+    statistics.save_rating_tags = statistics.save_rating_tags || save_tags;
+  }
 
-  QStringList id_str_list;
-  id_str_list.reserve(id_list.count());
-  for (int i : id_list) {
-    id_str_list << QString::number(i);
+  ScheduleFlushStatistics();
+
+}
+
+void CollectionBackend::ScheduleFlushStatistics() {
+
+  if (pending_statistics_.count() >= kMaxPendingStatistics) {
+    FlushStatistics();
   }
-  QString ids = id_str_list.join(u',');
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET rating = :rating WHERE ROWID IN (%2)").arg(songs_table_, ids));
-  q.BindValue(u":rating"_s, rating);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
+  else if (!pending_statistics_.isEmpty() && !timer_flush_statistics_->isActive()) {
+    timer_flush_statistics_->start();
+  }
+
+}
+
+void CollectionBackend::FlushStatistics() {
+
+  timer_flush_statistics_->stop();
+
+  if (pending_statistics_.isEmpty()) return;
+
+  TRACE_SCOPE("database", "Flush statistics");
+
+  // The queue is only cleared when the transaction is committed, so if writing fails the updates are kept for the next flush.
+  const QMap<int, PendingStatistics> pending_statistics = pending_statistics_;
+
+  SongList songs;
+  {
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
+    QSqlDatabase db(db_->Connect());
+    ScopedTransaction t(&db);
+
+    QStringList id_str_list;
+    id_str_list.reserve(pending_statistics.count());
+    for (QMap<int, PendingStatistics>::const_iterator it = pending_statistics.constBegin(); it != pending_statistics.constEnd(); ++it) {
+      const PendingStatistics &statistics = it.value();
+      QStringList columns;
+      if (statistics.playcount_increment > 0) {
+        columns << u"playcount = playcount + :playcount_increment"_s;
+      }
+      if (statistics.skipcount_increment > 0) {
+        columns << u"skipcount = skipcount + :skipcount_increment"_s;
+      }
+      if (statistics.lastplayed > 0) {
+        columns << u"lastplayed = :lastplayed"_s;
+      }
+      if (statistics.rating.has_value()) {
+        columns << u"rating = :rating"_s;
+      }
+      if (columns.isEmpty()) continue;
+
+      SqlQuery q(db);
+      q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, columns.join(", "_L1)));
+      if (statistics.playcount_increment > 0) {
+        q.BindValue(u":playcount_increment"_s, statistics.playcount_increment);
+      }
+      if (statistics.skipcount_increment > 0) {
+        q.BindValue(u":skipcount_increment"_s, statistics.skipcount_increment);
+      }
+      if (statistics.lastplayed > 0) {
+        q.BindValue(u":lastplayed"_s, statistics.lastplayed);
+      }
+      if (statistics.rating.has_value()) {
+        q.BindValue(u":rating"_s, statistics.rating.value());
+      }
+      q.BindValue(u":id"_s, it.key());
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+      id_str_list << QString::number(it.key());
+    }
+
+    t.Commit();
+    pending_statistics_.clear();
+
+    if (!id_str_list.isEmpty()) {
+      songs = GetSongsById(id_str_list, db);
+    }
   }
 
-  SongList new_song_list = GetSongsById(id_str_list, db);
+  // One signal per kind of change, so the tag writes for the whole batch are queued together.
+  SongList statistics_songs;
+  SongList rating_songs;
+  SongList rating_songs_save_tags;
+  for (const Song &song : std::as_const(songs)) {
+    const PendingStatistics statistics = pending_statistics.value(song.id());
+    if (statistics.playcount_increment > 0 || statistics.skipcount_increment > 0 || statistics.lastplayed > 0) {
+      statistics_songs << song;
+    }
+    if (statistics.rating.has_value()) {
+      (statistics.save_rating_tags ? rating_songs_save_tags : rating_songs) << song;
+    }
+  }
 
-  Q_EMIT SongsRatingChanged(new_song_list, save_tags);
+  if (!statistics_songs.isEmpty()) Q_EMIT SongsStatisticsChanged(statistics_songs, false);
+  if (!rating_songs.isEmpty()) Q_EMIT SongsRatingChanged(rating_songs, false);
+  if (!rating_songs_save_tags.isEmpty()) Q_EMIT SongsRatingChanged(rating_songs_save_tags, true);
 
 }
 
@@ -2107,7 +2477,7 @@ void CollectionBackend::UpdateSongsRatingAsync(const QList<int> &ids, const floa
 void CollectionBackend::UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days) {
 
   {
-    QMutexLocker l(db_->Mutex());
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
     QSqlDatabase db(db_->Connect());
 
     SqlQuery q(db);
@@ -2128,7 +2498,7 @@ void CollectionBackend::ExpireSongs(const int directory_id, const int expire_una
 
   SongList songs;
   {
-    QMutexLocker l(db_->Mutex());
+    tracing::MutexLocker l(db_->Mutex(), "database", "Lock wait");
     QSqlDatabase db(db_->Connect());
     SqlQuery q(db);
     q.prepare(QStringLiteral("SELECT %1 FROM %2 LEFT JOIN playlist_items ON %2.ROWID = playlist_items.collection_id WHERE %2.directory_id = :directory_id AND %2.unavailable = 1 AND %2.lastseen > 0 AND %2.lastseen < :time AND playlist_items.collection_id IS NULL").arg(Song::JoinSpec(songs_table_), songs_table_));
@@ -31,6 +31,8 @@
 #include <QObject>
 #include <QFileInfo>
 #include <QList>
+#include <QMap>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -38,11 +40,14 @@
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "engine/ebur128measures.h"
 #include "collectionfilteroptions.h"
 #include "collectionquery.h"
 #include "collectiondirectory.h"
+#include "importedplaystatistics.h"
 
 class QThread;
+class QTimer;
 class TaskManager;
 class Database;
 
@@ -131,6 +136,11 @@ class CollectionBackendInterface : public QObject {
   // Using default beginning value is suitable when searching for single-section songs.
   virtual Song GetSongByUrl(const QUrl &url, const qint64 beginning = 0) = 0;
   virtual Song GetSongByUrlAndTrack(const QUrl &url, const int track) = 0;
+  // Returns all available sections of all songs with any of the given filenames.
+  virtual SongList GetSongsByUrls(const QList<QUrl> &urls) = 0;
+
+  // The encodings of the URL that the stored URLs are matched against by GetSongByUrl() and GetSongsByUrls().
+  static QStringList UrlEncodings(const QUrl &url);
 
   virtual void AddDirectoryAsync(const QString &path) = 0;
   virtual void RemoveDirectoryAsync(const CollectionDirectory &dir) = 0;
@@ -207,6 +217,7 @@ class CollectionBackend : public CollectionBackendInterface {
   SongList GetSongsByUrl(const QUrl &url, const bool unavailable = false) override;
   Song GetSongByUrl(const QUrl &url, qint64 beginning = 0) override;
   Song GetSongByUrlAndTrack(const QUrl &url, const int track) override;
+  SongList GetSongsByUrls(const QList<QUrl> &urls) override;
 
   void AddDirectoryAsync(const QString &path) override;
   void RemoveDirectoryAsync(const CollectionDirectory &dir) override;
@@ -221,11 +232,22 @@ class CollectionBackend : public CollectionBackendInterface {
 
   void DeleteAllAsync();
 
+  void CompilationsNeedUpdatingAsync();
+
   Song GetSongBySongId(const QString &song_id);
   SongList GetSongsBySongId(const QStringList &song_ids);
 
   SongList GetSongsByFingerprint(const QString &fingerprint) override;
 
+  // Returns available songs where every token is found in one of the columns.
+  SongList SearchSongs(const QStringList &tokens, const QStringList &columns, const int limit);
+
+  // Fingerprint and loudness characteristics cached by the content key of the audio, see AudioContentKey.
+  // Pass nullptr for the results that aren't needed. Returns true if all the requested results are cached, the ones found are set either way.
+  // Adding only overwrites the results that are set.
+  bool GetAudioAnalysis(const QString &content_key, QString *fingerprint, std::optional<EBUR128Measures> *ebur128_measures);
+  void AddAudioAnalysis(const QString &content_key, const QString &fingerprint, const std::optional<EBUR128Measures> &ebur128_measures);
+
   SongList ExecuteQuery(const QString &sql);
 
   void AddOrUpdateSongsAsync(const SongList &songs);
@@ -268,12 +290,15 @@ class CollectionBackend : public CollectionBackendInterface {
   void SongPathChanged(const Song &song, const QFileInfo &new_file, const std::optional<int> new_collection_directory_id);
 
   SongList GetSongsBy(const QString &artist, const QString &album, const QString &title);
-  void UpdateLastPlayed(const QString &artist, const QString &album, const QString &title, const qint64 lastplayed);
-  void UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags = false);
+  // Applies imported play counts and last played times to all matching songs in one transaction.
+  void ImportPlayStatistics(const ImportedPlayStatisticsList &statistics);
 
   void UpdateSongRating(const int id, const float rating, const bool save_tags = false);
   void UpdateSongsRating(const QList<int> &id_list, const float rating, const bool save_tags = false);
 
+  // Play statistics and ratings are queued and written in one transaction after a short delay.
+  void FlushStatistics();
+
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExpireSongs(const int directory_id, const int expire_unavailable_songs_days);
 
@@ -309,10 +334,24 @@ class CollectionBackend : public CollectionBackendInterface {
     int has_not_compilation_detected;
   };
 
+  // Queued play statistics and rating changes for one song, later changes are merged into it.
+  struct PendingStatistics {
+    PendingStatistics() : playcount_increment(0), skipcount_increment(0), lastplayed(-1), save_rating_tags(false) {}
+
+    int playcount_increment;
+    int skipcount_increment;
+    qint64 lastplayed;
+    std::optional<float> rating;
+    bool save_rating_tags;
+  };
+
+  static QString CompilationDirectory(const QUrl &url);
+  void AddCompilationGroup(const QSqlDatabase &db, const Song &song);
   bool UpdateCompilations(const QSqlDatabase &db, SongList &changed_songs, const QUrl &url, const bool compilation_detected);
   AlbumList GetAlbums(const QString &artist, const QString &album_artist, const bool compilation_required = false, const CollectionFilterOptions &opt = CollectionFilterOptions());
   AlbumList GetAlbums(const QString &artist, const bool compilation_required, const CollectionFilterOptions &opt = CollectionFilterOptions());
   CollectionSubdirectoryList SubdirsInDirectory(const int id, QSqlDatabase &db);
+  void ScheduleFlushStatistics();
 
   Song GetSongById(const int id, QSqlDatabase &db);
   SongList GetSongsById(const QStringList &ids, QSqlDatabase &db);
@@ -328,6 +367,14 @@ class CollectionBackend : public CollectionBackendInterface {
   QString dirs_table_;
   QString subdirs_table_;
   QThread *original_thread_;
+
+  // Album -> directories with songs added, changed or removed since compilations were last updated, protected by the database mutex.
+  // They are also kept in the compilation_groups table until the update is committed.
+  QMap<QString, QSet<QString>> compilation_groups_;
+
+  // Song ID -> changes not written yet, only used from the backend thread.
+  QTimer *timer_flush_statistics_;
+  QMap<int, PendingStatistics> pending_statistics_;
 };
 
 #endif  // COLLECTIONBACKEND_H
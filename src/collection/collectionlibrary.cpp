@@ -28,6 +28,7 @@
 #include <QThread>
 #include <QList>
 #include <QSettings>
+#include <QTimer>
 #include <QtConcurrentRun>
 
 #include "core/taskmanager.h"
@@ -37,6 +38,7 @@
 #include "core/logging.h"
 #include "core/settings.h"
 #include "tagreader/tagreaderclient.h"
+#include "tagreader/tagreaderreply.h"
 #include "utilities/threadutils.h"
 #include "collectionlibrary.h"
 #include "collectionwatcher.h"
@@ -64,12 +66,17 @@ CollectionLibrary::CollectionLibrary(const SharedPtr<Database> database,
       watcher_thread_(nullptr),
       original_thread_(nullptr),
       save_playcounts_to_files_(false),
-      save_ratings_to_files_(false) {
+      save_ratings_to_files_(false),
+      timer_save_statistics_(new QTimer(this)) {
 
   setObjectName(QLatin1String(QObject::metaObject()->className()));
 
   original_thread_ = thread();
 
+  timer_save_statistics_->setSingleShot(true);
+  timer_save_statistics_->setInterval(0);
+  QObject::connect(timer_save_statistics_, &QTimer::timeout, this, &CollectionLibrary::SaveStatisticsToFiles);
+
   backend_ = make_shared<CollectionBackend>();
   backend()->moveToThread(database->thread());
   qLog(Debug) << &*backend_ << "moved to thread" << database->thread();
@@ -126,10 +133,14 @@ void CollectionLibrary::Init() {
   QObject::connect(watcher_, &CollectionWatcher::SubdirsMTimeUpdated, &*backend_, &CollectionBackend::AddOrUpdateSubdirs);
   QObject::connect(watcher_, &CollectionWatcher::CompilationsNeedUpdating, &*backend_, &CollectionBackend::CompilationsNeedUpdating);
   QObject::connect(watcher_, &CollectionWatcher::UpdateLastSeen, &*backend_, &CollectionBackend::UpdateLastSeen);
+  QObject::connect(watcher_, &CollectionWatcher::MoodbarsGenerated, this, &CollectionLibrary::MoodbarsGenerated);
 
   // This will start the watcher checking for updates
   backend_->LoadDirectoriesAsync();
 
+  // Finish the compilation updates of a scan that was interrupted.
+  backend_->CompilationsNeedUpdatingAsync();
+
 }
 
 void CollectionLibrary::Exit() {
@@ -212,18 +223,46 @@ void CollectionLibrary::SyncPlaycountAndRatingToFiles() {
 
 }
 
-void CollectionLibrary::SongsPlaycountChanged(const SongList &songs, const bool save_tags) const {
+void CollectionLibrary::SongsPlaycountChanged(const SongList &songs, const bool save_tags) {
+
+  if (!save_tags && !save_playcounts_to_files_) return;
+
+  for (const Song &song : songs) {
+    QPair<Song, SaveTagsOptions> &pending = pending_statistics_files_[song.url().toLocalFile()];
+    pending.first = song;
+    pending.second |= SaveTagsOption::Playcount;
+  }
+  timer_save_statistics_->start();
+
+}
+
+void CollectionLibrary::SongsRatingChanged(const SongList &songs, const bool save_tags) {
 
-  if (save_tags || save_playcounts_to_files_) {
-    tagreader_client_->SaveSongsPlaycountAsync(songs);
+  if (!save_tags && !save_ratings_to_files_) return;
+
+  for (const Song &song : songs) {
+    QPair<Song, SaveTagsOptions> &pending = pending_statistics_files_[song.url().toLocalFile()];
+    pending.first = song;
+    if (song.rating() >= 0) {
+      pending.second |= SaveTagsOption::Rating;
+    }
   }
+  timer_save_statistics_->start();
 
 }
 
-void CollectionLibrary::SongsRatingChanged(const SongList &songs, const bool save_tags) const {
+void CollectionLibrary::SaveStatisticsToFiles() {
+
+  const QMap<QString, QPair<Song, SaveTagsOptions>> pending_statistics_files = pending_statistics_files_;
+  pending_statistics_files_.clear();
 
-  if (save_tags || save_ratings_to_files_) {
-    tagreader_client_->SaveSongsRatingAsync(songs);
+  for (QMap<QString, QPair<Song, SaveTagsOptions>>::const_iterator it = pending_statistics_files.constBegin(); it != pending_statistics_files.constEnd(); ++it) {
+    if (it.key().isEmpty() || !it.value().second) continue;
+    SharedPtr<QMetaObject::Connection> connection = make_shared<QMetaObject::Connection>();
+    TagReaderReplyPtr reply = tagreader_client_->WriteFileAsync(it.key(), it.value().first, it.value().second);
+    *connection = QObject::connect(&*reply, &TagReaderReply::Finished, this, [reply, connection]() {
+      QObject::disconnect(*connection);
+    }, Qt::QueuedConnection);
   }
 
 }
@@ -27,12 +27,18 @@
 #include <QObject>
 #include <QList>
 #include <QHash>
+#include <QMap>
+#include <QPair>
 #include <QString>
+#include <QUrl>
+#include <QByteArray>
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "tagreader/savetagsoptions.h"
 
 class QThread;
+class QTimer;
 class Thread;
 class Database;
 class TaskManager;
@@ -86,12 +92,14 @@ class CollectionLibrary : public QObject {
 
  private Q_SLOTS:
   void ExitReceived();
-  void SongsPlaycountChanged(const SongList &songs, const bool save_tags = false) const;
-  void SongsRatingChanged(const SongList &songs, const bool save_tags = false) const;
+  void SongsPlaycountChanged(const SongList &songs, const bool save_tags = false);
+  void SongsRatingChanged(const SongList &songs, const bool save_tags = false);
+  void SaveStatisticsToFiles();
 
  Q_SIGNALS:
   void Error(const QString &error);
   void ExitFinished();
+  void MoodbarsGenerated(const QMap<QUrl, QByteArray> &moodbars);
 
  private:
   const SharedPtr<TaskManager> task_manager_;
@@ -111,6 +119,10 @@ class CollectionLibrary : public QObject {
 
   bool save_playcounts_to_files_;
   bool save_ratings_to_files_;
+
+  // Filename -> song and the statistics to save, so a file that had both its playcount and rating changed is only written once.
+  QTimer *timer_save_statistics_;
+  QMap<QString, QPair<Song, SaveTagsOptions>> pending_statistics_files_;
 };
 
 #endif
@@ -72,6 +72,7 @@
 #include "covermanager/albumcoverloaderoptions.h"
 #include "covermanager/albumcoverloaderresult.h"
 #include "covermanager/albumcoverloader.h"
+#include "covermanager/covercacheindex.h"
 
 using namespace std::chrono_literals;
 using namespace Qt::Literals::StringLiterals;
@@ -800,11 +801,11 @@ SongList CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter
   SongList songs;
 
   {
-    QMutexLocker l(backend_->db()->Mutex());
-    QSqlDatabase db(backend_->db()->Connect());
+    QSqlDatabase db(backend_->db()->ConnectReadOnly());
     CollectionQuery q(db, backend_->songs_table(), filter_options);
     q.SetColumnSpec(u"%songs_table.ROWID, "_s + Song::kColumnSpec);
     if (q.Exec()) {
+      CoverCacheIndex::Batch cover_cache_batch;
       while (q.Next()) {
         Song song;
         song.InitFromQuery(q, true);
@@ -23,6 +23,7 @@
 
 #include <utility>
 #include <chrono>
+#include <optional>
 
 #include <QObject>
 #include <QThread>
@@ -34,6 +35,7 @@
 #include <QFileInfo>
 #include <QMetaObject>
 #include <QDateTime>
+#include <QByteArray>
 #include <QHash>
 #include <QMap>
 #include <QList>
@@ -49,6 +51,7 @@
 #include "core/filesystemwatcherinterface.h"
 #include "core/logging.h"
 #include "core/taskmanager.h"
+#include "core/tracing.h"
 #include "core/settings.h"
 #include "utilities/imageutils.h"
 #include "constants/timeconstants.h"
@@ -60,12 +63,14 @@
 #include "playlistparsers/cueparser.h"
 #include "constants/collectionsettings.h"
 #include "engine/ebur128measures.h"
-#ifdef HAVE_SONGFINGERPRINTING
-#  include "engine/chromaprinter.h"
-#endif
+#include "engine/audioanalysis.h"
+#include "engine/audiocontentkey.h"
 #ifdef HAVE_EBUR128
 #  include "engine/ebur128analysis.h"
 #endif
+#ifdef HAVE_MOODBAR
+#  include "constants/moodbarsettings.h"
+#endif
 
 // This is defined by one of the windows headers that is included by taglib.
 #ifdef RemoveDirectory
@@ -93,6 +98,7 @@ CollectionWatcher::CollectionWatcher(const Song::Source source,
       monitor_(true),
       song_tracking_(false),
       song_ebur128_loudness_analysis_(false),
+      moodbar_(false),
       mark_songs_unavailable_(source_ == Song::Source::Collection),
       expire_unavailable_songs_days_(60),
       overwrite_playcount_(false),
@@ -228,6 +234,17 @@ void CollectionWatcher::ReloadSettings() {
   overwrite_rating_ = s.value(CollectionSettings::kOverwriteRating, false).toBool();
   s.endGroup();
 
+#ifdef HAVE_MOODBAR
+  if (source_ == Song::Source::Collection) {
+    s.beginGroup(MoodbarSettings::kSettingsGroup);
+    moodbar_ = s.value(MoodbarSettings::kEnabled, false).toBool();
+    s.endGroup();
+  }
+  else {
+    moodbar_ = false;
+  }
+#endif
+
   best_art_filters_.clear();
   for (const QString &filter : filters) {
     QString str = filter.trimmed();
@@ -313,6 +330,8 @@ void CollectionWatcher::ScanTransaction::AddToProgressMax(const quint64 n) {
 
 void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
 
+  TRACE_SCOPE("scanner", "Commit songs");
+
   if (!deleted_songs.isEmpty()) {
     if (mark_songs_unavailable_ && watcher_->source() == Song::Source::Collection) {
       Q_EMIT watcher_->SongsUnavailable(deleted_songs);
@@ -328,6 +347,11 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
     new_songs.clear();
   }
 
+  if (!moodbars.isEmpty()) {
+    Q_EMIT watcher_->MoodbarsGenerated(moodbars);
+    moodbars.clear();
+  }
+
   if (!touched_songs.isEmpty()) {
     Q_EMIT watcher_->SongsMTimeUpdated(touched_songs);
     touched_songs.clear();
@@ -526,6 +550,8 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
 
 void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, ScanTransaction *t, const bool force_noincremental) {
 
+  TRACE_SCOPE("scanner", "Scan subdirectory");
+
   const QFileInfo path_info(path);
 
   if (path_info.isSymLink()) {
@@ -709,19 +735,12 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
       // The song's changed or missing fingerprint - create fingerprint and reread the metadata from file.
       if (t->ignores_mtime() || changed || missing_fingerprint || missing_loudness_characteristics) {
 
-        QString fingerprint;
-#ifdef HAVE_SONGFINGERPRINTING
-        if (song_tracking_) {
-          Chromaprinter chromaprinter(file);
-          fingerprint = chromaprinter.CreateFingerprint();
-          if (fingerprint.isEmpty()) {
-            fingerprint = "NONE"_L1;
-          }
-        }
-#endif
+        const bool cue_associated = !new_cue.isEmpty() && new_cue_mtime != 0;
+        std::optional<EBUR128Measures> ebur128_measures;
+        const QString fingerprint = AnalyzeFile(file, cue_associated, &ebur128_measures, t);
 
-        if (new_cue.isEmpty() || new_cue_mtime == 0) {  // If no CUE or it's about to lose it.
-          UpdateNonCueAssociatedSong(file, fingerprint, matching_songs, art_automatic, cue_deleted, t);
+        if (!cue_associated) {  // If no CUE or it's about to lose it.
+          UpdateNonCueAssociatedSong(file, fingerprint, ebur128_measures, matching_songs, art_automatic, cue_deleted, t);
         }
         else {  // If CUE associated.
           UpdateCueAssociatedSongs(file, path, fingerprint, new_cue, art_automatic, matching_songs, t);
@@ -736,16 +755,16 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
 
     }
     else {  // Search the DB by fingerprint.
-      QString fingerprint;
-#ifdef HAVE_SONGFINGERPRINTING
-      if (song_tracking_) {
-        Chromaprinter chromaprinter(file);
-        fingerprint = chromaprinter.CreateFingerprint();
-        if (fingerprint.isEmpty()) {
-          fingerprint = "NONE"_L1;
-        }
+
+      // CUE sheet's path from this file (if any).
+      qint64 new_cue_mtime = 0;
+      if (!new_cue.isEmpty()) {
+        new_cue_mtime = static_cast<qint64>(GetMtimeForCue(new_cue));
       }
-#endif
+
+      std::optional<EBUR128Measures> ebur128_measures;
+      const QString fingerprint = AnalyzeFile(file, new_cue_mtime != 0, &ebur128_measures, t);
+
       if (song_tracking_ && !fingerprint.isEmpty() && fingerprint != "NONE"_L1 && FindSongsByFingerprint(file, fingerprint, &matching_songs)) {
 
         // The song is in the database and still on disk.
@@ -774,17 +793,11 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
           }
         }
 
-        // CUE sheet's path from this file (if any).
-        qint64 new_cue_mtime = 0;
-        if (!new_cue.isEmpty()) {
-          new_cue_mtime = static_cast<qint64>(GetMtimeForCue(new_cue));
-        }
-
         // Get new album art
         const QUrl art_automatic = ArtForSong(file, album_art);
 
         if (new_cue.isEmpty() || new_cue_mtime == 0) {  // If no CUE or it's about to lose it.
-          UpdateNonCueAssociatedSong(file, fingerprint, matching_songs, art_automatic, matching_songs_has_cue && new_cue_mtime == 0, t);
+          UpdateNonCueAssociatedSong(file, fingerprint, ebur128_measures, matching_songs, art_automatic, matching_songs_has_cue && new_cue_mtime == 0, t);
         }
         else {  // If CUE associated.
           UpdateCueAssociatedSongs(file, path, fingerprint, new_cue, art_automatic, matching_songs, t);
@@ -793,7 +806,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
       }
       else {  // The song is on disk but not in the DB
 
-        const SongList songs = ScanNewFile(file, path, fingerprint, new_cue, &cues_processed);
+        const SongList songs = ScanNewFile(file, path, fingerprint, ebur128_measures, new_cue, &cues_processed);
         if (songs.isEmpty()) {
           t->AddToProgress(1);
           continue;
@@ -903,6 +916,7 @@ void CollectionWatcher::UpdateCueAssociatedSongs(const QString &file,
 
 void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
                                                    const QString &fingerprint,
+                                                   const std::optional<EBUR128Measures> &ebur128_measures,
                                                    const SongList &matching_songs,
                                                    const QUrl &art_automatic,
                                                    const bool cue_deleted,
@@ -924,7 +938,7 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
     song_on_disk.set_source(source_);
     song_on_disk.set_directory_id(t->dir());
     song_on_disk.set_id(matching_song.id());
-    PerformEBUR128Analysis(song_on_disk);
+    SetEBUR128Measures(ebur128_measures, song_on_disk);
     song_on_disk.set_fingerprint(fingerprint);
     song_on_disk.set_art_automatic(art_automatic);
     song_on_disk.MergeUserSetData(matching_song, !overwrite_playcount_, !overwrite_rating_);
@@ -933,7 +947,9 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
 
 }
 
-SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed) const {
+SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const std::optional<EBUR128Measures> &ebur128_measures, const QString &matching_cue, QSet<QString> *cues_processed) const {
+
+  TRACE_SCOPE("scanner", "Read new file");
 
   SongList songs;
 
@@ -975,7 +991,7 @@ SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path
     const TagReaderResult result = tagreader_client_->ReadFileBlocking(file, &song);
     if (result.success() && song.is_valid()) {
       song.set_source(source_);
-      PerformEBUR128Analysis(song);
+      SetEBUR128Measures(ebur128_measures, song);
       song.set_fingerprint(fingerprint);
       songs << song;
     }
@@ -1068,22 +1084,93 @@ void CollectionWatcher::AddChangedSong(const QString &file, const Song &matching
 
 }
 
+QString CollectionWatcher::AnalyzeFile(const QString &file, const bool cue_associated, std::optional<EBUR128Measures> *ebur128_measures, ScanTransaction *t) const {
+
+  bool fingerprint_enabled = false;
+  bool ebur128_enabled = false;
+#ifdef HAVE_SONGFINGERPRINTING
+  fingerprint_enabled = song_tracking_;
+#endif
+#ifdef HAVE_EBUR128
+  // CUE sections are analyzed one by one in PerformEBUR128Analysis().
+  ebur128_enabled = song_ebur128_loudness_analysis_ && !cue_associated;
+#endif
+
+  QByteArray moodbar_data;
+  const QString fingerprint = AnalyzeAudio(&*backend_, file, fingerprint_enabled, ebur128_enabled, moodbar_ && !cue_associated, ebur128_measures, &moodbar_data);
+  if (!moodbar_data.isEmpty()) {
+    t->moodbars.insert(QUrl::fromLocalFile(file), moodbar_data);
+  }
+
+  return fingerprint;
+
+}
+
+QString CollectionWatcher::AnalyzeAudio(CollectionBackend *backend, const QString &file, const bool fingerprint_enabled, const bool ebur128_enabled, const bool moodbar_enabled, std::optional<EBUR128Measures> *ebur128_measures, QByteArray *moodbar_data) {
+
+  TRACE_SCOPE("scanner", "Analyze file");
+
+  if (!fingerprint_enabled && !ebur128_enabled) return QString();
+
+  // Tag edits don't change the audio, so look for results from an earlier analysis of the same audio first.
+  QString fingerprint;
+  const QString content_key = AudioContentKey::FromFile(file);
+  if (!content_key.isEmpty() && backend->GetAudioAnalysis(content_key, fingerprint_enabled ? &fingerprint : nullptr, ebur128_enabled ? ebur128_measures : nullptr)) {
+    qLog(Debug) << "Using cached analysis for" << file;
+    return fingerprint;
+  }
+
+  const bool need_fingerprint = fingerprint_enabled && fingerprint.isEmpty();
+  const bool need_ebur128 = ebur128_enabled && !*ebur128_measures;
+
+  AudioAnalysis analysis(file);
+  analysis.set_fingerprint_enabled(need_fingerprint);
+  analysis.set_ebur128_enabled(need_ebur128);
+  // The file is decoded anyway, so create the moodbar from the same decoded audio.
+  analysis.set_moodbar_enabled(moodbar_enabled);
+  analysis.Run();
+
+  if (need_fingerprint) {
+    fingerprint = analysis.fingerprint();
+    if (fingerprint.isEmpty()) {
+      fingerprint = "NONE"_L1;
+    }
+  }
+  if (need_ebur128) {
+    *ebur128_measures = analysis.ebur128_measures();
+  }
+
+  *moodbar_data = analysis.moodbar_data();
+
+  if (!content_key.isEmpty()) {
+    backend->AddAudioAnalysis(content_key, need_fingerprint ? fingerprint : QString(), need_ebur128 ? *ebur128_measures : std::nullopt);
+  }
+
+  return fingerprint;
+
+}
+
 void CollectionWatcher::PerformEBUR128Analysis(Song &song) const {
 
   if (!song_ebur128_loudness_analysis_) return;
 
 #ifdef HAVE_EBUR128
-  std::optional<EBUR128Measures> loudness_characteristics = EBUR128Analysis::Compute(song);
-  if (loudness_characteristics) {
-    song.set_ebur128_integrated_loudness_lufs(loudness_characteristics->loudness_lufs);
-    song.set_ebur128_loudness_range_lu(loudness_characteristics->range_lu);
-  }
+  SetEBUR128Measures(EBUR128Analysis::Compute(song), song);
 #else
   Q_UNUSED(song)
 #endif
 
 }
 
+void CollectionWatcher::SetEBUR128Measures(const std::optional<EBUR128Measures> &ebur128_measures, Song &song) {
+
+  if (ebur128_measures) {
+    song.set_ebur128_integrated_loudness_lufs(ebur128_measures->loudness_lufs);
+    song.set_ebur128_loudness_range_lu(ebur128_measures->range_lu);
+  }
+
+}
+
 quint64 CollectionWatcher::GetMtimeForCue(const QString &cue_path) {
 
   if (cue_path.isEmpty()) {
@@ -1335,6 +1422,8 @@ void CollectionWatcher::FullScanNow() { PerformScan(false, true); }
 
 void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mtimes) {
 
+  TRACE_SCOPE("scanner", "Scan");
+
   CancelStop();
 
   for (const CollectionDirectory &dir : std::as_const(watched_dirs_)) {
@@ -1371,6 +1460,8 @@ void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mt
 
 quint64 CollectionWatcher::FilesCountForPath(ScanTransaction *t, const QString &path) {
 
+  TRACE_SCOPE("scanner", "Count files");
+
   const QFileInfo path_info(path);
   if (path_info.isSymLink()) {
     const QString real_path = path_info.symLinkTarget();
@@ -1454,6 +1545,8 @@ void CollectionWatcher::RescanSongsAsync(const SongList &songs) {
 
 void CollectionWatcher::RescanSongs(const SongList &songs) {
 
+  TRACE_SCOPE("scanner", "Rescan songs");
+
   CancelStop();
 
   QStringList scanned_paths;
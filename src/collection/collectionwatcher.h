@@ -24,8 +24,11 @@
 
 #include "config.h"
 
+#include <optional>
+
 #include <QtGlobal>
 #include <QObject>
+#include <QByteArray>
 #include <QHash>
 #include <QMap>
 #include <QMultiMap>
@@ -38,6 +41,7 @@
 #include "collectiondirectory.h"
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "engine/ebur128measures.h"
 
 class QThread;
 class QTimer;
@@ -73,6 +77,10 @@ class CollectionWatcher : public QObject {
   void CancelStop();
   void Abort();
 
+  // Fingerprints and measures the loudness of the file, only decoding it for the results that are not cached in the backend for the same audio.
+  // The moodbar is created from the same decoded audio. Returns the fingerprint.
+  static QString AnalyzeAudio(CollectionBackend *backend, const QString &file, const bool fingerprint_enabled, const bool ebur128_enabled, const bool moodbar_enabled, std::optional<EBUR128Measures> *ebur128_measures, QByteArray *moodbar_data);
+
   void ExitAsync();
 
   void RescanSongsAsync(const SongList &songs);
@@ -86,6 +94,7 @@ class CollectionWatcher : public QObject {
   void SubdirsDiscovered(const CollectionSubdirectoryList &subdirs);
   void SubdirsMTimeUpdated(const CollectionSubdirectoryList &subdirs);
   void CompilationsNeedUpdating();
+  void MoodbarsGenerated(const QMap<QUrl, QByteArray> &moodbars);
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExitFinished();
 
@@ -133,6 +142,7 @@ class CollectionWatcher : public QObject {
     CollectionSubdirectoryList new_subdirs;
     CollectionSubdirectoryList touched_subdirs;
     CollectionSubdirectoryList deleted_subdirs;
+    QMap<QUrl, QByteArray> moodbars;
 
     QStringList files_changed_path_;
 
@@ -199,17 +209,22 @@ class CollectionWatcher : public QObject {
   static quint64 GetMtimeForCue(const QString &cue_path);
   void PerformScan(const bool incremental, const bool ignore_mtimes);
 
+  // Decodes the file once for the fingerprint, and for the loudness characteristics and moodbar unless it's CUE associated.
+  // Returns the fingerprint, the moodbar is added to the transaction.
+  QString AnalyzeFile(const QString &file, const bool cue_associated, std::optional<EBUR128Measures> *ebur128_measures, ScanTransaction *t) const;
+
   // Updates the sections of a cue associated and altered (according to mtime) media file during a scan.
   void UpdateCueAssociatedSongs(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, const QUrl &art_automatic, const SongList &old_cue_songs, ScanTransaction *t) const;
   // Updates a single non-cue associated and altered (according to mtime) song during a scan.
-  void UpdateNonCueAssociatedSong(const QString &file, const QString &fingerprint, const SongList &matching_songs, const QUrl &art_automatic, const bool cue_deleted, ScanTransaction *t);
+  void UpdateNonCueAssociatedSong(const QString &file, const QString &fingerprint, const std::optional<EBUR128Measures> &ebur128_measures, const SongList &matching_songs, const QUrl &art_automatic, const bool cue_deleted, ScanTransaction *t);
   // Scans a single media file that's present on the disk but not yet in the collection.
   // It may result in a multiple files added to the collection when the media file has many sections (like a CUE related media file).
-  SongList ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed) const;
+  SongList ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const std::optional<EBUR128Measures> &ebur128_measures, const QString &matching_cue, QSet<QString> *cues_processed) const;
 
   static void AddChangedSong(const QString &file, const Song &matching_song, const Song &new_song, ScanTransaction *t);
 
   void PerformEBUR128Analysis(Song &song) const;
+  static void SetEBUR128Measures(const std::optional<EBUR128Measures> &ebur128_measures, Song &song);
 
   quint64 FilesCountForPath(ScanTransaction *t, const QString &path);
   quint64 FilesCountForSubdirs(ScanTransaction *t, const CollectionSubdirectoryList &subdirs, QMap<QString, quint64> &subdir_files_count);
@@ -237,6 +252,7 @@ class CollectionWatcher : public QObject {
   bool monitor_;
   bool song_tracking_;
   bool song_ebur128_loudness_analysis_;
+  bool moodbar_;
   bool mark_songs_unavailable_;
   int expire_unavailable_songs_days_;
   bool overwrite_playcount_;
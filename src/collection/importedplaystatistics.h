@@ -0,0 +1,45 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMPORTEDPLAYSTATISTICS_H
+#define IMPORTEDPLAYSTATISTICS_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QMetaType>
+#include <QList>
+#include <QString>
+
+// Play statistics imported from a scrobbling service, matched to songs by artist and title, and album unless it's empty.
+struct ImportedPlayStatistics {
+  ImportedPlayStatistics() : playcount(0), lastplayed(0) {}
+
+  QString artist;
+  QString album;
+  QString title;
+  int playcount;
+  qint64 lastplayed;
+};
+Q_DECLARE_METATYPE(ImportedPlayStatistics)
+
+using ImportedPlayStatisticsList = QList<ImportedPlayStatistics>;
+Q_DECLARE_METATYPE(ImportedPlayStatisticsList)
+
+#endif  // IMPORTEDPLAYSTATISTICS_H
@@ -38,6 +38,9 @@
 #include <QCoreApplication>
 #include <QAbstractEventDispatcher>
 #include <QTimer>
+#include <QMap>
+#include <QUrl>
+#include <QByteArray>
 
 #include "core/logging.h"
 
@@ -276,6 +279,11 @@ Application::Application(QObject *parent)
   collection()->Init();
   tagreader_client();
 
+#ifdef HAVE_MOODBAR
+  // Moodbars created while scanning the collection are saved by the loader, which is only created when first needed.
+  QObject::connect(&*collection(), &CollectionLibrary::MoodbarsGenerated, this, [this](const QMap<QUrl, QByteArray> &moodbars) { moodbar_loader()->StoreMoodbars(moodbars); });
+#endif
+
 }
 
 Application::~Application() {
@@ -85,7 +85,9 @@ constexpr char kHelpText[] =
     "      --quiet                %31\n"
     "      --verbose              %32\n"
     "      --log-levels <levels>  %33\n"
-    "      --version              %34\n";
+    "      --trace <file>         %34\n"
+    "      --stats                %35\n"
+    "      --version              %36\n";
 
 constexpr char kVersionText[] = "Strawberry %1";
 
@@ -107,6 +109,7 @@ CommandlineOptions::CommandlineOptions(int argc, char **argv)
       play_track_at_(-1),
       show_osd_(false),
       toggle_pretty_osd_(false),
+      print_stats_(false),
       log_levels_(QLatin1String(logging::kDefaultLogLevels)) {
 
 #ifdef Q_OS_WIN32
@@ -170,6 +173,8 @@ bool CommandlineOptions::Parse() {
       {L"quiet", no_argument, nullptr, LongOptions::Quiet},
       {L"verbose", no_argument, nullptr, LongOptions::Verbose},
       {L"log-levels", required_argument, nullptr, LongOptions::LogLevels},
+      {L"trace", required_argument, nullptr, LongOptions::Trace},
+      {L"stats", no_argument, nullptr, LongOptions::Stats},
       {L"version", no_argument, nullptr, LongOptions::Version},
       {nullptr, 0, nullptr, 0}
 #else
@@ -201,6 +206,8 @@ bool CommandlineOptions::Parse() {
     { "quiet", no_argument, nullptr, LongOptions::Quiet },
     { "verbose", no_argument, nullptr, LongOptions::Verbose },
     { "log-levels", required_argument, nullptr, LongOptions::LogLevels },
+    { "trace", required_argument, nullptr, LongOptions::Trace },
+    { "stats", no_argument, nullptr, LongOptions::Stats },
     { "version", no_argument, nullptr, LongOptions::Version },
     { nullptr, 0, nullptr, 0 }
 #endif
@@ -251,7 +258,9 @@ bool CommandlineOptions::Parse() {
                      QObject::tr("Equivalent to --log-levels *:1"),
                      QObject::tr("Equivalent to --log-levels *:3"),
                      QObject::tr("Comma separated list of class:level, level is 0-3"))
-                .arg(QObject::tr("Print out version information"));
+                .arg(QObject::tr("Write a Chrome trace event file with the durations of hot paths on exit"),
+                     QObject::tr("Print a summary of the durations of hot paths on exit"),
+                     QObject::tr("Print out version information"));
 
         std::cout << translated_help_text.toLocal8Bit().constData();
         return false;
@@ -316,6 +325,12 @@ bool CommandlineOptions::Parse() {
       case LongOptions::LogLevels:
         log_levels_ = OptArgToString(optarg);
         break;
+      case LongOptions::Trace:
+        trace_filename_ = OptArgToString(optarg);
+        break;
+      case LongOptions::Stats:
+        print_stats_ = true;
+        break;
       case LongOptions::Version:{
         QString version_text = QString::fromUtf8(kVersionText).arg(QLatin1String(STRAWBERRY_VERSION_DISPLAY));
         std::cout << version_text.toLocal8Bit().constData() << std::endl;
@@ -80,6 +80,8 @@ class CommandlineOptions {
   QList<QUrl> urls() const { return urls_; }
   QString language() const { return language_; }
   QString log_levels() const { return log_levels_; }
+  QString trace_filename() const { return trace_filename_; }
+  bool print_stats() const { return print_stats_; }
   QString playlist_name() const { return playlist_name_; }
   QString window_size() const { return window_size_; }
 
@@ -99,7 +101,9 @@ class CommandlineOptions {
     Version,
     VolumeIncreaseBy,
     VolumeDecreaseBy,
-    RestartOrPrevious
+    RestartOrPrevious,
+    Trace,
+    Stats
   };
 
   void RemoveArg(const QString &starts_with, int count);
@@ -131,6 +135,9 @@ class CommandlineOptions {
   int play_track_at_;
   bool show_osd_;
   bool toggle_pretty_osd_;
+  // Only used by this instance, these aren't serialised.
+  QString trace_filename_;
+  bool print_stats_;
   QString language_;
   QString log_levels_;
   QString playlist_name_;
@@ -50,12 +50,17 @@
 
 using namespace Qt::Literals::StringLiterals;
 
-const int Database::kSchemaVersion = 22;
+const int Database::kSchemaVersion = 24;
 
 namespace {
 constexpr char kDatabaseFilename[] = "strawberry.db";
 constexpr int kMinSupportedSchemaVersion = 10;
 constexpr char kMagicAllSongsTables[] = "%allsongstables";
+constexpr char kMemoryDatabaseName[] = ":memory:";
+
+// Per connection, a negative cache size is in KiB.
+constexpr int kCacheSizeKiB = 16384;
+constexpr qint64 kMmapSize = 256LL * 1024LL * 1024LL;
 }  // namespace
 
 int Database::sNextConnectionId = 1;
@@ -120,7 +125,7 @@ QSqlDatabase Database::Connect() {
     }
   }
 
-  const QString connection_id = QStringLiteral("%1_thread_%2").arg(connection_id_).arg(reinterpret_cast<quint64>(QThread::currentThread()));
+  const QString connection_id = ConnectionId(false);
 
   // Try to find an existing connection for this thread
   QSqlDatabase db;
@@ -136,18 +141,15 @@ QSqlDatabase Database::Connect() {
   db.setConnectOptions(u"QSQLITE_BUSY_TIMEOUT=30000"_s);
   //qLog(Debug) << "Opened database with connection id" << connection_id;
 
-  if (injected_database_name_.isNull()) {
-    db.setDatabaseName(directory_ + u'/' + QLatin1String(kDatabaseFilename));
-  }
-  else {
-    db.setDatabaseName(injected_database_name_);
-  }
+  db.setDatabaseName(DatabaseFilename());
 
   if (!db.open()) {
     Q_EMIT Error(u"Database: "_s + db.lastError().text());
     return db;
   }
 
+  SetPragmas(db, false);
+
   if (db.tables().count() == 0) {
     // Set up initial schema
     qLog(Info) << "Creating initial database schema";
@@ -158,29 +160,14 @@ QSqlDatabase Database::Connect() {
     qFatal("Database schema too old.");
   }
 
-  // Attach external databases
-  QStringList keys = attached_databases_.keys();
-  for (const QString &key : std::as_const(keys)) {
-    QString filename = attached_databases_.value(key).filename_;
-
-    if (!injected_database_name_.isNull()) filename = injected_database_name_;
-
-    // Attach the db
-    SqlQuery q(db);
-    q.prepare(u"ATTACH DATABASE :filename AS :alias"_s);
-    q.BindValue(u":filename"_s, filename);
-    q.BindValue(u":alias"_s, key);
-    if (!q.Exec()) {
-      qFatal("Couldn't attach external database '%s'", key.toLatin1().constData());
-    }
-  }
+  AttachDatabases(db);
 
   if (startup_schema_version_ == -1) {
     UpdateMainSchema(&db);
   }
 
   // We might have to initialize the schema in some attached databases now, if they were deleted and don't match up with the main schema version.
-  keys = attached_databases_.keys();
+  const QStringList keys = attached_databases_.keys();
   for (const QString &key : std::as_const(keys)) {
     if (attached_databases_.value(key).is_temporary_ && attached_databases_.value(key).schema_.isEmpty()) {
       continue;
@@ -198,22 +185,130 @@ QSqlDatabase Database::Connect() {
 
 }
 
-void Database::Close() {
+QSqlDatabase Database::ConnectReadOnly() {
+
+  // Every connection to an in-memory database opens a new empty database.
+  if (is_memory_database()) {
+    return Connect();
+  }
 
   QMutexLocker l(&connect_mutex_);
 
-  const QString connection_id = QStringLiteral("%1_thread_%2").arg(connection_id_).arg(reinterpret_cast<quint64>(QThread::currentThread()));
+  const QString connection_id = ConnectionId(true);
 
-  // Try to find an existing connection for this thread
+  QSqlDatabase db;
   if (QSqlDatabase::connectionNames().contains(connection_id)) {
-    {
-      QSqlDatabase db = QSqlDatabase::database(connection_id);
-      if (db.isOpen()) {
-        db.close();
-        //qLog(Debug) << "Closed database with connection id" << connection_id;
+    db = QSqlDatabase::database(connection_id);
+  }
+  else {
+    db = QSqlDatabase::addDatabase(u"QSQLITE"_s, connection_id);
+  }
+  if (db.isOpen()) {
+    return db;
+  }
+  db.setConnectOptions(u"QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=30000"_s);
+  db.setDatabaseName(DatabaseFilename());
+
+  // The schema is created and updated by the first read-write connection, opened by the constructor.
+  if (!db.open()) {
+    Q_EMIT Error(u"Database: "_s + db.lastError().text());
+    return db;
+  }
+
+  SetPragmas(db, true);
+  AttachDatabases(db);
+
+  return db;
+
+}
+
+void Database::Close() {
+
+  QMutexLocker l(&connect_mutex_);
+
+  // Close both connections for this thread
+  const QStringList connection_ids = QStringList() << ConnectionId(false) << ConnectionId(true);
+  for (const QString &connection_id : connection_ids) {
+    if (QSqlDatabase::connectionNames().contains(connection_id)) {
+      {
+        QSqlDatabase db = QSqlDatabase::database(connection_id);
+        if (db.isOpen()) {
+          db.close();
+          //qLog(Debug) << "Closed database with connection id" << connection_id;
+        }
       }
+      QSqlDatabase::removeDatabase(connection_id);
+    }
+  }
+
+}
+
+QString Database::ConnectionId(const bool read_only) const {
+
+  QString connection_id = QStringLiteral("%1_thread_%2").arg(connection_id_).arg(reinterpret_cast<quint64>(QThread::currentThread()));
+  if (read_only) connection_id.append(u"_readonly"_s);
+
+  return connection_id;
+
+}
+
+QString Database::DatabaseFilename() const {
+
+  if (injected_database_name_.isNull()) {
+    return directory_ + u'/' + QLatin1String(kDatabaseFilename);
+  }
+
+  return injected_database_name_;
+
+}
+
+bool Database::is_memory_database() const {
+
+  return injected_database_name_ == QLatin1String(kMemoryDatabaseName);
+
+}
+
+void Database::SetPragmas(QSqlDatabase &db, const bool read_only) {
+
+  QStringList pragmas = QStringList() << QStringLiteral("PRAGMA cache_size = -%1").arg(kCacheSizeKiB);
+
+  if (!is_memory_database()) {
+    pragmas << QStringLiteral("PRAGMA mmap_size = %1").arg(kMmapSize);
+    // The journal mode is stored in the database file, so only the read-write connection needs to set it.
+    // Readers then see the last commit while a transaction is written, instead of waiting for it.
+    if (!read_only) {
+      pragmas << u"PRAGMA journal_mode = WAL"_s
+              << u"PRAGMA synchronous = NORMAL"_s;
+    }
+  }
+
+  for (const QString &pragma : std::as_const(pragmas)) {
+    SqlQuery q(db);
+    q.prepare(pragma);
+    if (!q.Exec()) {
+      qLog(Warning) << "Failed to set" << pragma << q.lastError().text();
+    }
+  }
+
+}
+
+void Database::AttachDatabases(QSqlDatabase &db) {
+
+  // Attach external databases
+  const QStringList keys = attached_databases_.keys();
+  for (const QString &key : keys) {
+    QString filename = attached_databases_.value(key).filename_;
+
+    if (!injected_database_name_.isNull()) filename = injected_database_name_;
+
+    // Attach the db
+    SqlQuery q(db);
+    q.prepare(u"ATTACH DATABASE :filename AS :alias"_s);
+    q.BindValue(u":filename"_s, filename);
+    q.BindValue(u":alias"_s, key);
+    if (!q.Exec()) {
+      qFatal("Couldn't attach external database '%s'", key.toLatin1().constData());
     }
-    QSqlDatabase::removeDatabase(connection_id);
   }
 
 }
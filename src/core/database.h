@@ -63,6 +63,9 @@ class Database : public QObject {
 
   void ExitAsync();
   QSqlDatabase Connect();
+  // Opens a read-only connection for the current thread.
+  // Queries on it don't need Mutex(), with the WAL journal they don't wait for writers either.
+  QSqlDatabase ConnectReadOnly();
   void Close();
   void ReportErrors(const SqlQuery &query);
 
@@ -102,6 +105,11 @@ class Database : public QObject {
   bool IntegrityCheck(const QSqlDatabase &db);
   void BackupFile(const QString &filename);
   static bool OpenDatabase(const QString &filename, sqlite3 **connection);
+  QString ConnectionId(const bool read_only) const;
+  QString DatabaseFilename() const;
+  bool is_memory_database() const;
+  void SetPragmas(QSqlDatabase &db, const bool read_only);
+  void AttachDatabases(QSqlDatabase &db);
 
   SharedPtr<TaskManager> task_manager_;
 
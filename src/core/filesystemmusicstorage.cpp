@@ -34,8 +34,16 @@
 
 #include "filesystemmusicstorage.h"
 
+namespace {
+constexpr int kMaxConcurrentCopyJobs = 4;
+}  // namespace
+
 FilesystemMusicStorage::FilesystemMusicStorage(const Song::Source source, const QString &root, const std::optional<int> collection_directory_id) : source_(source), root_(root), collection_directory_id_(collection_directory_id) {}
 
+int FilesystemMusicStorage::MaxConcurrentCopyJobs() const {
+  return kMaxConcurrentCopyJobs;
+}
+
 bool FilesystemMusicStorage::CopyToStorage(const CopyJob &job, QString &error_text) {
 
   const QFileInfo src = QFileInfo(job.source_);
@@ -93,14 +101,14 @@ bool FilesystemMusicStorage::CopyToStorage(const CopyJob &job, QString &error_te
       qLog(Error) << error_text;
     }
     else {
-      result = QFile::copy(src.absoluteFilePath(), dest.absoluteFilePath());
+      result = Utilities::CopyLocalFile(src.absoluteFilePath(), dest.absoluteFilePath(), job.progress_);
       if (!result) {
         error_text = QObject::tr("Could not copy file %1 to %2.").arg(src.absoluteFilePath(), dest.absoluteFilePath());
         qLog(Error) << error_text;
       }
     }
     if ((!cover_dest.exists() || job.overwrite_) && !cover_src.filePath().isEmpty() && !cover_dest.filePath().isEmpty()) {
-      QFile::copy(cover_src.absoluteFilePath(), cover_dest.absoluteFilePath());
+      Utilities::CopyLocalFile(cover_src.absoluteFilePath(), cover_dest.absoluteFilePath());
     }
   }
 
@@ -89,6 +89,9 @@ QNetworkReply *HttpBaseRequest::CreateGetRequest(const QUrl &url, const QUrlQuer
   if (fake_user_agent_header) {
     network_request.setHeader(QNetworkRequest::UserAgentHeader, u"Mozilla/5.0 (X11; Linux x86_64; rv:122.0) Gecko/20100101 Firefox/122.0"_s);
   }
+  if (cache_replies()) {
+    network_request.setAttribute(NetworkAccessManager::kCacheLifetimeAttribute, NetworkAccessManager::kReplyCacheLifetimeSec);
+  }
   QNetworkReply *reply = network_->get(network_request);
   QObject::connect(reply, &QNetworkReply::sslErrors, this, &HttpBaseRequest::HandleSSLErrors);
   replies_ << reply;
@@ -85,6 +85,8 @@ class HttpBaseRequest : public QObject {
   virtual bool authenticated() const = 0;
   virtual bool use_authorization_header() const = 0;
   virtual QByteArray authorization_header() const = 0;
+  // Keep the replies to GET requests in the disk cache for a while, for search requests that are repeated.
+  virtual bool cache_replies() const { return false; }
 
   virtual QNetworkReply *CreateGetRequest(const QUrl &url, const bool fake_user_agent_header);
   virtual QNetworkReply *CreateGetRequest(const QUrl &url, const ParamList &params = ParamList(), const bool fake_user_agent_header = false);
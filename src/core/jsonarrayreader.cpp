@@ -0,0 +1,231 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtGlobal>
+#include <QIODevice>
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QByteArrayView>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+
+#include "jsonarrayreader.h"
+
+namespace {
+constexpr qint64 kReadChunkSize = 65536;
+}  // namespace
+
+JsonArrayReader::JsonArrayReader(const QByteArray &data, const QByteArrayList &path)
+    : device_(nullptr),
+      data_(data),
+      pos_(-1),
+      found_(false),
+      error_(false),
+      first_(true) {
+
+  found_ = FindArray(path);
+
+}
+
+JsonArrayReader::JsonArrayReader(QIODevice *device, const QByteArrayList &path)
+    : device_(device),
+      pos_(-1),
+      found_(false),
+      error_(false),
+      first_(true) {
+
+  found_ = FindArray(path);
+
+}
+
+bool JsonArrayReader::Available(const qsizetype pos) {
+
+  while (pos >= data_.size()) {
+    if (!device_) return false;
+    const QByteArray data = device_->read(kReadChunkSize);
+    if (data.isEmpty()) return false;
+    data_.append(data);
+  }
+
+  return true;
+
+}
+
+QByteArray JsonArrayReader::ReadAll() {
+
+  if (device_) {
+    data_.append(device_->readAll());
+  }
+
+  return data_;
+
+}
+
+bool JsonArrayReader::FindArray(const QByteArrayList &path) {
+
+  qsizetype pos = SkipWhitespace(0);
+
+  for (const QByteArray &key : path) {
+    if (!Available(pos) || data_[pos] != '{') return false;
+    pos = SkipWhitespace(pos + 1);
+    bool key_found = false;
+    while (Available(pos) && data_[pos] == '"') {
+      const qsizetype key_end = SkipString(pos);
+      if (key_end < 0) return false;
+      // Compare the key now, reading more data can move it.
+      const bool key_matches = QByteArrayView(data_.constData() + pos + 1, key_end - pos - 2).compare(key) == 0;
+      pos = SkipWhitespace(key_end);
+      if (!Available(pos) || data_[pos] != ':') return false;
+      pos = SkipWhitespace(pos + 1);
+      if (key_matches) {
+        key_found = true;
+        break;
+      }
+      pos = SkipValue(pos);
+      if (pos < 0) return false;
+      pos = SkipWhitespace(pos);
+      if (!Available(pos) || data_[pos] != ',') break;
+      pos = SkipWhitespace(pos + 1);
+    }
+    if (!key_found) return false;
+  }
+
+  if (!Available(pos) || data_[pos] != '[') return false;
+
+  pos_ = pos + 1;
+
+  return true;
+
+}
+
+qsizetype JsonArrayReader::SkipWhitespace(qsizetype pos) {
+
+  while (Available(pos) && (data_[pos] == ' ' || data_[pos] == '\t' || data_[pos] == '\r' || data_[pos] == '\n')) {
+    ++pos;
+  }
+
+  return pos;
+
+}
+
+qsizetype JsonArrayReader::SkipString(qsizetype pos) {
+
+  for (++pos; Available(pos); ++pos) {
+    if (data_[pos] == '\\') ++pos;
+    else if (data_[pos] == '"') return pos + 1;
+  }
+
+  return -1;
+
+}
+
+qsizetype JsonArrayReader::SkipValue(qsizetype pos) {
+
+  if (!Available(pos)) return -1;
+
+  const char c = data_[pos];
+  if (c == '"') {
+    return SkipString(pos);
+  }
+
+  if (c == '{' || c == '[') {
+    int depth = 0;
+    while (Available(pos)) {
+      switch (data_[pos]) {
+        case '"':
+          pos = SkipString(pos);
+          if (pos < 0) return -1;
+          continue;
+        case '{':
+        case '[':
+          ++depth;
+          break;
+        case '}':
+        case ']':
+          if (--depth == 0) return pos + 1;
+          break;
+        default:
+          break;
+      }
+      ++pos;
+    }
+    return -1;
+  }
+
+  // Numbers, true, false and null.
+  const qsizetype start = pos;
+  while (Available(pos) && data_[pos] != ',' && data_[pos] != '}' && data_[pos] != ']' && data_[pos] != ' ' && data_[pos] != '\t' && data_[pos] != '\r' && data_[pos] != '\n') {
+    ++pos;
+  }
+
+  return pos > start ? pos : -1;
+
+}
+
+bool JsonArrayReader::Next(QJsonObject &json_object) {
+
+  if (!found_ || error_ || pos_ < 0) return false;
+
+  // Drop the elements already read.
+  if (device_ && pos_ >= kReadChunkSize) {
+    data_.remove(0, pos_);
+    pos_ = 0;
+  }
+
+  qsizetype pos = SkipWhitespace(pos_);
+  if (!Available(pos)) {
+    error_ = true;
+    return false;
+  }
+
+  if (data_[pos] == ']') {
+    pos_ = -1;
+    return false;
+  }
+
+  if (!first_) {
+    if (data_[pos] != ',') {
+      error_ = true;
+      return false;
+    }
+    pos = SkipWhitespace(pos + 1);
+  }
+  first_ = false;
+
+  const qsizetype end = SkipValue(pos);
+  if (end < 0) {
+    error_ = true;
+    return false;
+  }
+
+  // The element is parsed from the read data without copying it.
+  QJsonParseError json_parse_error;
+  const QJsonDocument json_document = QJsonDocument::fromJson(QByteArray::fromRawData(data_.constData() + pos, end - pos), &json_parse_error);
+  if (json_parse_error.error != QJsonParseError::NoError || !json_document.isObject()) {
+    error_ = true;
+    return false;
+  }
+
+  json_object = json_document.object();
+  pos_ = end;
+
+  return true;
+
+}
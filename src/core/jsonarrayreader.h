@@ -0,0 +1,68 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef JSONARRAYREADER_H
+#define JSONARRAYREADER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QJsonObject>
+
+class QIODevice;
+
+// Reads the objects of an array nested in a JSON document one at a time,
+// so only one element is held as a QJsonObject instead of the whole document.
+// The array is found by following the object keys in path, keys containing escape sequences are not matched.
+// When reading from a device, the data is read in chunks as it is needed and the elements already read are dropped.
+// The reader doesn't use any QObjects and can be used from any thread, as long as the device is only read from that thread.
+
+class JsonArrayReader {
+ public:
+  explicit JsonArrayReader(const QByteArray &data, const QByteArrayList &path);
+  explicit JsonArrayReader(QIODevice *device, const QByteArrayList &path);
+
+  // Returns true if the path leads to an array.
+  bool found() const { return found_; }
+
+  // Returns true if the data is not valid JSON, or an element in the array is not an object.
+  bool error() const { return error_; }
+
+  // Reads the next element, returns false when the end of the array is reached or on errors.
+  bool Next(QJsonObject &json_object);
+
+  // Returns the data read so far followed by the rest of the device, to parse the whole document when the array was not found.
+  QByteArray ReadAll();
+
+ private:
+  bool Available(const qsizetype pos);
+  bool FindArray(const QByteArrayList &path);
+  qsizetype SkipWhitespace(qsizetype pos);
+  qsizetype SkipString(qsizetype pos);
+  qsizetype SkipValue(qsizetype pos);
+
+  QIODevice *device_;
+  QByteArray data_;
+  qsizetype pos_;
+  bool found_;
+  bool error_;
+  bool first_;
+};
+
+#endif  // JSONARRAYREADER_H
@@ -0,0 +1,152 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <memory>
+
+#include <QObject>
+#include <QMetaObject>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QVariant>
+#include <QList>
+#include <QIODevice>
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+
+#include "includes/shared_ptr.h"
+#include "jsonreply.h"
+#include "jsonarrayreader.h"
+
+using std::make_shared;
+
+namespace {
+constexpr char kJsonReplyProperty[] = "json_reply";
+constexpr int kArrayBatchSize = 50;
+}  // namespace
+
+JsonReply::JsonReply() : empty(true), array_found(false), array_error(false) {
+
+  json_parse_error.offset = 0;
+  json_parse_error.error = QJsonParseError::NoError;
+
+}
+
+JsonReply JsonReply::Parse(const QByteArray &data) {
+
+  JsonReply json_reply;
+  if (!data.isEmpty()) {
+    json_reply.empty = false;
+    json_reply.json_document = QJsonDocument::fromJson(data, &json_reply.json_parse_error);
+  }
+
+  return json_reply;
+
+}
+
+JsonReply JsonReply::ParseArray(QIODevice *device, const QByteArrayList &path, const std::function<void(const QJsonObject&)> &element_receiver) {
+
+  JsonArrayReader json_array_reader(device, path);
+  if (!json_array_reader.found()) {
+    return Parse(json_array_reader.ReadAll());
+  }
+
+  JsonReply json_reply;
+  json_reply.empty = false;
+  json_reply.array_found = true;
+  QJsonObject json_object;
+  while (json_array_reader.Next(json_object)) {
+    element_receiver(json_object);
+  }
+  json_reply.array_error = json_array_reader.error();
+
+  return json_reply;
+
+}
+
+void JsonReply::ParseInBackground(QNetworkReply *reply, QObject *context, const std::function<void()> &receiver) {
+
+  const QByteArray data = reply->readAll();
+  QPointer<QNetworkReply> reply_ptr(reply);
+
+  QFuture<JsonReply> future = QtConcurrent::run(&JsonReply::Parse, data);
+  QFutureWatcher<JsonReply> *watcher = new QFutureWatcher<JsonReply>();
+  QObject::connect(watcher, &QFutureWatcher<JsonReply>::finished, context, [watcher, reply_ptr, receiver]() {
+    if (reply_ptr) {
+      reply_ptr->setProperty(kJsonReplyProperty, QVariant::fromValue(watcher->result()));
+      receiver();
+    }
+  });
+  QObject::connect(watcher, &QFutureWatcher<JsonReply>::finished, watcher, &QObject::deleteLater);
+  watcher->setFuture(future);
+
+}
+
+JsonReply JsonReply::Read(QNetworkReply *reply) {
+
+  const QVariant json_reply = reply->property(kJsonReplyProperty);
+  if (json_reply.isValid()) {
+    return json_reply.value<JsonReply>();
+  }
+
+  return Parse(reply->readAll());
+
+}
+
+void JsonReply::ParseArrayInBackground(QNetworkReply *reply, const QByteArrayList &path, QObject *context, const std::function<void(QNetworkReply*, const QList<QJsonObject>&)> &elements_receiver, const std::function<void(QNetworkReply*, const JsonReply&)> &receiver) {
+
+  // The reply is finished, so only the worker thread reads it. Make sure it's not deleted with the network access manager meanwhile.
+  reply->setParent(nullptr);
+
+  // The batches are queued to the watcher, so they are received before the watcher finishes.
+  // The context pointer is only copied in the worker thread, it is checked in the thread of the watcher.
+  QFutureWatcher<JsonReply> *watcher = new QFutureWatcher<JsonReply>();
+  const SharedPtr<QPointer<QObject>> context_ptr = make_shared<QPointer<QObject>>(context);
+  const auto send_elements = [watcher, context_ptr, reply, elements_receiver](const QList<QJsonObject> &elements) {
+    QMetaObject::invokeMethod(watcher, [context_ptr, reply, elements_receiver, elements]() {
+      if (*context_ptr) elements_receiver(reply, elements);
+    }, Qt::QueuedConnection);
+  };
+
+  QFuture<JsonReply> future = QtConcurrent::run([reply, path, send_elements]() {
+    QList<QJsonObject> elements;
+    const JsonReply json_reply = ParseArray(reply, path, [&elements, &send_elements](const QJsonObject &element) {
+      elements << element;
+      if (elements.count() >= kArrayBatchSize) {
+        send_elements(elements);
+        elements.clear();
+      }
+    });
+    if (!elements.isEmpty()) send_elements(elements);
+    return json_reply;
+  });
+  QObject::connect(watcher, &QFutureWatcher<JsonReply>::finished, context, [watcher, reply, receiver]() { receiver(reply, watcher->result()); });
+  QObject::connect(watcher, &QFutureWatcher<JsonReply>::finished, watcher, [watcher, reply]() {
+    reply->deleteLater();
+    watcher->deleteLater();
+  });
+  watcher->setFuture(future);
+
+}
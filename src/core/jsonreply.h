@@ -0,0 +1,73 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef JSONREPLY_H
+#define JSONREPLY_H
+
+#include <functional>
+
+#include <QMetaType>
+#include <QList>
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+
+class QObject;
+class QIODevice;
+class QNetworkReply;
+
+// The Json document of a network reply.
+// Large replies can be parsed in a worker thread with ParseInBackground(), the request classes then get the parsed document from Read().
+
+class JsonReply {
+ public:
+  JsonReply();
+
+  bool empty;
+  QJsonDocument json_document;
+  QJsonParseError json_parse_error;
+
+  // Whether ParseArray() found the array, the document is only parsed when it was not found.
+  bool array_found;
+  bool array_error;
+
+  static JsonReply Parse(const QByteArray &data);
+
+  // Reads the objects of the array at path from the device one at a time with JsonArrayReader, and passes each of them to element_receiver.
+  static JsonReply ParseArray(QIODevice *device, const QByteArrayList &path, const std::function<void(const QJsonObject&)> &element_receiver);
+
+  // Reads the data of a finished reply and parses it in a worker thread.
+  // The receiver is called from the thread of the context object when done, unless the context object or reply was deleted.
+  static void ParseInBackground(QNetworkReply *reply, QObject *context, const std::function<void()> &receiver);
+
+  // Returns the document parsed by ParseInBackground(), or reads and parses the reply now.
+  static JsonReply Read(QNetworkReply *reply);
+
+  // Reads the array at path from a finished reply in a worker thread, without reading the whole reply first.
+  // The objects are passed to elements_receiver in small batches while reading, and receiver is called when done, both from the thread of the context object.
+  // The reply is taken over: the caller must not use or delete it until the receiver is called.
+  // The reply is deleted after that, also when the context object was deleted.
+  static void ParseArrayInBackground(QNetworkReply *reply, const QByteArrayList &path, QObject *context, const std::function<void(QNetworkReply*, const QList<QJsonObject>&)> &elements_receiver, const std::function<void(QNetworkReply*, const JsonReply&)> &receiver);
+};
+
+Q_DECLARE_METATYPE(JsonReply)
+
+#endif  // JSONREPLY_H
@@ -48,6 +48,7 @@
 #include "engine/enginebase.h"
 #include "engine/gstenginepipeline.h"
 #include "collection/collectiondirectory.h"
+#include "collection/importedplaystatistics.h"
 #include "playlist/playlistitem.h"
 #include "playlist/playlistsequence.h"
 #include "covermanager/albumcoverloaderresult.h"
@@ -114,6 +115,7 @@ void RegisterMetaTypes() {
   qRegisterMetaType<CollectionDirectoryList>("CollectionDirectoryList");
   qRegisterMetaType<CollectionSubdirectory>("CollectionSubdirectory");
   qRegisterMetaType<CollectionSubdirectoryList>("CollectionSubdirectoryList");
+  qRegisterMetaType<ImportedPlayStatisticsList>("ImportedPlayStatisticsList");
   qRegisterMetaType<CollectionModel::Grouping>("CollectionModel::Grouping");
   qRegisterMetaType<PlaylistItemPtr>("PlaylistItemPtr");
   qRegisterMetaType<PlaylistItemPtrList>("PlaylistItemPtrList");
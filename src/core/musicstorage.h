@@ -88,6 +88,9 @@ class MusicStorage {
   virtual Song::FileType GetTranscodeFormat() const { return Song::FileType::Unknown; }
   virtual bool GetSupportedFiletypes(QList<Song::FileType> *ret) { Q_UNUSED(ret); return true; }
 
+  // Number of CopyToStorage() calls that can run at the same time from different threads.
+  virtual int MaxConcurrentCopyJobs() const { return 1; }
+
   virtual bool StartCopy(QList<Song::FileType> *supported_types) { Q_UNUSED(supported_types); return true; }
   virtual bool CopyToStorage(const CopyJob &job, QString &error_text) = 0;
   virtual bool FinishCopy(bool success, QString &error_text) { Q_UNUSED(error_text); return success; }
@@ -26,15 +26,23 @@
 #include <QIODevice>
 #include <QByteArray>
 #include <QString>
+#include <QUrl>
+#include <QDateTime>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QNetworkCacheMetaData>
+#include <QAbstractNetworkCache>
 
 #include "networkaccessmanager.h"
 #include "threadsafenetworkdiskcache.h"
 
 using namespace Qt::Literals::StringLiterals;
 
+namespace {
+constexpr qint64 kNotFoundCacheLifetimeSec = 86400;
+}  // namespace
+
 NetworkAccessManager::NetworkAccessManager(QObject *parent)
     : QNetworkAccessManager(parent) {
 
@@ -66,6 +74,74 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     new_network_request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
   }
 
-  return QNetworkAccessManager::createRequest(op, new_network_request, outgoing_data);
+  const qint64 cache_lifetime = op == QNetworkAccessManager::GetOperation && cache() ? network_request.attribute(kCacheLifetimeAttribute).toLongLong() : 0;
+  if (cache_lifetime > 0) {
+    // The cache is preferred regardless of the cache headers, so expired replies have to be removed here.
+    const QNetworkCacheMetaData metadata = cache()->metaData(network_request.url());
+    if (metadata.isValid() && (!metadata.expirationDate().isValid() || metadata.expirationDate() < QDateTime::currentDateTime())) {
+      cache()->remove(network_request.url());
+    }
+  }
+
+  QNetworkReply *reply = QNetworkAccessManager::createRequest(op, new_network_request, outgoing_data);
+
+  if (cache_lifetime > 0) {
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_lifetime]() { CacheReply(reply, cache_lifetime); });
+  }
+
+  return reply;
+
+}
+
+void NetworkAccessManager::CacheReply(QNetworkReply *reply, const qint64 cache_lifetime) {
+
+  if (!cache() || reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() || reply->url() != reply->request().url()) return;
+
+  const int http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  qint64 lifetime = 0;
+  if (reply->error() == QNetworkReply::NoError && http_status_code >= 200 && http_status_code <= 207) {
+    lifetime = cache_lifetime;
+  }
+  else if (reply->error() == QNetworkReply::ContentNotFoundError || http_status_code == 404) {
+    lifetime = qMin(cache_lifetime, kNotFoundCacheLifetimeSec);
+  }
+  else {
+    return;
+  }
+
+  const QUrl url = reply->request().url();
+  const QDateTime expiration_date = QDateTime::currentDateTime().addSecs(lifetime);
+
+  QNetworkCacheMetaData metadata = cache()->metaData(url);
+  if (metadata.isValid()) {
+    metadata.setExpirationDate(expiration_date);
+    cache()->updateMetaData(metadata);
+    return;
+  }
+
+  // The server asked not to cache the reply, or it is an error.
+  QNetworkCacheMetaData::RawHeaderList raw_headers;
+  const QList<QNetworkReply::RawHeaderPair> reply_raw_headers = reply->rawHeaderPairs();
+  for (const QNetworkReply::RawHeaderPair &raw_header : reply_raw_headers) {
+    const QByteArray name = raw_header.first.toLower();
+    if (name != "cache-control" && name != "pragma" && name != "expires" && name != "set-cookie") {
+      raw_headers << raw_header;
+    }
+  }
+
+  QNetworkCacheMetaData::AttributesMap attributes;
+  attributes.insert(QNetworkRequest::HttpStatusCodeAttribute, http_status_code);
+  attributes.insert(QNetworkRequest::HttpReasonPhraseAttribute, reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+
+  metadata.setUrl(url);
+  metadata.setRawHeaders(raw_headers);
+  metadata.setAttributes(attributes);
+  metadata.setExpirationDate(expiration_date);
+  metadata.setSaveToDisk(true);
+
+  QIODevice *device = cache()->prepare(metadata);
+  if (!device) return;
+  device->write(reply->peek(reply->bytesAvailable()));
+  cache()->insert(device);
 
 }
@@ -39,8 +39,18 @@ class NetworkAccessManager : public QNetworkAccessManager {
  public:
   explicit NetworkAccessManager(QObject *parent = nullptr);
 
+  // Seconds to keep the reply of a GET request in the disk cache, even if the server asked not to cache it.
+  // Replies for content that was not found are kept for a shorter time.
+  static constexpr QNetworkRequest::Attribute kCacheLifetimeAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+
+  // Default cache lifetime for replies that don't change, like metadata lookups.
+  static constexpr qint64 kReplyCacheLifetimeSec = 604800;  // One week
+
  protected:
   QNetworkReply *createRequest(Operation op, const QNetworkRequest &network_request, QIODevice *outgoing_data) override;
+
+ private:
+  void CacheReply(QNetworkReply *reply, const qint64 cache_lifetime);
 };
 
 #endif  // NETWORKACCESSMANAGER_H
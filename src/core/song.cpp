@@ -22,6 +22,7 @@
 #include "config.h"
 
 #include <algorithm>
+#include <iterator>
 
 #ifdef HAVE_GPOD
 #  include <gdk-pixbuf/gdk-pixbuf.h>
@@ -56,7 +57,7 @@
 #include "utilities/timeutils.h"
 #include "utilities/coverutils.h"
 #include "constants/timeconstants.h"
-#include "utilities/sqlhelper.h"
+#include "covermanager/covercacheindex.h"
 
 #include "song.h"
 #include "sqlquery.h"
@@ -67,95 +68,238 @@
 
 using namespace Qt::Literals::StringLiterals;
 
-const QStringList Song::kColumns = QStringList() << u"title"_s
-                                                 << u"titlesort"_s
-                                                 << u"album"_s
-                                                 << u"albumsort"_s
-                                                 << u"artist"_s
-                                                 << u"artistsort"_s
-                                                 << u"albumartist"_s
-                                                 << u"albumartistsort"_s
-                                                 << u"track"_s
-                                                 << u"disc"_s
-                                                 << u"year"_s
-                                                 << u"originalyear"_s
-                                                 << u"genre"_s
-                                                 << u"compilation"_s
-                                                 << u"composer"_s
-                                                 << u"composersort"_s
-                                                 << u"performer"_s
-                                                 << u"performersort"_s
-                                                 << u"grouping"_s
-                                                 << u"comment"_s
-                                                 << u"lyrics"_s
-
-                                                 << u"artist_id"_s
-                                                 << u"album_id"_s
-                                                 << u"song_id"_s
-
-                                                 << u"beginning"_s
-                                                 << u"length"_s
-
-                                                 << u"bitrate"_s
-                                                 << u"samplerate"_s
-                                                 << u"bitdepth"_s
-
-                                                 << u"source"_s
-                                                 << u"directory_id"_s
-                                                 << u"url"_s
-                                                 << u"filetype"_s
-                                                 << u"filesize"_s
-                                                 << u"mtime"_s
-                                                 << u"ctime"_s
-                                                 << u"unavailable"_s
-
-                                                 << u"fingerprint"_s
-
-                                                 << u"playcount"_s
-                                                 << u"skipcount"_s
-                                                 << u"lastplayed"_s
-                                                 << u"lastseen"_s
-
-                                                 << u"compilation_detected"_s
-                                                 << u"compilation_on"_s
-                                                 << u"compilation_off"_s
-                                                 << u"compilation_effective"_s
-
-                                                 << u"art_embedded"_s
-                                                 << u"art_automatic"_s
-                                                 << u"art_manual"_s
-                                                 << u"art_unset"_s
-
-                                                 << u"effective_albumartist"_s
-                                                 << u"effective_originalyear"_s
-
-                                                 << u"cue_path"_s
-
-                                                 << u"rating"_s
-                                                 << u"bpm"_s
-                                                 << u"mood"_s
-                                                 << u"initial_key"_s
-
-                                                 << u"acoustid_id"_s
-                                                 << u"acoustid_fingerprint"_s
-
-                                                 << u"musicbrainz_album_artist_id"_s
-                                                 << u"musicbrainz_artist_id"_s
-                                                 << u"musicbrainz_original_artist_id"_s
-                                                 << u"musicbrainz_album_id"_s
-                                                 << u"musicbrainz_original_album_id"_s
-                                                 << u"musicbrainz_recording_id"_s
-                                                 << u"musicbrainz_track_id"_s
-                                                 << u"musicbrainz_disc_id"_s
-                                                 << u"musicbrainz_release_group_id"_s
-                                                 << u"musicbrainz_work_id"_s
-
-                                                 << u"ebur128_integrated_loudness_lufs"_s
-                                                 << u"ebur128_loudness_range_lu"_s
-
-                                                 ;
-
-const QStringList Song::kRowIdColumns = QStringList() << u"ROWID"_s << kColumns;
+namespace {
+
+// Column names in the order they are selected by kRowIdColumnSpec, the position in this table is the column ordinal.
+constexpr const char *kRowIdColumnNames[] = {
+  "ROWID",
+
+  "title",
+  "titlesort",
+  "album",
+  "albumsort",
+  "artist",
+  "artistsort",
+  "albumartist",
+  "albumartistsort",
+  "track",
+  "disc",
+  "year",
+  "originalyear",
+  "genre",
+  "compilation",
+  "composer",
+  "composersort",
+  "performer",
+  "performersort",
+  "grouping",
+  "comment",
+  "lyrics",
+
+  "artist_id",
+  "album_id",
+  "song_id",
+
+  "beginning",
+  "length",
+
+  "bitrate",
+  "samplerate",
+  "bitdepth",
+
+  "source",
+  "directory_id",
+  "url",
+  "filetype",
+  "filesize",
+  "mtime",
+  "ctime",
+  "unavailable",
+
+  "fingerprint",
+
+  "playcount",
+  "skipcount",
+  "lastplayed",
+  "lastseen",
+
+  "compilation_detected",
+  "compilation_on",
+  "compilation_off",
+  "compilation_effective",
+
+  "art_embedded",
+  "art_automatic",
+  "art_manual",
+  "art_unset",
+
+  "effective_albumartist",
+  "effective_originalyear",
+
+  "cue_path",
+
+  "rating",
+  "bpm",
+  "mood",
+  "initial_key",
+
+  "acoustid_id",
+  "acoustid_fingerprint",
+
+  "musicbrainz_album_artist_id",
+  "musicbrainz_artist_id",
+  "musicbrainz_original_artist_id",
+  "musicbrainz_album_id",
+  "musicbrainz_original_album_id",
+  "musicbrainz_recording_id",
+  "musicbrainz_track_id",
+  "musicbrainz_disc_id",
+  "musicbrainz_release_group_id",
+  "musicbrainz_work_id",
+
+  "ebur128_integrated_loudness_lufs",
+  "ebur128_loudness_range_lu",
+};
+
+constexpr int kRowIdColumnCount = static_cast<int>(std::size(kRowIdColumnNames));
+
+constexpr bool ColumnNameEquals(const char *a, const char *b) {
+
+  while (*a != '\0' && *a == *b) {
+    ++a;
+    ++b;
+  }
+
+  return *a == *b;
+
+}
+
+// Deliberately not constexpr: reaching it while evaluating a column ordinal fails the build.
+int UnknownColumn() { return -1; }
+
+constexpr int RowIdColumnOrdinal(const char *name) {
+
+  for (int i = 0; i < kRowIdColumnCount; ++i) {
+    if (ColumnNameEquals(kRowIdColumnNames[i], name)) return i;
+  }
+
+  return UnknownColumn();
+
+}
+
+QStringList RowIdColumnList(const int first) {
+
+  QStringList columns;
+  columns.reserve(kRowIdColumnCount - first);
+  for (int i = first; i < kRowIdColumnCount; ++i) {
+    columns << QString::fromLatin1(kRowIdColumnNames[i]);
+  }
+
+  return columns;
+
+}
+
+constexpr int kColRowId = RowIdColumnOrdinal("ROWID");
+constexpr int kColTitle = RowIdColumnOrdinal("title");
+constexpr int kColTitlesort = RowIdColumnOrdinal("titlesort");
+constexpr int kColAlbum = RowIdColumnOrdinal("album");
+constexpr int kColAlbumsort = RowIdColumnOrdinal("albumsort");
+constexpr int kColArtist = RowIdColumnOrdinal("artist");
+constexpr int kColArtistsort = RowIdColumnOrdinal("artistsort");
+constexpr int kColAlbumartist = RowIdColumnOrdinal("albumartist");
+constexpr int kColAlbumartistsort = RowIdColumnOrdinal("albumartistsort");
+constexpr int kColTrack = RowIdColumnOrdinal("track");
+constexpr int kColDisc = RowIdColumnOrdinal("disc");
+constexpr int kColYear = RowIdColumnOrdinal("year");
+constexpr int kColOriginalyear = RowIdColumnOrdinal("originalyear");
+constexpr int kColGenre = RowIdColumnOrdinal("genre");
+constexpr int kColCompilation = RowIdColumnOrdinal("compilation");
+constexpr int kColComposer = RowIdColumnOrdinal("composer");
+constexpr int kColComposersort = RowIdColumnOrdinal("composersort");
+constexpr int kColPerformer = RowIdColumnOrdinal("performer");
+constexpr int kColPerformersort = RowIdColumnOrdinal("performersort");
+constexpr int kColGrouping = RowIdColumnOrdinal("grouping");
+constexpr int kColComment = RowIdColumnOrdinal("comment");
+constexpr int kColLyrics = RowIdColumnOrdinal("lyrics");
+constexpr int kColArtistId = RowIdColumnOrdinal("artist_id");
+constexpr int kColAlbumId = RowIdColumnOrdinal("album_id");
+constexpr int kColSongId = RowIdColumnOrdinal("song_id");
+constexpr int kColBeginning = RowIdColumnOrdinal("beginning");
+constexpr int kColLength = RowIdColumnOrdinal("length");
+constexpr int kColBitrate = RowIdColumnOrdinal("bitrate");
+constexpr int kColSamplerate = RowIdColumnOrdinal("samplerate");
+constexpr int kColBitdepth = RowIdColumnOrdinal("bitdepth");
+constexpr int kColSource = RowIdColumnOrdinal("source");
+constexpr int kColDirectoryId = RowIdColumnOrdinal("directory_id");
+constexpr int kColUrl = RowIdColumnOrdinal("url");
+constexpr int kColFiletype = RowIdColumnOrdinal("filetype");
+constexpr int kColFilesize = RowIdColumnOrdinal("filesize");
+constexpr int kColMtime = RowIdColumnOrdinal("mtime");
+constexpr int kColCtime = RowIdColumnOrdinal("ctime");
+constexpr int kColUnavailable = RowIdColumnOrdinal("unavailable");
+constexpr int kColFingerprint = RowIdColumnOrdinal("fingerprint");
+constexpr int kColPlaycount = RowIdColumnOrdinal("playcount");
+constexpr int kColSkipcount = RowIdColumnOrdinal("skipcount");
+constexpr int kColLastplayed = RowIdColumnOrdinal("lastplayed");
+constexpr int kColLastseen = RowIdColumnOrdinal("lastseen");
+constexpr int kColCompilationDetected = RowIdColumnOrdinal("compilation_detected");
+constexpr int kColCompilationOn = RowIdColumnOrdinal("compilation_on");
+constexpr int kColCompilationOff = RowIdColumnOrdinal("compilation_off");
+constexpr int kColArtEmbedded = RowIdColumnOrdinal("art_embedded");
+constexpr int kColArtAutomatic = RowIdColumnOrdinal("art_automatic");
+constexpr int kColArtManual = RowIdColumnOrdinal("art_manual");
+constexpr int kColArtUnset = RowIdColumnOrdinal("art_unset");
+constexpr int kColCuePath = RowIdColumnOrdinal("cue_path");
+constexpr int kColRating = RowIdColumnOrdinal("rating");
+constexpr int kColBpm = RowIdColumnOrdinal("bpm");
+constexpr int kColMood = RowIdColumnOrdinal("mood");
+constexpr int kColInitialKey = RowIdColumnOrdinal("initial_key");
+constexpr int kColAcoustidId = RowIdColumnOrdinal("acoustid_id");
+constexpr int kColAcoustidFingerprint = RowIdColumnOrdinal("acoustid_fingerprint");
+constexpr int kColMusicbrainzAlbumArtistId = RowIdColumnOrdinal("musicbrainz_album_artist_id");
+constexpr int kColMusicbrainzArtistId = RowIdColumnOrdinal("musicbrainz_artist_id");
+constexpr int kColMusicbrainzOriginalArtistId = RowIdColumnOrdinal("musicbrainz_original_artist_id");
+constexpr int kColMusicbrainzAlbumId = RowIdColumnOrdinal("musicbrainz_album_id");
+constexpr int kColMusicbrainzOriginalAlbumId = RowIdColumnOrdinal("musicbrainz_original_album_id");
+constexpr int kColMusicbrainzRecordingId = RowIdColumnOrdinal("musicbrainz_recording_id");
+constexpr int kColMusicbrainzTrackId = RowIdColumnOrdinal("musicbrainz_track_id");
+constexpr int kColMusicbrainzDiscId = RowIdColumnOrdinal("musicbrainz_disc_id");
+constexpr int kColMusicbrainzReleaseGroupId = RowIdColumnOrdinal("musicbrainz_release_group_id");
+constexpr int kColMusicbrainzWorkId = RowIdColumnOrdinal("musicbrainz_work_id");
+constexpr int kColEbur128IntegratedLoudnessLufs = RowIdColumnOrdinal("ebur128_integrated_loudness_lufs");
+constexpr int kColEbur128LoudnessRangeLu = RowIdColumnOrdinal("ebur128_loudness_range_lu");
+
+// Typed conversions of a single column value, NULL columns are read as unset values.
+
+QString ColumnToString(const QVariant &value) {
+  return value.isNull() ? QString() : value.toString();
+}
+
+int ColumnToInt(const QVariant &value) {
+  return value.isNull() ? -1 : value.toInt();
+}
+
+uint ColumnToUInt(const QVariant &value) {
+  return value.isNull() || value.toInt() < 0 ? 0 : value.toUInt();
+}
+
+qint64 ColumnToLongLong(const QVariant &value) {
+  return value.isNull() ? -1 : value.toLongLong();
+}
+
+float ColumnToFloat(const QVariant &value) {
+  return value.isNull() ? -1.0F : value.toFloat();
+}
+
+bool ColumnToBool(const QVariant &value) {
+  return !value.isNull() && value.toInt() == 1;
+}
+
+}  // namespace
+
+const QStringList Song::kColumns = RowIdColumnList(1);
+
+const QStringList Song::kRowIdColumns = RowIdColumnList(0);
 
 const QString Song::kColumnSpec = kColumns.join(", "_L1);
 const QString Song::kRowIdColumnSpec = kRowIdColumns.join(", "_L1);
@@ -833,12 +977,6 @@ bool Song::save_embedded_cover_supported(const FileType filetype) {
 
 }
 
-int Song::ColumnIndex(const QString &field) {
-
-  return static_cast<int>(kRowIdColumns.indexOf(field));
-
-}
-
 QString Song::JoinSpec(const QString &table) {
   return Utilities::Prepend(table + QLatin1Char('.'), kRowIdColumns).join(", "_L1);
 }
@@ -1532,90 +1670,97 @@ void Song::Init(const QString &title, const QString &artist, const QString &albu
 
 }
 
-void Song::InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, const int col) {
-
-  Q_ASSERT(kRowIdColumns.count() + col <= r.count());
-
-  d->id_ = SqlHelper::ValueToInt(r, ColumnIndex(u"ROWID"_s) + col);
-
-  set_title(SqlHelper::ValueToString(r, ColumnIndex(u"title"_s) + col));
-  set_titlesort(SqlHelper::ValueToString(r, ColumnIndex(u"titlesort"_s) + col));
-  set_album(SqlHelper::ValueToString(r, ColumnIndex(u"album"_s) + col));
-  set_albumsort(SqlHelper::ValueToString(r, ColumnIndex(u"albumsort"_s) + col));
-  set_artist(SqlHelper::ValueToString(r, ColumnIndex(u"artist"_s) + col));
-  set_artistsort(SqlHelper::ValueToString(r, ColumnIndex(u"artistsort"_s) + col));
-  set_albumartist(SqlHelper::ValueToString(r, ColumnIndex(u"albumartist"_s) + col));
-  set_albumartistsort(SqlHelper::ValueToString(r, ColumnIndex(u"albumartistsort"_s) + col));
-  d->track_ = SqlHelper::ValueToInt(r, ColumnIndex(u"track"_s) + col);
-  d->disc_ = SqlHelper::ValueToInt(r, ColumnIndex(u"disc"_s) + col);
-  d->year_ = SqlHelper::ValueToInt(r, ColumnIndex(u"year"_s) + col);
-  d->originalyear_ = SqlHelper::ValueToInt(r, ColumnIndex(u"originalyear"_s) + col);
-  d->genre_ = SqlHelper::ValueToString(r, ColumnIndex(u"genre"_s) + col);
-  d->compilation_ = r.value(ColumnIndex(u"compilation"_s) + col).toBool();
-  d->composer_ = SqlHelper::ValueToString(r, ColumnIndex(u"composer"_s) + col);
-  d->composersort_ = SqlHelper::ValueToString(r, ColumnIndex(u"composersort"_s) + col);
-  d->performer_ = SqlHelper::ValueToString(r, ColumnIndex(u"performer"_s) + col);
-  d->performersort_ = SqlHelper::ValueToString(r, ColumnIndex(u"performersort"_s) + col);
-  d->grouping_ = SqlHelper::ValueToString(r, ColumnIndex(u"grouping"_s) + col);
-  d->comment_ = SqlHelper::ValueToString(r, ColumnIndex(u"comment"_s) + col);
-  d->lyrics_ = SqlHelper::ValueToString(r, ColumnIndex(u"lyrics"_s) + col);
-  d->artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"artist_id"_s) + col);
-  d->album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"album_id"_s) + col);
-  d->song_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"song_id"_s) + col);
-  d->beginning_ = r.value(ColumnIndex(u"beginning"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"beginning"_s) + col).toLongLong();
-  set_length_nanosec(SqlHelper::ValueToLongLong(r, ColumnIndex(u"length"_s) + col));
-  d->bitrate_ = SqlHelper::ValueToInt(r, ColumnIndex(u"bitrate"_s) + col);
-  d->samplerate_ = SqlHelper::ValueToInt(r, ColumnIndex(u"samplerate"_s) + col);
-  d->bitdepth_ = SqlHelper::ValueToInt(r, ColumnIndex(u"bitdepth"_s) + col);
-  if (!r.value(ColumnIndex(u"ebur128_integrated_loudness_lufs"_s) + col).isNull()) {
-    d->ebur128_integrated_loudness_lufs_ = r.value(ColumnIndex(u"ebur128_integrated_loudness_lufs"_s) + col).toDouble();
+template<typename T>
+void Song::InitFromRow(const T &row, const bool reliable_metadata, const int col) {
+
+  // Reads every column once by its compile-time ordinal, without going through a QSqlRecord.
+  auto value = [&row, col](const int ordinal) { return row.value(col + ordinal); };
+
+  d->id_ = ColumnToInt(value(kColRowId));
+
+  set_title(ColumnToString(value(kColTitle)));
+  set_titlesort(ColumnToString(value(kColTitlesort)));
+  set_album(ColumnToString(value(kColAlbum)));
+  set_albumsort(ColumnToString(value(kColAlbumsort)));
+  set_artist(ColumnToString(value(kColArtist)));
+  set_artistsort(ColumnToString(value(kColArtistsort)));
+  set_albumartist(ColumnToString(value(kColAlbumartist)));
+  set_albumartistsort(ColumnToString(value(kColAlbumartistsort)));
+  d->track_ = ColumnToInt(value(kColTrack));
+  d->disc_ = ColumnToInt(value(kColDisc));
+  d->year_ = ColumnToInt(value(kColYear));
+  d->originalyear_ = ColumnToInt(value(kColOriginalyear));
+  d->genre_ = ColumnToString(value(kColGenre));
+  d->compilation_ = value(kColCompilation).toBool();
+  d->composer_ = ColumnToString(value(kColComposer));
+  d->composersort_ = ColumnToString(value(kColComposersort));
+  d->performer_ = ColumnToString(value(kColPerformer));
+  d->performersort_ = ColumnToString(value(kColPerformersort));
+  d->grouping_ = ColumnToString(value(kColGrouping));
+  d->comment_ = ColumnToString(value(kColComment));
+  d->lyrics_ = ColumnToString(value(kColLyrics));
+  d->artist_id_ = ColumnToString(value(kColArtistId));
+  d->album_id_ = ColumnToString(value(kColAlbumId));
+  d->song_id_ = ColumnToString(value(kColSongId));
+  const QVariant beginning = value(kColBeginning);
+  d->beginning_ = beginning.isNull() ? 0 : beginning.toLongLong();
+  set_length_nanosec(ColumnToLongLong(value(kColLength)));
+  d->bitrate_ = ColumnToInt(value(kColBitrate));
+  d->samplerate_ = ColumnToInt(value(kColSamplerate));
+  d->bitdepth_ = ColumnToInt(value(kColBitdepth));
+  const QVariant ebur128_integrated_loudness_lufs = value(kColEbur128IntegratedLoudnessLufs);
+  if (!ebur128_integrated_loudness_lufs.isNull()) {
+    d->ebur128_integrated_loudness_lufs_ = ebur128_integrated_loudness_lufs.toDouble();
   }
-  if (!r.value(ColumnIndex(u"ebur128_loudness_range_lu"_s) + col).isNull()) {
-    d->ebur128_loudness_range_lu_ = r.value(ColumnIndex(u"ebur128_loudness_range_lu"_s) + col).toDouble();
+  const QVariant ebur128_loudness_range_lu = value(kColEbur128LoudnessRangeLu);
+  if (!ebur128_loudness_range_lu.isNull()) {
+    d->ebur128_loudness_range_lu_ = ebur128_loudness_range_lu.toDouble();
   }
-  d->source_ = static_cast<Source>(r.value(ColumnIndex(u"source"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"source"_s) + col).toInt());
-  d->directory_id_ = SqlHelper::ValueToInt(r, ColumnIndex(u"directory_id"_s) + col);
-  set_url(QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"url"_s) + col).toUtf8()));
+  const QVariant source = value(kColSource);
+  d->source_ = static_cast<Source>(source.isNull() ? 0 : source.toInt());
+  d->directory_id_ = ColumnToInt(value(kColDirectoryId));
+  set_url(QUrl::fromEncoded(ColumnToString(value(kColUrl)).toUtf8()));
   d->basefilename_ = QFileInfo(d->url_.toLocalFile()).fileName();
-  d->filetype_ = FileType(r.value(ColumnIndex(u"filetype"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"filetype"_s) + col).toInt());
-  d->filesize_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"filesize"_s) + col);
-  d->mtime_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"mtime"_s) + col);
-  d->ctime_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"ctime"_s) + col);
-  d->unavailable_ = r.value(ColumnIndex(u"unavailable"_s) + col).toBool();
-  d->fingerprint_ = SqlHelper::ValueToString(r, ColumnIndex(u"fingerprint"_s) + col);
-  d->playcount_ = SqlHelper::ValueToUInt(r, ColumnIndex(u"playcount"_s) + col);
-  d->skipcount_ = SqlHelper::ValueToUInt(r, ColumnIndex(u"skipcount"_s) + col);
-  d->lastplayed_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"lastplayed"_s) + col);
-  d->lastseen_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"lastseen"_s) + col);
-  d->compilation_detected_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_detected"_s) + col);
-  d->compilation_on_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_on"_s) + col);
-  d->compilation_off_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_off"_s) + col);
-
-  d->art_embedded_ = SqlHelper::ValueToBool(r, ColumnIndex(u"art_embedded"_s) + col);
-  d->art_automatic_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"art_automatic"_s) + col).toUtf8());
-  d->art_manual_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"art_manual"_s) + col).toUtf8());
-  d->art_unset_ = SqlHelper::ValueToBool(r, ColumnIndex(u"art_unset"_s) + col);
-
-  d->cue_path_ = SqlHelper::ValueToString(r, ColumnIndex(u"cue_path"_s) + col);
-
-  d->rating_ = SqlHelper::ValueToFloat(r, ColumnIndex(u"rating"_s) + col);
-  d->bpm_ = SqlHelper::ValueToFloat(r, ColumnIndex(u"bpm"_s) + col);
-  d->mood_ = SqlHelper::ValueToString(r, ColumnIndex(u"mood"_s) + col);
-  d->initial_key_ = SqlHelper::ValueToString(r, ColumnIndex(u"initial_key"_s) + col);
-
-  d->acoustid_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"acoustid_id"_s) + col);
-  d->acoustid_fingerprint_ = SqlHelper::ValueToString(r, ColumnIndex(u"acoustid_fingerprint"_s) + col);
-
-  d->musicbrainz_album_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_album_artist_id"_s) + col);
-  d->musicbrainz_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_artist_id"_s) + col);
-  d->musicbrainz_original_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_original_artist_id"_s) + col);
-  d->musicbrainz_album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_album_id"_s) + col);
-  d->musicbrainz_original_album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_original_album_id"_s) + col);
-  d->musicbrainz_recording_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_recording_id"_s) + col);
-  d->musicbrainz_track_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_track_id"_s) + col);
-  d->musicbrainz_disc_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_disc_id"_s) + col);
-  d->musicbrainz_release_group_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_release_group_id"_s) + col);
-  d->musicbrainz_work_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_work_id"_s) + col);
+  const QVariant filetype = value(kColFiletype);
+  d->filetype_ = FileType(filetype.isNull() ? 0 : filetype.toInt());
+  d->filesize_ = ColumnToLongLong(value(kColFilesize));
+  d->mtime_ = ColumnToLongLong(value(kColMtime));
+  d->ctime_ = ColumnToLongLong(value(kColCtime));
+  d->unavailable_ = value(kColUnavailable).toBool();
+  d->fingerprint_ = ColumnToString(value(kColFingerprint));
+  d->playcount_ = ColumnToUInt(value(kColPlaycount));
+  d->skipcount_ = ColumnToUInt(value(kColSkipcount));
+  d->lastplayed_ = ColumnToLongLong(value(kColLastplayed));
+  d->lastseen_ = ColumnToLongLong(value(kColLastseen));
+  d->compilation_detected_ = ColumnToBool(value(kColCompilationDetected));
+  d->compilation_on_ = ColumnToBool(value(kColCompilationOn));
+  d->compilation_off_ = ColumnToBool(value(kColCompilationOff));
+
+  d->art_embedded_ = ColumnToBool(value(kColArtEmbedded));
+  d->art_automatic_ = QUrl::fromEncoded(ColumnToString(value(kColArtAutomatic)).toUtf8());
+  d->art_manual_ = QUrl::fromEncoded(ColumnToString(value(kColArtManual)).toUtf8());
+  d->art_unset_ = ColumnToBool(value(kColArtUnset));
+
+  d->cue_path_ = ColumnToString(value(kColCuePath));
+
+  d->rating_ = ColumnToFloat(value(kColRating));
+  d->bpm_ = ColumnToFloat(value(kColBpm));
+  d->mood_ = ColumnToString(value(kColMood));
+  d->initial_key_ = ColumnToString(value(kColInitialKey));
+
+  d->acoustid_id_ = ColumnToString(value(kColAcoustidId));
+  d->acoustid_fingerprint_ = ColumnToString(value(kColAcoustidFingerprint));
+
+  d->musicbrainz_album_artist_id_ = ColumnToString(value(kColMusicbrainzAlbumArtistId));
+  d->musicbrainz_artist_id_ = ColumnToString(value(kColMusicbrainzArtistId));
+  d->musicbrainz_original_artist_id_ = ColumnToString(value(kColMusicbrainzOriginalArtistId));
+  d->musicbrainz_album_id_ = ColumnToString(value(kColMusicbrainzAlbumId));
+  d->musicbrainz_original_album_id_ = ColumnToString(value(kColMusicbrainzOriginalAlbumId));
+  d->musicbrainz_recording_id_ = ColumnToString(value(kColMusicbrainzRecordingId));
+  d->musicbrainz_track_id_ = ColumnToString(value(kColMusicbrainzTrackId));
+  d->musicbrainz_disc_id_ = ColumnToString(value(kColMusicbrainzDiscId));
+  d->musicbrainz_release_group_id_ = ColumnToString(value(kColMusicbrainzReleaseGroupId));
+  d->musicbrainz_work_id_ = ColumnToString(value(kColMusicbrainzWorkId));
 
   d->valid_ = true;
   d->init_from_file_ = reliable_metadata;
@@ -1624,15 +1769,27 @@ void Song::InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, cons
 
 }
 
+void Song::InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, const int col) {
+
+  Q_ASSERT(kRowIdColumnCount + col <= r.count());
+
+  InitFromRow(r, reliable_metadata, col);
+
+}
+
 void Song::InitFromQuery(const SqlQuery &query, const bool reliable_metadata, const int col) {
 
-  InitFromQuery(query.record(), reliable_metadata, col);
+  Q_ASSERT(kRowIdColumnCount + col <= query.columns());
+
+  InitFromRow(query, reliable_metadata, col);
 
 }
 
 void Song::InitFromQuery(const SqlRow &row, const bool reliable_metadata, const int col) {
 
-  InitFromQuery(row.record(), reliable_metadata, col);
+  Q_ASSERT(kRowIdColumnCount + col <= row.columns());
+
+  InitFromRow(row, reliable_metadata, col);
 
 }
 
@@ -1652,9 +1809,8 @@ void Song::InitArtManual() {
 
   // If we don't have cover art, check if we have one in the cache
   if (d->art_manual_.isEmpty() && !effective_albumartist().isEmpty() && !effective_album().isEmpty()) {
-    QString filename = QString::fromLatin1(CoverUtils::Sha1CoverHash(effective_albumartist(), effective_album()).toHex()) + u".jpg"_s;
-    QString path(ImageCacheDir(d->source_) + QLatin1Char('/') + filename);
-    if (QFile::exists(path)) {
+    const QString path = CoverCacheIndex::ManualCoverPath(d->source_, effective_albumartist(), effective_album());
+    if (!path.isEmpty()) {
       d->art_manual_ = QUrl::fromLocalFile(path);
     }
   }
@@ -1729,6 +1885,7 @@ void Song::InitFromItdb(Itdb_Track *track, const QString &prefix) {
       GError *error = nullptr;
       if (dir.exists() && gdk_pixbuf_save(pixbuf, cover_file.toUtf8().constData(), "jpeg", &error, nullptr)) {
         d->art_manual_ = QUrl::fromLocalFile(cover_file);
+        CoverCacheIndex::AddFile(cover_file);
       }
       g_object_unref(pixbuf);
     }
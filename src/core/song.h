@@ -440,7 +440,6 @@ class Song {
   static bool save_embedded_cover_supported(const FileType filetype);
   bool save_embedded_cover_supported() const { return url().isLocalFile() && save_embedded_cover_supported(filetype()) && !has_cue(); };
 
-  static int ColumnIndex(const QString &field);
   static QString JoinSpec(const QString &table);
 
   // Pretty accessors
@@ -563,6 +562,9 @@ class Song {
   }
 
  private:
+  template<typename T>
+  void InitFromRow(const T &row, const bool reliable_metadata, const int col);
+
   struct Private;
   QSharedDataPointer<Private> d;
 };
@@ -22,6 +22,7 @@
 #include "config.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <gst/gst.h>
 
@@ -33,11 +34,16 @@
 #include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
+#include <QList>
+#include <QHash>
 #include <QSet>
 #include <QTimer>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 #include <QEventLoop>
+#include <QFuture>
+#include <QtConcurrentRun>
 
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
@@ -60,6 +66,7 @@ using namespace Qt::Literals::StringLiterals;
 
 namespace {
 constexpr int kDefaultTimeout = 5000;
+constexpr qsizetype kMetadataLoadedBatchSize = 100;
 }
 
 QSet<QString> SongLoader::sRawUriSchemes;
@@ -330,20 +337,89 @@ SongLoader::Result SongLoader::LoadLocalAsync(const QString &filename) {
 
 void SongLoader::LoadMetadataBlocking() {
 
-  for (int i = 0; i < songs_.size(); i++) {
-    EffectiveSongLoad(&songs_[i]);
+  QList<qsizetype> indexes;
+  QList<QUrl> urls;
+  for (qsizetype i = 0; i < songs_.count(); ++i) {
+    if (NeedsEffectiveSongLoad(songs_[i])) {
+      indexes << i;
+      urls << songs_[i].url();
+    }
+  }
+
+  // First, get all songs we can from the collection at once.
+  if (!urls.isEmpty()) {
+    // Songs stored with a different encoding of the URL are found under every encoding, like GetSongByUrl() finds them.
+    QHash<QString, Song> collection_songs;
+    const SongList songs = collection_backend_->GetSongsByUrls(urls);
+    for (const Song &song : songs) {
+      if (song.beginning_nanosec() != 0) continue;
+      const QStringList encodings = CollectionBackend::UrlEncodings(song.url());
+      for (const QString &encoding : encodings) {
+        if (!collection_songs.contains(encoding)) {
+          collection_songs.insert(encoding, song);
+        }
+      }
+    }
+    QList<qsizetype> missing;
+    for (const qsizetype i : std::as_const(indexes)) {
+      Song collection_song;
+      const QStringList encodings = CollectionBackend::UrlEncodings(songs_[i].url());
+      for (const QString &encoding : encodings) {
+        collection_song = collection_songs.value(encoding);
+        if (collection_song.is_valid()) break;
+      }
+      if (collection_song.is_valid()) {
+        songs_[i] = collection_song;
+      }
+      else {
+        missing << i;
+      }
+    }
+    indexes = missing;
+  }
+
+  // Read the rest of the files on the thread pool.
+  Song *songs_data = songs_.data();
+  QHash<qsizetype, QFuture<void>> futures;
+  for (const qsizetype i : std::as_const(indexes)) {
+    futures.insert(i, QtConcurrent::run(&thread_pool_, [this, songs_data, i]() { ReadFileBlocking(&songs_data[i]); }));
+  }
+
+  // Report the songs in order as they are ready, without waiting for the files further down the list.
+  SongList songs_loaded;
+  for (qsizetype i = 0; i < songs_.count(); ++i) {
+    if (futures.contains(i)) {
+      QFuture<void> future = futures.value(i);
+      if (!future.isFinished() && !songs_loaded.isEmpty()) {
+        Q_EMIT MetadataLoaded(songs_loaded);
+        songs_loaded.clear();
+      }
+      future.waitForFinished();
+    }
+    songs_loaded << songs_[i];
+    if (songs_loaded.count() >= kMetadataLoadedBatchSize) {
+      Q_EMIT MetadataLoaded(songs_loaded);
+      songs_loaded.clear();
+    }
+  }
+  if (!songs_loaded.isEmpty()) {
+    Q_EMIT MetadataLoaded(songs_loaded);
   }
 
 }
 
-void SongLoader::EffectiveSongLoad(Song *song) {
+bool SongLoader::NeedsEffectiveSongLoad(const Song &song) {
 
-  if (!song || !song->url().isLocalFile()) return;
+  if (!song.url().isLocalFile()) return false;
 
-  if (song->init_from_file() && song->filetype() != Song::FileType::Unknown) {
-    // Maybe we loaded the metadata already, for example from a cuesheet.
-    return;
-  }
+  // Maybe we loaded the metadata already, for example from a cuesheet.
+  return !song.init_from_file() || song.filetype() == Song::FileType::Unknown;
+
+}
+
+void SongLoader::EffectiveSongLoad(Song *song) {
+
+  if (!song || !NeedsEffectiveSongLoad(*song)) return;
 
   // First, try to get the song from the collection
   Song collection_song = collection_backend_->GetSongByUrl(song->url());
@@ -352,11 +428,17 @@ void SongLoader::EffectiveSongLoad(Song *song) {
   }
   else {
     // It's a normal media file
-    const QString filename = song->url().toLocalFile();
-    const TagReaderResult result = tagreader_client_->ReadFileBlocking(filename, song);
-    if (!result.success()) {
-      qLog(Error) << "Could not read file" << song->url() << result.error_string();
-    }
+    ReadFileBlocking(song);
+  }
+
+}
+
+void SongLoader::ReadFileBlocking(Song *song) const {
+
+  const QString filename = song->url().toLocalFile();
+  const TagReaderResult result = tagreader_client_->ReadFileBlocking(filename, song);
+  if (!result.success()) {
+    qLog(Error) << "Could not read file" << song->url() << result.error_string();
   }
 
 }
@@ -83,6 +83,7 @@ class SongLoader : public QObject {
   // This method is blocking, do not call it from the UI thread.
   SongLoader::Result LoadFilenamesBlocking();
   // Completely load songs previously loaded with LoadFilenamesBlocking().
+  // The songs in the collection are looked up at once, the other files are read in parallel, MetadataLoaded() is emitted from the calling thread with the songs in order as they are loaded.
   // When finished, the Song objects in songs() contain metadata now. This method is blocking, do not call it from the UI thread.
   void LoadMetadataBlocking();
   Result LoadAudioCD();
@@ -90,6 +91,7 @@ class SongLoader : public QObject {
   QStringList errors() { return errors_; }
 
  Q_SIGNALS:
+  void MetadataLoaded(const SongList &songs);
   void AudioCDTracksLoaded();
   void AudioCDTracksUpdated();
   void AudioCDLoadingFinished(const bool success);
@@ -117,7 +119,9 @@ class SongLoader : public QObject {
 
   Result LoadLocal(const QString &filename);
   SongLoader::Result LoadLocalAsync(const QString &filename);
+  static bool NeedsEffectiveSongLoad(const Song &song);
   void EffectiveSongLoad(Song *song);
+  void ReadFileBlocking(Song *song) const;
   Result LoadLocalPartial(const QString &filename);
   void LoadLocalDirectory(const QString &filename);
   void LoadPlaylist(ParserBase *parser, const QString &filename);
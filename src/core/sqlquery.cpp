@@ -25,6 +25,7 @@
 #include <QUrl>
 
 #include "sqlquery.h"
+#include "tracing.h"
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -92,8 +93,13 @@ void SqlQuery::BindNotNullIntValue(const QString &placeholder, const int value)
 
 bool SqlQuery::Exec() {
 
-  bool success = exec();
+  bool success = false;
+  {
+    TRACE_SCOPE("database", "Query");
+    success = exec();
+  }
   last_query_ = executedQuery();
+  columns_ = success ? QSqlQuery::record().count() : -1;
 
   for (QMap<QString, QVariant>::const_iterator it = bound_values_.constBegin(); it != bound_values_.constEnd(); ++it) {
     last_query_.replace(it.key(), it.value().toString());
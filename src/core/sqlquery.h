@@ -34,9 +34,10 @@
 class SqlQuery : public QSqlQuery {
 
  public:
-  explicit SqlQuery(const QSqlDatabase &db) : QSqlQuery(db) {}
+  explicit SqlQuery(const QSqlDatabase &db) : QSqlQuery(db), columns_(-1) {}
 
-  int columns() const { return QSqlQuery::record().count(); }
+  // The column count is cached by Exec(), QSqlQuery::record() copies the whole record with the values of the current row.
+  int columns() const { return columns_ >= 0 ? columns_ : QSqlQuery::record().count(); }
 
   void BindValue(const QString &placeholder, const QVariant &value);
   void BindStringValue(const QString &placeholder, const QString &value);
@@ -55,6 +56,7 @@ class SqlQuery : public QSqlQuery {
  private:
   QMap<QString, QVariant> bound_values_;
   QString last_query_;
+  int columns_;
 };
 
 #endif  // SQLQUERY_H
@@ -20,7 +20,7 @@
 #include "config.h"
 
 #include <QVariant>
-#include <QSqlRecord>
+#include <QVariantList>
 
 #include "sqlrow.h"
 
@@ -28,14 +28,18 @@ SqlRow::SqlRow(const SqlQuery &query) { Init(query); }
 
 void SqlRow::Init(const SqlQuery &query) {
 
-  record_ = query.record();
+  const int columns = query.columns();
+  values_.reserve(columns);
+  for (int i = 0; i < columns; ++i) {
+    values_ << query.value(i);
+  }
 
 }
 
 QVariant SqlRow::value(const int n) const {
 
-  Q_ASSERT(n < record_.count());
+  Q_ASSERT(n < values_.count());
 
-  return record_.value(n);
+  return values_.value(n);
 
 }
@@ -24,7 +24,7 @@
 
 #include <QList>
 #include <QVariant>
-#include <QSqlRecord>
+#include <QVariantList>
 
 #include "sqlquery.h"
 
@@ -33,14 +33,14 @@ class SqlRow {
  public:
   explicit SqlRow(const SqlQuery &query);
 
-  int columns() const { return record_.count(); }
-  const QSqlRecord &record() const { return record_; }
+  int columns() const { return static_cast<int>(values_.count()); }
   QVariant value(const int n) const;
 
  private:
   void Init(const SqlQuery &query);
 
-  QSqlRecord record_;
+  // Only the values are kept, a QSqlRecord would also copy the field names and types for every row.
+  QVariantList values_;
 };
 
 using SqlRowList = QList<SqlRow>;
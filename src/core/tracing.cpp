@@ -0,0 +1,349 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QList>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QByteArray>
+#include <QString>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "logging.h"
+#include "tracing.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace tracing {
+
+std::atomic<bool> sEnabled(false);
+
+namespace {
+
+// Stop recording events after this many, the summary still includes everything.
+constexpr qsizetype kMaxEvents = 2000000;
+
+constexpr int kStallCheckIntervalMsec = 50;
+constexpr qint64 kStallThresholdMsec = 100;
+
+struct Event {
+  char phase;
+  const char *category;
+  const char *name;
+  qint64 timestamp_usec;
+  qint64 value;  // Duration for complete events, the value for counters.
+  quint64 thread_id;
+};
+
+struct DurationStats {
+  qint64 count = 0;
+  qint64 total_usec = 0;
+  qint64 max_usec = 0;
+};
+
+struct CounterStats {
+  qint64 value = 0;
+  qint64 max = 0;
+};
+
+using Key = QPair<const char*, const char*>;
+
+struct State {
+  QString trace_filename;
+  bool print_summary = false;
+  std::chrono::steady_clock::time_point start_time;
+
+  QMutex mutex;
+  QList<Event> events;
+  qint64 dropped_events = 0;
+  QHash<Key, DurationStats> durations;
+  QHash<Key, CounterStats> counters;
+  QHash<quint64, QString> thread_names;
+};
+
+State *sState = nullptr;
+std::atomic<quint64> sNextThreadId(1);
+thread_local quint64 sThreadId = 0;
+
+QString KeyName(const Key &key) {
+  return QString::fromLatin1(key.first) + QLatin1Char('/') + QString::fromLatin1(key.second);
+}
+
+// Call with the mutex locked.
+quint64 CurrentThreadId() {
+
+  if (sThreadId == 0) {
+    sThreadId = sNextThreadId++;
+    QString thread_name = QThread::currentThread()->objectName();
+    if (thread_name.isEmpty()) thread_name = u"Thread %1"_s.arg(sThreadId);
+    sState->thread_names.insert(sThreadId, thread_name);
+  }
+
+  return sThreadId;
+
+}
+
+// Call with the mutex locked.
+void AddEvent(const char phase, const char *category, const char *name, const qint64 timestamp_usec, const qint64 value) {
+
+  if (sState->events.count() >= kMaxEvents) {
+    ++sState->dropped_events;
+    return;
+  }
+
+  sState->events.append(Event{ phase, category, name, timestamp_usec, value, CurrentThreadId() });
+
+}
+
+bool WriteTrace(const QString &filename) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qLog(Error) << "Could not open trace file" << filename << "for writing:" << file.errorString();
+    return false;
+  }
+
+  const qint64 pid = QCoreApplication::applicationPid();
+  bool first = true;
+  const auto write_event = [&file, &first](const QJsonObject &object) {
+    file.write(first ? "\n" : ",\n");
+    file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    first = false;
+  };
+
+  file.write("{\"traceEvents\":[");
+
+  for (QHash<quint64, QString>::const_iterator it = sState->thread_names.constBegin(); it != sState->thread_names.constEnd(); ++it) {
+    write_event(QJsonObject{ { u"name"_s, u"thread_name"_s }, { u"ph"_s, u"M"_s }, { u"pid"_s, pid }, { u"tid"_s, static_cast<qint64>(it.key()) }, { u"args"_s, QJsonObject{ { u"name"_s, it.value() } } } });
+  }
+
+  for (const Event &event : std::as_const(sState->events)) {
+    QJsonObject object{ { u"cat"_s, QString::fromLatin1(event.category) },
+                        { u"name"_s, QString::fromLatin1(event.name) },
+                        { u"ph"_s, QString(QLatin1Char(event.phase)) },
+                        { u"ts"_s, event.timestamp_usec },
+                        { u"pid"_s, pid },
+                        { u"tid"_s, static_cast<qint64>(event.thread_id) } };
+    switch (event.phase) {
+      case 'X':
+        object.insert(u"dur"_s, event.value);
+        break;
+      case 'C':
+        object.insert(u"args"_s, QJsonObject{ { QString::fromLatin1(event.name), event.value } });
+        break;
+      case 'i':
+        object.insert(u"s"_s, u"t"_s);
+        break;
+      default:
+        break;
+    }
+    write_event(object);
+  }
+
+  file.write("\n],\"displayTimeUnit\":\"ms\"}\n");
+  file.close();
+
+  return file.error() == QFile::NoError;
+
+}
+
+}  // namespace
+
+void Init(const QString &trace_filename, const bool print_summary) {
+
+  if (sState) return;
+
+  sState = new State;
+  sState->trace_filename = trace_filename;
+  sState->print_summary = print_summary;
+  sState->start_time = std::chrono::steady_clock::now();
+
+  sEnabled = true;
+
+}
+
+void StartStallDetector() {
+
+  if (!IsEnabled()) return;
+
+  // The timer fires late when the event loop is blocked, the delay is how long the GUI thread stalled.
+  QTimer *timer = new QTimer(QCoreApplication::instance());
+  timer->setInterval(kStallCheckIntervalMsec);
+  QElapsedTimer *elapsed_timer = new QElapsedTimer;
+  elapsed_timer->start();
+  QObject::connect(timer, &QTimer::timeout, timer, [elapsed_timer]() {
+    const qint64 elapsed_msec = elapsed_timer->restart();
+    if (elapsed_msec >= kStallCheckIntervalMsec + kStallThresholdMsec) {
+      const qint64 stall_usec = (elapsed_msec - kStallCheckIntervalMsec) * 1000;
+      AddDuration("gui", "Stall", NowUsec() - stall_usec, stall_usec);
+      IncrementCounter("gui", "Stalls");
+    }
+  });
+  QObject::connect(timer, &QObject::destroyed, timer, [elapsed_timer]() { delete elapsed_timer; });
+  timer->start();
+
+}
+
+void Shutdown() {
+
+  if (!sState) return;
+
+  sEnabled = false;
+
+  QMutexLocker l(&sState->mutex);
+
+  if (sState->dropped_events > 0) {
+    qLog(Warning) << "Dropped" << sState->dropped_events << "trace events";
+  }
+
+  if (!sState->trace_filename.isEmpty() && WriteTrace(sState->trace_filename)) {
+    qLog(Info) << "Wrote" << sState->events.count() << "trace events to" << sState->trace_filename;
+  }
+
+  if (sState->print_summary) {
+    l.unlock();
+    std::cout << Summary().toLocal8Bit().constData() << std::flush;
+  }
+
+}
+
+qint64 NowUsec() {
+
+  if (!sState) return 0;
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sState->start_time).count();
+
+}
+
+void AddDuration(const char *category, const char *name, const qint64 start_usec, const qint64 duration_usec) {
+
+  if (!IsEnabled()) return;
+
+  QMutexLocker l(&sState->mutex);
+
+  DurationStats &stats = sState->durations[Key(category, name)];
+  ++stats.count;
+  stats.total_usec += duration_usec;
+  stats.max_usec = qMax(stats.max_usec, duration_usec);
+
+  AddEvent('X', category, name, start_usec, duration_usec);
+
+}
+
+void AddInstant(const char *category, const char *name) {
+
+  if (!IsEnabled()) return;
+
+  const qint64 timestamp_usec = NowUsec();
+
+  QMutexLocker l(&sState->mutex);
+  AddEvent('i', category, name, timestamp_usec, 0);
+
+}
+
+void SetCounter(const char *category, const char *name, const qint64 value) {
+
+  if (!IsEnabled()) return;
+
+  const qint64 timestamp_usec = NowUsec();
+
+  QMutexLocker l(&sState->mutex);
+
+  CounterStats &stats = sState->counters[Key(category, name)];
+  stats.value = value;
+  stats.max = qMax(stats.max, value);
+
+  AddEvent('C', category, name, timestamp_usec, value);
+
+}
+
+void IncrementCounter(const char *category, const char *name, const qint64 value) {
+
+  if (!IsEnabled()) return;
+
+  const qint64 timestamp_usec = NowUsec();
+
+  QMutexLocker l(&sState->mutex);
+
+  CounterStats &stats = sState->counters[Key(category, name)];
+  stats.value += value;
+  stats.max = qMax(stats.max, stats.value);
+
+  AddEvent('C', category, name, timestamp_usec, stats.value);
+
+}
+
+QString Summary() {
+
+  if (!sState) return QString();
+
+  QMutexLocker l(&sState->mutex);
+
+  // The same literal can have different addresses in different translation units, so merge by name.
+  QMap<QString, DurationStats> durations;
+  for (QHash<Key, DurationStats>::const_iterator it = sState->durations.constBegin(); it != sState->durations.constEnd(); ++it) {
+    DurationStats &stats = durations[KeyName(it.key())];
+    stats.count += it.value().count;
+    stats.total_usec += it.value().total_usec;
+    stats.max_usec = qMax(stats.max_usec, it.value().max_usec);
+  }
+
+  QMap<QString, CounterStats> counters;
+  for (QHash<Key, CounterStats>::const_iterator it = sState->counters.constBegin(); it != sState->counters.constEnd(); ++it) {
+    CounterStats &stats = counters[KeyName(it.key())];
+    stats.value += it.value().value;
+    stats.max = qMax(stats.max, it.value().max);
+  }
+
+  QString summary = u"Durations: count, total ms, average ms, max ms\n"_s;
+  for (QMap<QString, DurationStats>::const_iterator it = durations.constBegin(); it != durations.constEnd(); ++it) {
+    const DurationStats &stats = it.value();
+    summary += u"  %1: %2, %3, %4, %5\n"_s.arg(it.key())
+                                           .arg(stats.count)
+                                           .arg(static_cast<double>(stats.total_usec) / 1000.0, 0, 'f', 1)
+                                           .arg(static_cast<double>(stats.total_usec) / 1000.0 / static_cast<double>(qMax(stats.count, 1LL)), 0, 'f', 2)
+                                           .arg(static_cast<double>(stats.max_usec) / 1000.0, 0, 'f', 1);
+  }
+
+  summary += u"Counters: last, max\n"_s;
+  for (QMap<QString, CounterStats>::const_iterator it = counters.constBegin(); it != counters.constEnd(); ++it) {
+    summary += u"  %1: %2, %3\n"_s.arg(it.key()).arg(it.value().value).arg(it.value().max);
+  }
+
+  return summary;
+
+}
+
+}  // namespace tracing
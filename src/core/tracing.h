@@ -0,0 +1,100 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <atomic>
+
+#include <QtGlobal>
+#include <QString>
+
+// Records how long hot paths take, for finding stalls.
+// Nothing is recorded unless tracing was enabled with --trace or --stats, a disabled scope only costs an atomic load.
+// Categories and names must be string literals, they are stored as pointers.
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) tracing::ScopedTimer TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+
+namespace tracing {
+
+extern std::atomic<bool> sEnabled;
+
+inline bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+// Enables tracing.  The events are written as a Chrome trace event JSON file to trace_filename when shutting down,
+// if print_summary is true, a summary of the durations and counters is printed.
+void Init(const QString &trace_filename, const bool print_summary);
+
+// Records the time the GUI thread doesn't process events.  Call from the GUI thread after the application is created.
+void StartStallDetector();
+
+void Shutdown();
+
+// Microseconds since tracing was enabled.
+qint64 NowUsec();
+
+void AddDuration(const char *category, const char *name, const qint64 start_usec, const qint64 duration_usec);
+void AddInstant(const char *category, const char *name);
+void SetCounter(const char *category, const char *name, const qint64 value);
+void IncrementCounter(const char *category, const char *name, const qint64 value = 1);
+
+QString Summary();
+
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const char *category, const char *name) : category_(category), name_(name), start_usec_(IsEnabled() ? NowUsec() : -1) {}
+  ~ScopedTimer() {
+    if (start_usec_ >= 0) AddDuration(category_, name_, start_usec_, NowUsec() - start_usec_);
+  }
+
+ private:
+  Q_DISABLE_COPY(ScopedTimer)
+
+  const char *category_;
+  const char *name_;
+  const qint64 start_usec_;
+};
+
+// Locks like QMutexLocker, and records the time spent waiting when the mutex was already locked.
+template<typename T>
+class MutexLocker {
+ public:
+  explicit MutexLocker(T *mutex, const char *category, const char *name) : mutex_(mutex) {
+    if (!IsEnabled()) {
+      mutex_->lock();
+    }
+    else if (!mutex_->tryLock()) {
+      const qint64 start_usec = NowUsec();
+      mutex_->lock();
+      AddDuration(category, name, start_usec, NowUsec() - start_usec);
+    }
+  }
+  ~MutexLocker() { mutex_->unlock(); }
+
+ private:
+  Q_DISABLE_COPY(MutexLocker)
+
+  T *mutex_;
+};
+
+}  // namespace tracing
+
+#endif  // TRACING_H
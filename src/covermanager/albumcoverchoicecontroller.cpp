@@ -79,6 +79,7 @@
 #include "albumcoverimageresult.h"
 #include "coverfromurldialog.h"
 #include "currentalbumcoverloader.h"
+#include "covercacheindex.h"
 
 using std::make_shared;
 using namespace Qt::Literals::StringLiterals;
@@ -402,6 +403,7 @@ bool AlbumCoverChoiceController::DeleteCover(Song *song, const bool unset) {
     QFile file(art_manual);
     if (file.exists()) {
       if (file.remove()) {
+        CoverCacheIndex::RemoveFile(art_manual);
         song->clear_art_manual();
       }
       else {
@@ -685,6 +687,7 @@ QUrl AlbumCoverChoiceController::SaveCoverToFileAutomatic(const Song::Source sou
     if (file.open(QIODevice::WriteOnly)) {
       if (file.write(result.image_data) > 0) {
         file.close();
+        CoverCacheIndex::AddFile(filepath);
         return QUrl::fromLocalFile(filepath);
       }
       else {
@@ -700,6 +703,7 @@ QUrl AlbumCoverChoiceController::SaveCoverToFileAutomatic(const Song::Source sou
   }
   else {
     if (result.image.save(filepath, "JPG")) {
+      CoverCacheIndex::AddFile(filepath);
       return QUrl::fromLocalFile(filepath);
     }
   }
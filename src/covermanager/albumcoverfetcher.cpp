@@ -38,6 +38,8 @@ using namespace std::chrono_literals;
 
 namespace {
 constexpr int kMaxConcurrentRequests = 5;
+// Batch searches ask one provider at a time, and CoverProviders limits the searches for each provider.
+constexpr int kMaxConcurrentBatchRequests = 15;
 }
 
 AlbumCoverFetcher::AlbumCoverFetcher(SharedPtr<CoverProviders> cover_providers, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -99,7 +101,7 @@ void AlbumCoverFetcher::AddRequest(const CoverSearchRequest &req) {
 
   if (!request_starter_->isActive()) request_starter_->start();
 
-  if (active_requests_.size() < kMaxConcurrentRequests) StartRequests();
+  if (active_requests_.size() < (req.batch ? kMaxConcurrentBatchRequests : kMaxConcurrentRequests)) StartRequests();
 
 }
 
@@ -123,7 +125,7 @@ void AlbumCoverFetcher::StartRequests() {
     return;
   }
 
-  while (!queued_requests_.isEmpty() && active_requests_.size() < kMaxConcurrentRequests) {
+  while (!queued_requests_.isEmpty() && active_requests_.size() < (queued_requests_.head().batch ? kMaxConcurrentBatchRequests : kMaxConcurrentRequests)) {
 
     CoverSearchRequest request = queued_requests_.dequeue();
 
@@ -134,7 +136,7 @@ void AlbumCoverFetcher::StartRequests() {
     QObject::connect(search, &AlbumCoverFetcherSearch::SearchFinished, this, &AlbumCoverFetcher::SingleSearchFinished);
     QObject::connect(search, &AlbumCoverFetcherSearch::AlbumCoverFetched, this, &AlbumCoverFetcher::SingleCoverFetched);
 
-    search->Start(cover_providers_);
+    search->Start(cover_providers_, provider_statistics_);
   }
 
 }
@@ -155,6 +157,7 @@ void AlbumCoverFetcher::SingleCoverFetched(const quint64 request_id, const Album
   AlbumCoverFetcherSearch *search = active_requests_.take(request_id);
 
   search->deleteLater();
+  provider_statistics_ += search->statistics();
   Q_EMIT AlbumCoverFetched(request_id, result, search->statistics());
 
 }
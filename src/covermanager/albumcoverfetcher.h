@@ -136,6 +136,9 @@ class AlbumCoverFetcher : public QObject {
   QQueue<CoverSearchRequest> queued_requests_;
   QHash<quint64, AlbumCoverFetcherSearch*> active_requests_;
 
+  // Statistics of all fetched covers, used to order the providers for batch searches.
+  CoverSearchStatistics provider_statistics_;
+
   QTimer *request_starter_;
 };
 
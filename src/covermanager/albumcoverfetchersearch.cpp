@@ -55,6 +55,7 @@ constexpr int kSearchTimeoutMs = 20000;
 constexpr int kImageLoadTimeoutMs = 6000;
 constexpr int kTargetSize = 500;
 constexpr float kGoodScore = 4.0;
+constexpr int kBatchProviderRetryMsec = 100;
 }  // namespace
 
 AlbumCoverFetcherSearch::AlbumCoverFetcherSearch(const CoverSearchRequest &request, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -62,30 +63,43 @@ AlbumCoverFetcherSearch::AlbumCoverFetcherSearch(const CoverSearchRequest &reque
       request_(request),
       image_load_timeout_(new NetworkTimeouts(kImageLoadTimeoutMs, this)),
       network_(network),
+      batch_provider_timer_(new QTimer(this)),
       cancel_requested_(false) {
 
-  // We will terminate the search after kSearchTimeoutMs milliseconds if we are not able to find all of the results before that point in time
-  QTimer::singleShot(kSearchTimeoutMs, this, &AlbumCoverFetcherSearch::TerminateSearch);
+  batch_provider_timer_->setSingleShot(true);
+  batch_provider_timer_->setInterval(kBatchProviderRetryMsec);
+  QObject::connect(batch_provider_timer_, &QTimer::timeout, this, &AlbumCoverFetcherSearch::StartBatchProviderSearch);
 
 }
 
 AlbumCoverFetcherSearch::~AlbumCoverFetcherSearch() {
+
+  if (request_.batch && cover_providers_) {
+    for (CoverProvider *provider : std::as_const(pending_requests_)) {
+      cover_providers_->BatchSearchFinished(provider);
+    }
+  }
   pending_requests_.clear();
   Cancel();
+
 }
 
 void AlbumCoverFetcherSearch::TerminateSearch() {
 
   const QList<int> ids = pending_requests_.keys();
   for (const int id : ids) {
-    pending_requests_.take(id)->CancelSearch(id);
+    CoverProvider *provider = pending_requests_.take(id);
+    provider->CancelSearch(id);
+    if (request_.batch) cover_providers_->BatchSearchFinished(provider);
   }
 
   AllProvidersFinished();
 
 }
 
-void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
+void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers, const CoverSearchStatistics &provider_statistics) {
+
+  cover_providers_ = cover_providers;
 
   // Ignore Radio Paradise "commercial" break.
   if (request_.artist.compare("commercial-free"_L1, Qt::CaseInsensitive) == 0 && request_.title.compare("listener-supported"_L1, Qt::CaseInsensitive) == 0) {
@@ -96,6 +110,16 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
   QList<CoverProvider*> cover_providers_sorted = cover_providers->List();
   std::stable_sort(cover_providers_sorted.begin(), cover_providers_sorted.end(), ProviderCompareOrder);
 
+  if (request_.batch) {
+    // Ask the providers whose covers were chosen most often first, providers that were not asked yet count as chosen half of the time.
+    const auto chosen_ratio = [&provider_statistics](CoverProvider *provider) {
+      const float chosen = static_cast<float>(provider_statistics.chosen_images_by_provider_.value(provider->name()));
+      const float searches = static_cast<float>(provider_statistics.searches_by_provider_.value(provider->name()));
+      return (chosen + 1.0F) / (searches + 2.0F);
+    };
+    std::stable_sort(cover_providers_sorted.begin(), cover_providers_sorted.end(), [&chosen_ratio](CoverProvider *a, CoverProvider *b) { return chosen_ratio(a) > chosen_ratio(b); });
+  }
+
   for (CoverProvider *provider : std::as_const(cover_providers_sorted)) {
 
     if (!provider->enabled()) continue;
@@ -115,17 +139,19 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
       continue;
     }
 
-    QObject::connect(provider, &CoverProvider::SearchResults, this, QOverload<const int, const CoverProviderSearchResults&>::of(&AlbumCoverFetcherSearch::ProviderSearchResults));
-    QObject::connect(provider, &CoverProvider::SearchFinished, this, &AlbumCoverFetcherSearch::ProviderSearchFinished);
-    const int id = cover_providers->NextId();
-    const bool success = provider->StartSearch(request_.artist, request_.album, request_.title, id);
-
-    if (success) {
-      pending_requests_[id] = provider;
-      statistics_.network_requests_made_++;
+    if (request_.batch) {
+      batch_providers_ << provider;
+    }
+    else {
+      StartProviderSearch(provider);
     }
   }
 
+  if (request_.batch && !batch_providers_.isEmpty()) {
+    StartBatchProviderSearch();
+    return;
+  }
+
   // End this search before it even began if there are no providers...
   if (pending_requests_.isEmpty()) {
     TerminateSearch();
@@ -133,6 +159,56 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
 
 }
 
+bool AlbumCoverFetcherSearch::StartProviderSearch(CoverProvider *provider) {
+
+  QObject::connect(provider, &CoverProvider::SearchResults, this, QOverload<const int, const CoverProviderSearchResults&>::of(&AlbumCoverFetcherSearch::ProviderSearchResults), Qt::UniqueConnection);
+  QObject::connect(provider, &CoverProvider::SearchFinished, this, &AlbumCoverFetcherSearch::ProviderSearchFinished, Qt::UniqueConnection);
+  const int id = cover_providers_->NextId();
+  const bool success = provider->StartSearch(request_.artist, request_.album, request_.title, id);
+
+  if (success) {
+    pending_requests_[id] = provider;
+    statistics_.network_requests_made_++;
+    statistics_.searches_by_provider_[provider->name()]++;
+    // Give up on the provider if it doesn't answer within kSearchTimeoutMs milliseconds.
+    QTimer::singleShot(kSearchTimeoutMs, this, [this, id]() { ProviderSearchTimeout(id); });
+  }
+
+  return success;
+
+}
+
+void AlbumCoverFetcherSearch::StartBatchProviderSearch() {
+
+  if (cancel_requested_) return;
+
+  while (!batch_providers_.isEmpty()) {
+    CoverProvider *provider = batch_providers_.first();
+    if (!cover_providers_->StartBatchSearch(provider)) {
+      // The provider is busy with other searches, try again soon.
+      batch_provider_timer_->start();
+      return;
+    }
+    batch_providers_.removeFirst();
+    if (StartProviderSearch(provider)) return;
+    cover_providers_->BatchSearchFinished(provider);
+  }
+
+  AllProvidersFinished();
+
+}
+
+void AlbumCoverFetcherSearch::ProviderSearchTimeout(const int id) {
+
+  if (!pending_requests_.contains(id)) return;
+
+  CoverProvider *provider = pending_requests_.value(id);
+  qLog(Debug) << "Search with" << provider->name() << "timed out";
+  provider->CancelSearch(id);
+  ProviderSearchFinished(id, CoverProviderSearchResults());
+
+}
+
 void AlbumCoverFetcherSearch::ProviderSearchResults(const int id, const CoverProviderSearchResults &results) {
 
   if (!pending_requests_.contains(id)) return;
@@ -236,6 +312,7 @@ void AlbumCoverFetcherSearch::ProviderSearchFinished(const int id, const CoverPr
   if (!pending_requests_.contains(id)) return;
 
   CoverProvider *provider = pending_requests_.take(id);
+  if (request_.batch) cover_providers_->BatchSearchFinished(provider);
   ProviderSearchResults(provider, results);
 
   // Do we have more providers left?
@@ -262,7 +339,7 @@ void AlbumCoverFetcherSearch::AllProvidersFinished() {
   }
 
   // No results?
-  if (results_.isEmpty()) {
+  if (results_.isEmpty() && candidate_images_.isEmpty() && batch_providers_.isEmpty()) {
     statistics_.missing_images_++;
     Q_EMIT AlbumCoverFetched(request_.id, AlbumCoverImageResult());
     return;
@@ -301,6 +378,11 @@ void AlbumCoverFetcherSearch::FetchMoreImages() {
   }
 
   if (pending_image_loads_.isEmpty()) {
+    // Ask the next provider if none of the images were good enough.
+    if (!batch_providers_.isEmpty()) {
+      StartBatchProviderSearch();
+      return;
+    }
     // There were no more results?  Time to give up.
     SendBestImage();
   }
@@ -418,6 +500,9 @@ void AlbumCoverFetcherSearch::Cancel() {
 
   cancel_requested_ = true;
 
+  batch_providers_.clear();
+  batch_provider_timer_->stop();
+
   if (!pending_requests_.isEmpty()) {
     TerminateSearch();
   }
@@ -27,6 +27,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QPair>
+#include <QList>
 #include <QMap>
 #include <QMultiMap>
 #include <QHash>
@@ -40,6 +41,7 @@
 #include "coversearchstatistics.h"
 #include "albumcoverimageresult.h"
 
+class QTimer;
 class QNetworkReply;
 class CoverProvider;
 class CoverProviders;
@@ -49,6 +51,7 @@ class NetworkTimeouts;
 // This class encapsulates a single search for covers initiated by an AlbumCoverFetcher.
 // The search engages all of the known cover providers.
 // AlbumCoverFetcherSearch signals search results to an interested AlbumCoverFetcher when all of the providers have done their part.
+// Batch searches ask one provider at a time, ordered by how often the provider's covers were chosen before, and stop when a good cover is found.
 class AlbumCoverFetcherSearch : public QObject {
   Q_OBJECT
 
@@ -56,7 +59,7 @@ class AlbumCoverFetcherSearch : public QObject {
   explicit AlbumCoverFetcherSearch(const CoverSearchRequest &request, SharedPtr<NetworkAccessManager> network, QObject *parent);
   ~AlbumCoverFetcherSearch() override;
 
-  void Start(SharedPtr<CoverProviders> cover_providers);
+  void Start(SharedPtr<CoverProviders> cover_providers, const CoverSearchStatistics &provider_statistics = CoverSearchStatistics());
 
   // Cancels all pending requests.  No Finished signals will be emitted, and it is the caller's responsibility to delete the AlbumCoverFetcherSearch.
   void Cancel();
@@ -77,8 +80,11 @@ class AlbumCoverFetcherSearch : public QObject {
   void ProviderSearchFinished(const int id, const CoverProviderSearchResults &results);
   void ProviderCoverFetchFinished(QNetworkReply *reply);
   void TerminateSearch();
+  void StartBatchProviderSearch();
 
  private:
+  bool StartProviderSearch(CoverProvider *provider);
+  void ProviderSearchTimeout(const int id);
   void ProviderSearchResults(CoverProvider *provider, const CoverProviderSearchResults &results);
   void AllProvidersFinished();
 
@@ -111,6 +117,11 @@ class AlbumCoverFetcherSearch : public QObject {
   QMultiMap<float, CandidateImage> candidate_images_;
 
   SharedPtr<NetworkAccessManager> network_;
+  SharedPtr<CoverProviders> cover_providers_;
+
+  // Providers not asked yet in a batch search.
+  QList<CoverProvider*> batch_providers_;
+  QTimer *batch_provider_timer_;
 
   bool cancel_requested_;
 
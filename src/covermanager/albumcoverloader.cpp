@@ -40,6 +40,7 @@
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
+#include "core/tracing.h"
 #include "utilities/mimeutils.h"
 #include "utilities/imageutils.h"
 #include "tagreader/tagreaderclient.h"
@@ -173,6 +174,7 @@ quint64 AlbumCoverLoader::EnqueueTask(TaskPtr task) {
   {
     QMutexLocker l(&mutex_load_image_async_);
     task->id = load_image_async_id_++;
+    if (tracing::IsEnabled()) task->enqueued_usec = tracing::NowUsec();
     tasks_.enqueue(task);
   }
 
@@ -257,6 +259,10 @@ void AlbumCoverLoader::FinishTask(TaskPtr task, const AlbumCoverLoaderResult::Ty
     }
   }
 
+  if (task->enqueued_usec >= 0) {
+    tracing::AddDuration("covers", "Load cover", task->enqueued_usec, tracing::NowUsec() - task->enqueued_usec);
+  }
+
   Q_EMIT AlbumCoverLoaded(task->id, AlbumCoverLoaderResult(task->success, task->result_type, task->album_cover, image_scaled, task->art_manual_updated, task->art_automatic_updated));
 
 }
@@ -68,7 +68,7 @@ class AlbumCoverLoader : public QObject {
  private:
   class Task {
    public:
-    explicit Task() : id(0), success(false), art_embedded(false), art_unset(false), song_source(Song::Source::Unknown), result_type(AlbumCoverLoaderResult::Type::None), redirects(0) {}
+    explicit Task() : id(0), success(false), art_embedded(false), art_unset(false), song_source(Song::Source::Unknown), result_type(AlbumCoverLoaderResult::Type::None), redirects(0), enqueued_usec(-1) {}
 
     quint64 id;
     bool success;
@@ -92,6 +92,7 @@ class AlbumCoverLoader : public QObject {
     QUrl art_manual_updated;
     QUrl art_automatic_updated;
     int redirects;
+    qint64 enqueued_usec;
   };
   using TaskPtr = SharedPtr<Task>;
 
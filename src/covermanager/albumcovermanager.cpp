@@ -52,6 +52,7 @@
 #include <QStatusBar>
 #include <QLabel>
 #include <QListWidget>
+#include <QScrollBar>
 #include <QMessageBox>
 #include <QProgressBar>
 #include <QPushButton>
@@ -60,7 +61,13 @@
 #include <QSettings>
 #include <QFlags>
 #include <QSize>
+#include <QPoint>
+#include <QRect>
+#include <QModelIndex>
 #include <QtEvents>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QFutureWatcher>
 
 #include "includes/scoped_ptr.h"
 #include "includes/shared_ptr.h"
@@ -102,6 +109,18 @@ using std::make_shared;
 namespace {
 constexpr char kSettingsGroup[] = "CoverManager";
 constexpr int kThumbnailSize = 120;
+constexpr int kAlbumsPerBatch = 250;
+
+bool ArtFileExists(const QUrl &url) {
+
+  if (url.isLocalFile()) {
+    return QFile::exists(url.toLocalFile());
+  }
+
+  return !url.isEmpty();
+
+}
+
 }
 
 AlbumCoverManager::AlbumCoverManager(const SharedPtr<NetworkAccessManager> network,
@@ -122,9 +141,14 @@ AlbumCoverManager::AlbumCoverManager(const SharedPtr<NetworkAccessManager> netwo
       cover_providers_(cover_providers),
       album_cover_choice_controller_(new AlbumCoverChoiceController(this)),
       timer_album_cover_load_(new QTimer(this)),
+      timer_visible_album_covers_(new QTimer(this)),
+      timer_update_filter_(new QTimer(this)),
+      timer_add_albums_(new QTimer(this)),
       filter_all_(nullptr),
       filter_with_covers_(nullptr),
       filter_without_covers_(nullptr),
+      albums_pending_specific_artist_(false),
+      albums_generation_(0),
       cover_fetcher_(new AlbumCoverFetcher(cover_providers, network, this)),
       cover_searcher_(nullptr),
       cover_export_(nullptr),
@@ -146,6 +170,18 @@ AlbumCoverManager::AlbumCoverManager(const SharedPtr<NetworkAccessManager> netwo
   timer_album_cover_load_->setInterval(10ms);
   QObject::connect(timer_album_cover_load_, &QTimer::timeout, this, &AlbumCoverManager::LoadAlbumCovers);
 
+  timer_visible_album_covers_->setSingleShot(true);
+  timer_visible_album_covers_->setInterval(50ms);
+  QObject::connect(timer_visible_album_covers_, &QTimer::timeout, this, &AlbumCoverManager::LoadVisibleAlbumCovers);
+
+  timer_update_filter_->setSingleShot(true);
+  timer_update_filter_->setInterval(200ms);
+  QObject::connect(timer_update_filter_, &QTimer::timeout, this, &AlbumCoverManager::UpdateFilter);
+
+  timer_add_albums_->setSingleShot(false);
+  timer_add_albums_->setInterval(0ms);
+  QObject::connect(timer_add_albums_, &QTimer::timeout, this, &AlbumCoverManager::AddAlbums);
+
   // Icons
   ui_->action_fetch->setIcon(IconLoader::Load(u"download"_s));
   ui_->export_covers->setIcon(IconLoader::Load(u"document-save"_s));
@@ -235,6 +271,7 @@ void AlbumCoverManager::Init() {
   QObject::connect(cover_fetcher_, &AlbumCoverFetcher::AlbumCoverFetched, this, &AlbumCoverManager::AlbumCoverFetched);
   QObject::connect(ui_->action_fetch, &QAction::triggered, this, &AlbumCoverManager::FetchSingleCover);
   QObject::connect(ui_->albums, &QListWidget::doubleClicked, this, &AlbumCoverManager::AlbumDoubleClicked);
+  QObject::connect(ui_->albums->verticalScrollBar(), &QScrollBar::valueChanged, timer_visible_album_covers_, qOverload<>(&QTimer::start));
   QObject::connect(ui_->action_add_to_playlist, &QAction::triggered, this, &AlbumCoverManager::AddSelectedToPlaylist);
   QObject::connect(ui_->action_load, &QAction::triggered, this, &AlbumCoverManager::LoadSelectedToPlaylist);
 
@@ -289,6 +326,7 @@ void AlbumCoverManager::closeEvent(QCloseEvent *e) {
   SaveSettings();
 
   // Cancel any outstanding requests
+  CancelAddAlbums();
   CancelRequests();
 
   ui_->artists->clear();
@@ -333,6 +371,12 @@ void AlbumCoverManager::SaveSettings() {
 void AlbumCoverManager::CancelRequests() {
 
   albumcover_loader_->CancelTasks(QSet<quint64>(cover_loading_tasks_.keyBegin(), cover_loading_tasks_.keyEnd()));
+  for (AlbumItem *album_item : std::as_const(cover_loading_pending_)) {
+    album_item->cover_loading = false;
+  }
+  for (AlbumItem *album_item : std::as_const(cover_loading_tasks_)) {
+    album_item->cover_loading = false;
+  }
   cover_loading_pending_.clear();
   cover_loading_tasks_.clear();
   cover_save_tasks_.clear();
@@ -388,9 +432,10 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
 
   if (!current) return;
 
+  CancelAddAlbums();
+  CancelRequests();
   ui_->albums->clear();
   context_menu_items_.clear();
-  CancelRequests();
 
   // Get the list of albums.  How we do it depends on what thing we have selected in the artist list.
   CollectionBackend::AlbumList albums;
@@ -404,14 +449,33 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
   // Sort by album name.  The list is already sorted by sqlite but it was done case sensitively.
   std::stable_sort(albums.begin(), albums.end(), CompareAlbumNameNocase);
 
-  for (const CollectionBackend::Album &album_info : std::as_const(albums)) {
+  // The items are added in batches from the event loop, so selecting "All artists" on a large collection doesn't block the window.
+  albums_pending_ = std::move(albums);
+  albums_pending_specific_artist_ = current->type() == Specific_Artist;
+  AddAlbums();
+  if (!albums_pending_.isEmpty()) {
+    timer_add_albums_->start();
+  }
+
+}
+
+void AlbumCoverManager::AddAlbums() {
+
+  const QString filter = ui_->filter->text().toLower();
+  const HideCovers hide_covers = FilterHideCovers();
+
+  QList<AlbumItem*> album_items_art_set;
+  const qint64 count = std::min(static_cast<qint64>(kAlbumsPerBatch), static_cast<qint64>(albums_pending_.count()));
+  for (qint64 i = 0; i < count; ++i) {
+
+    const CollectionBackend::Album &album_info = albums_pending_.at(i);
 
     // Don't show songs without an album, obviously
     if (album_info.album.isEmpty()) continue;
 
     QString display_text;
 
-    if (current->type() == Specific_Artist) {
+    if (albums_pending_specific_artist_) {
       display_text = album_info.album;
     }
     else {
@@ -439,18 +503,79 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
     album_item->setData(Role_ArtManual, album_info.art_manual);
     album_item->setData(Role_ArtUnset, album_info.art_unset);
 
-    if (album_info.art_embedded || !album_info.art_automatic.isEmpty() || !album_info.art_manual.isEmpty()) {
-      QueueAlbumCoverLoad(album_item);
+    // Assume the art files exist until they are checked in a worker thread, so adding albums doesn't wait for the disk.
+    album_item->art_exists = AlbumArtSet(AlbumItemArtFiles(album_item));
+    if (album_item->art_exists) {
+      album_item->art_exists_pending = true;
+      album_items_art_set << album_item;
     }
 
+    // Only the new albums are filtered here, the counts are updated when all albums are added.
+    album_item->setHidden(ShouldHide(*album_item, filter, hide_covers));
+
   }
 
-  UpdateFilter();
+  if (!album_items_art_set.isEmpty()) {
+    CheckArtExistsAsync(album_items_art_set);
+  }
+
+  albums_pending_.remove(0, count);
+  if (albums_pending_.isEmpty()) {
+    timer_add_albums_->stop();
+    UpdateFilter();
+  }
+  else {
+    timer_visible_album_covers_->start();
+  }
+
+}
+
+void AlbumCoverManager::CancelAddAlbums() {
+
+  timer_add_albums_->stop();
+  albums_pending_.clear();
+  ++albums_generation_;
+
+}
+
+void AlbumCoverManager::LoadVisibleAlbumCovers() {
+
+  // Covers are only loaded for the albums in view, and the page below it.
+  // Albums scrolled past before their cover was loaded are dropped from the queue.
+  for (AlbumItem *album_item : std::as_const(cover_loading_pending_)) {
+    album_item->cover_loading = false;
+  }
+  cover_loading_pending_.clear();
+
+  const QRect viewport_rect = ui_->albums->viewport()->rect();
+  const QRect load_rect = viewport_rect.adjusted(0, 0, 0, viewport_rect.height());
+
+  // The albums are laid out in rows from the left, so the first album in view is found at the left edge.
+  // The top left corner can fall between two albums, so move down until an album is found.
+  int first_row = -1;
+  for (int y = load_rect.top(); y <= viewport_rect.bottom() && first_row == -1; y += ui_->albums->spacing() + 1) {
+    const QModelIndex idx = ui_->albums->indexAt(QPoint(load_rect.left() + ui_->albums->spacing() + 1, y));
+    if (idx.isValid()) first_row = idx.row();
+  }
+  if (first_row == -1) return;
+
+  // The last row can be shorter, so go through the albums until they are below the rect instead of using the bottom right corner.
+  const QModelIndex last_idx = ui_->albums->indexAt(load_rect.bottomRight());
+  const int last_row = last_idx.isValid() ? last_idx.row() : ui_->albums->count() - 1;
+
+  for (int i = first_row; i <= last_row; ++i) {
+    AlbumItem *album_item = static_cast<AlbumItem*>(ui_->albums->item(i));
+    if (album_item->isHidden()) continue;
+    if (ui_->albums->visualItemRect(album_item).top() > load_rect.bottom()) break;
+    if (album_item->cover_loading || album_item->cover_loaded || !album_item->art_exists) continue;
+    QueueAlbumCoverLoad(album_item);
+  }
 
 }
 
 void AlbumCoverManager::QueueAlbumCoverLoad(AlbumItem *album_item) {
 
+  album_item->cover_loading = true;
   cover_loading_pending_.enqueue(album_item);
 
   if (!timer_album_cover_load_->isActive()) {
@@ -479,6 +604,7 @@ void AlbumCoverManager::LoadAlbumCoverAsync(AlbumItem *album_item) {
   cover_options.desired_scaled_size = QSize(kThumbnailSize, kThumbnailSize);
   cover_options.device_pixel_ratio = devicePixelRatioF();
   quint64 cover_load_id = albumcover_loader_->LoadImageAsync(cover_options, album_item->data(Role_ArtEmbedded).toBool(), album_item->data(Role_ArtAutomatic).toUrl(), album_item->data(Role_ArtManual).toUrl(), album_item->data(Role_ArtUnset).toBool(), album_item->urls.constFirst());
+  album_item->cover_loading = true;
   cover_loading_tasks_.insert(cover_load_id, album_item);
 
 }
@@ -488,6 +614,8 @@ void AlbumCoverManager::AlbumCoverLoaded(const quint64 id, const AlbumCoverLoade
   if (!cover_loading_tasks_.contains(id)) return;
 
   AlbumItem *album_item = cover_loading_tasks_.take(id);
+  album_item->cover_loading = false;
+  album_item->cover_loaded = true;
 
   if (!result.success || result.image_scaled.isNull() || result.type == AlbumCoverLoaderResult::Type::Unset) {
     album_item->setIcon(icon_nocover_item_);
@@ -496,24 +624,31 @@ void AlbumCoverManager::AlbumCoverLoaded(const quint64 id, const AlbumCoverLoade
     album_item->setIcon(QPixmap::fromImage(result.image_scaled));
   }
 
-  UpdateFilter();
+  // The filter goes through all albums, so it's updated once for several loaded covers.
+  if (!timer_update_filter_->isActive()) {
+    timer_update_filter_->start();
+  }
 
 }
 
-void AlbumCoverManager::UpdateFilter() {
-
-  const QString filter = ui_->filter->text().toLower();
-  const bool hide_with_covers = filter_without_covers_->isChecked();
-  const bool hide_without_covers = filter_with_covers_->isChecked();
+AlbumCoverManager::HideCovers AlbumCoverManager::FilterHideCovers() const {
 
-  HideCovers hide_covers = HideCovers::None;
-  if (hide_with_covers) {
-    hide_covers = HideCovers::WithCovers;
+  if (filter_without_covers_->isChecked()) {
+    return HideCovers::WithCovers;
   }
-  else if (hide_without_covers) {
-    hide_covers = HideCovers::WithoutCovers;
+  if (filter_with_covers_->isChecked()) {
+    return HideCovers::WithoutCovers;
   }
 
+  return HideCovers::None;
+
+}
+
+void AlbumCoverManager::UpdateFilter() {
+
+  const QString filter = ui_->filter->text().toLower();
+  const HideCovers hide_covers = FilterHideCovers();
+
   qint32 total_count = 0;
   qint32 without_cover = 0;
 
@@ -533,6 +668,9 @@ void AlbumCoverManager::UpdateFilter() {
   ui_->total_albums->setText(QString::number(total_count));
   ui_->without_cover->setText(QString::number(without_cover));
 
+  // Hiding albums moves others into view.
+  timer_visible_album_covers_->start();
+
 }
 
 bool AlbumCoverManager::ShouldHide(const AlbumItem &album_item, const QString &filter, const HideCovers hide_covers) const {
@@ -632,6 +770,10 @@ void AlbumCoverManager::UpdateStatusText() {
 
 bool AlbumCoverManager::eventFilter(QObject *obj, QEvent *e) {
 
+  if (obj == ui_->albums && e->type() == QEvent::Resize) {
+    timer_visible_album_covers_->start();
+  }
+
   if (obj == ui_->albums && e->type() == QEvent::ContextMenu) {
     context_menu_items_ = ui_->albums->selectedItems();
     if (context_menu_items_.isEmpty()) return QMainWindow::eventFilter(obj, e);
@@ -740,6 +882,7 @@ void AlbumCoverManager::UpdateCoverInList(AlbumItem *album_item, const QUrl &cov
 
   album_item->setData(Role_ArtManual, cover_url);
   album_item->setData(Role_ArtUnset, false);
+  UpdateArtExists(album_item);
   LoadAlbumCoverAsync(album_item);
 
 }
@@ -885,6 +1028,8 @@ void AlbumCoverManager::UnsetCover() {
     album_item->setData(Role_ArtManual, QUrl());
     album_item->setData(Role_ArtAutomatic, QUrl());
     album_item->setData(Role_ArtUnset, true);
+    album_item->art_exists = false;
+    album_item->art_exists_pending = false;
 
     Song current_song = AlbumItemAsSong(album_item);
     album_cover_choice_controller_->UnsetAlbumCoverForSong(&current_song);
@@ -904,6 +1049,8 @@ void AlbumCoverManager::ClearCover() {
     album_item->setData(Role_ArtAutomatic, QUrl());
     album_item->setData(Role_ArtManual, QUrl());
     album_item->setData(Role_ArtUnset, false);
+    album_item->art_exists = false;
+    album_item->art_exists_pending = false;
 
     Song current_song = AlbumItemAsSong(album_item);
     album_cover_choice_controller_->ClearAlbumCoverForSong(&current_song);
@@ -921,6 +1068,8 @@ void AlbumCoverManager::DeleteCover() {
     album_item->setData(Role_ArtEmbedded, false);
     album_item->setData(Role_ArtManual, QUrl());
     album_item->setData(Role_ArtAutomatic, QUrl());
+    album_item->art_exists = false;
+    album_item->art_exists_pending = false;
   }
 
 }
@@ -929,8 +1078,7 @@ SongList AlbumCoverManager::GetSongsInAlbum(const QModelIndex &idx) const {
 
   SongList ret;
 
-  QMutexLocker l(collection_backend_->db()->Mutex());
-  QSqlDatabase db(collection_backend_->db()->Connect());
+  QSqlDatabase db(collection_backend_->db()->ConnectReadOnly());
 
   CollectionQuery q(db, collection_backend_->songs_table());
   q.SetColumnSpec(Song::kRowIdColumnSpec);
@@ -1106,7 +1254,88 @@ void AlbumCoverManager::UpdateExportStatus(const int exported, const int skipped
 }
 
 bool AlbumCoverManager::ItemHasCover(const AlbumItem &album_item) const {
+
+  // Albums with an existing art file that has not been loaded yet are assumed to have a cover.
+  if (!album_item.cover_loaded && album_item.art_exists) return true;
+
   return album_item.icon().cacheKey() != icon_nocover_item_.cacheKey();
+
+}
+
+AlbumCoverManager::AlbumArtFiles AlbumCoverManager::AlbumItemArtFiles(const AlbumItem *album_item) {
+
+  AlbumArtFiles art_files;
+  art_files.art_unset = album_item->data(Role_ArtUnset).toBool();
+  art_files.art_embedded = album_item->data(Role_ArtEmbedded).toBool();
+  art_files.art_manual = album_item->data(Role_ArtManual).toUrl();
+  art_files.art_automatic = album_item->data(Role_ArtAutomatic).toUrl();
+  if (!album_item->urls.isEmpty()) art_files.song_url = album_item->urls.constFirst();
+
+  return art_files;
+
+}
+
+bool AlbumCoverManager::AlbumArtSet(const AlbumArtFiles &art_files) {
+
+  return !art_files.art_unset && (!art_files.art_manual.isEmpty() || !art_files.art_automatic.isEmpty() || (art_files.art_embedded && !art_files.song_url.isEmpty()));
+
+}
+
+bool AlbumCoverManager::AlbumArtExists(const AlbumArtFiles &art_files) {
+
+  // Embedded art is only checked by the song file existing.
+  return !art_files.art_unset && (ArtFileExists(art_files.art_manual) || ArtFileExists(art_files.art_automatic) || (art_files.art_embedded && !art_files.song_url.isEmpty() && ArtFileExists(art_files.song_url)));
+
+}
+
+void AlbumCoverManager::UpdateArtExists(AlbumItem *album_item) {
+
+  // Checked when the art changes instead of every time the filter is updated.
+  album_item->art_exists = AlbumArtExists(AlbumItemArtFiles(album_item));
+  album_item->art_exists_pending = false;
+
+}
+
+void AlbumCoverManager::CheckArtExistsAsync(const QList<AlbumItem*> &album_items) {
+
+  QList<AlbumArtFiles> album_art_files;
+  album_art_files.reserve(album_items.count());
+  for (AlbumItem *album_item : album_items) {
+    album_art_files << AlbumItemArtFiles(album_item);
+  }
+
+  const quint64 albums_generation = albums_generation_;
+  QFuture<QList<bool>> future = QtConcurrent::run([album_art_files]() {
+    QList<bool> art_exists;
+    art_exists.reserve(album_art_files.count());
+    for (const AlbumArtFiles &art_files : album_art_files) {
+      art_exists << AlbumArtExists(art_files);
+    }
+    return art_exists;
+  });
+  QFutureWatcher<QList<bool>> *watcher = new QFutureWatcher<QList<bool>>(this);
+  QObject::connect(watcher, &QFutureWatcher<QList<bool>>::finished, this, [this, watcher, albums_generation, album_items]() {
+    const QList<bool> art_exists = watcher->result();
+    watcher->deleteLater();
+    // The items are deleted when the albums are replaced.
+    if (albums_generation != albums_generation_) return;
+    bool changed = false;
+    for (qsizetype i = 0; i < album_items.count() && i < art_exists.count(); ++i) {
+      AlbumItem *album_item = album_items[i];
+      // Skip albums whose art changed meanwhile.
+      if (!album_item->art_exists_pending) continue;
+      album_item->art_exists_pending = false;
+      if (album_item->art_exists != art_exists[i]) {
+        album_item->art_exists = art_exists[i];
+        changed = true;
+      }
+    }
+    if (changed && !timer_update_filter_->isActive()) {
+      timer_update_filter_->start();
+    }
+  });
+  watcher->setFuture(future);
+
 }
 
 void AlbumCoverManager::SaveEmbeddedCoverFinished(TagReaderReplyPtr reply, AlbumItem *album_item, const QUrl &url, const bool art_embedded) {
@@ -1126,6 +1355,7 @@ void AlbumCoverManager::SaveEmbeddedCoverFinished(TagReaderReplyPtr reply, Album
 
   album_item->setData(Role_ArtEmbedded, true);
   album_item->setData(Role_ArtUnset, false);
+  UpdateArtExists(album_item);
   Song song = AlbumItemAsSong(album_item);
   album_cover_choice_controller_->SaveArtEmbeddedToSong(&song, art_embedded);
   LoadAlbumCoverAsync(album_item);
@@ -34,12 +34,14 @@
 #include <QMultiMap>
 #include <QQueue>
 #include <QString>
+#include <QUrl>
 #include <QImage>
 #include <QIcon>
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
 #include "tagreader/tagreaderclient.h"
+#include "collection/collectionbackend.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverloaderresult.h"
 #include "albumcoverchoicecontroller.h"
@@ -56,7 +58,6 @@ class QCloseEvent;
 class QShowEvent;
 
 class NetworkAccessManager;
-class CollectionBackend;
 class AlbumCoverLoader;
 class CurrentAlbumCoverLoader;
 class CoverProviders;
@@ -70,8 +71,12 @@ class Ui_CoverManager;
 
 class AlbumItem : public QListWidgetItem {
  public:
-  AlbumItem(const QIcon &icon, const QString &text, QListWidget *parent = nullptr, int type = Type) : QListWidgetItem(icon, text, parent, type) {};
+  AlbumItem(const QIcon &icon, const QString &text, QListWidget *parent = nullptr, int type = Type) : QListWidgetItem(icon, text, parent, type), cover_loading(false), cover_loaded(false), art_exists(false), art_exists_pending(false) {};
   QList<QUrl> urls;
+  bool cover_loading;
+  bool cover_loaded;
+  bool art_exists;
+  bool art_exists_pending;  // The art files are being checked in a worker thread
 
  private:
   Q_DISABLE_COPY(AlbumItem)
@@ -135,6 +140,15 @@ class AlbumCoverManager : public QMainWindow {
     WithoutCovers
   };
 
+  // The art of an album item, copied so the files can be checked in a worker thread.
+  struct AlbumArtFiles {
+    bool art_unset;
+    bool art_embedded;
+    QUrl art_manual;
+    QUrl art_automatic;
+    QUrl song_url;
+  };
+
   void LoadGeometry();
   void SaveSettings();
 
@@ -150,6 +164,7 @@ class AlbumCoverManager : public QMainWindow {
 
   void QueueAlbumCoverLoad(AlbumItem *album_item);
   void LoadAlbumCoverAsync(AlbumItem *album_item);
+  void CancelAddAlbums();
 
   void UpdateStatusText();
   bool ShouldHide(const AlbumItem &album_item, const QString &filter, const HideCovers hide_covers) const;
@@ -161,6 +176,12 @@ class AlbumCoverManager : public QMainWindow {
   SongMimeData *GetMimeDataForAlbums(const QModelIndexList &indexes) const;
 
   bool ItemHasCover(const AlbumItem &album_item) const;
+  static AlbumArtFiles AlbumItemArtFiles(const AlbumItem *album_item);
+  static bool AlbumArtSet(const AlbumArtFiles &art_files);
+  static bool AlbumArtExists(const AlbumArtFiles &art_files);
+  void UpdateArtExists(AlbumItem *album_item);
+  void CheckArtExistsAsync(const QList<AlbumItem*> &album_items);
+  HideCovers FilterHideCovers() const;
 
  Q_SIGNALS:
   void Error(const QString &error);
@@ -168,6 +189,8 @@ class AlbumCoverManager : public QMainWindow {
 
  private Q_SLOTS:
   void ArtistChanged(QListWidgetItem *current);
+  void AddAlbums();
+  void LoadVisibleAlbumCovers();
   void LoadAlbumCovers();
   void AlbumCoverLoaded(const quint64 id, const AlbumCoverLoaderResult &result);
   void UpdateFilter();
@@ -210,11 +233,18 @@ class AlbumCoverManager : public QMainWindow {
 
   AlbumCoverChoiceController *album_cover_choice_controller_;
   QTimer *timer_album_cover_load_;
+  QTimer *timer_visible_album_covers_;
+  QTimer *timer_update_filter_;
+  QTimer *timer_add_albums_;
 
   QAction *filter_all_;
   QAction *filter_with_covers_;
   QAction *filter_without_covers_;
 
+  CollectionBackend::AlbumList albums_pending_;
+  bool albums_pending_specific_artist_;
+  quint64 albums_generation_;
+
   QQueue<AlbumItem*> cover_loading_pending_;
   QMap<quint64, AlbumItem*> cover_loading_tasks_;
 
@@ -0,0 +1,138 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "core/song.h"
+#include "utilities/coverutils.h"
+#include "covercacheindex.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+QMutex CoverCacheIndex::sMutex;
+QHash<QString, CoverCacheIndex::CacheDirectory> CoverCacheIndex::sDirectories;
+thread_local int CoverCacheIndex::sBatchDepth = 0;
+
+CoverCacheIndex::Batch::Batch() {
+
+  if (sBatchDepth++ == 0) {
+    sMutex.lock();
+  }
+
+}
+
+CoverCacheIndex::Batch::~Batch() {
+
+  if (--sBatchDepth == 0) {
+    sMutex.unlock();
+  }
+
+}
+
+CoverCacheIndex::CacheDirectory &CoverCacheIndex::Directory(const QString &path) {
+
+  QHash<QString, CacheDirectory>::iterator it = sDirectories.find(path);
+  if (it == sDirectories.end()) {
+    CacheDirectory directory;
+    const QStringList filenames = QDir(path).entryList(QDir::Files);
+    directory.filenames = QSet<QString>(filenames.begin(), filenames.end());
+    it = sDirectories.insert(path, directory);
+  }
+
+  return it.value();
+
+}
+
+QString CoverCacheIndex::ManualCoverPath(const Song::Source source, const QString &albumartist, const QString &album) {
+
+  if (albumartist.isEmpty() || album.isEmpty()) return QString();
+
+  // Inside a batch this thread already holds the lock.
+  if (sBatchDepth > 0) {
+    return ManualCoverPathLocked(source, albumartist, album);
+  }
+
+  QMutexLocker l(&sMutex);
+  return ManualCoverPathLocked(source, albumartist, album);
+
+}
+
+QString CoverCacheIndex::ManualCoverPathLocked(const Song::Source source, const QString &albumartist, const QString &album) {
+
+  const QString path = Song::ImageCacheDir(source);
+  const QString album_key = albumartist + QLatin1Char('\n') + album;
+
+  CacheDirectory &directory = Directory(path);
+  QHash<QString, QString>::const_iterator it = directory.manual_cover_paths.constFind(album_key);
+  if (it != directory.manual_cover_paths.constEnd()) {
+    return it.value();
+  }
+
+  const QString filename = QString::fromLatin1(CoverUtils::Sha1CoverHash(albumartist, album).toHex()) + u".jpg"_s;
+  const QString cover_path = directory.filenames.contains(filename) ? path + QLatin1Char('/') + filename : QString();
+  directory.manual_cover_paths.insert(album_key, cover_path);
+
+  return cover_path;
+
+}
+
+void CoverCacheIndex::AddFile(const QString &filepath) {
+
+  const QFileInfo fileinfo(filepath);
+
+  QMutexLocker l(&sMutex);
+
+  // Directories that were never queried are listed when they are first needed.
+  QHash<QString, CacheDirectory>::iterator it = sDirectories.find(fileinfo.path());
+  if (it == sDirectories.end()) return;
+
+  it->filenames.insert(fileinfo.fileName());
+  it->manual_cover_paths.clear();
+
+}
+
+void CoverCacheIndex::RemoveFile(const QString &filepath) {
+
+  const QFileInfo fileinfo(filepath);
+
+  QMutexLocker l(&sMutex);
+
+  QHash<QString, CacheDirectory>::iterator it = sDirectories.find(fileinfo.path());
+  if (it == sDirectories.end()) return;
+
+  it->filenames.remove(fileinfo.fileName());
+  it->manual_cover_paths.clear();
+
+}
+
+void CoverCacheIndex::Clear() {
+
+  QMutexLocker l(&sMutex);
+  sDirectories.clear();
+
+}
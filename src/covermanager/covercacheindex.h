@@ -0,0 +1,70 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COVERCACHEINDEX_H
+#define COVERCACHEINDEX_H
+
+#include "config.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QMutex>
+
+#include "core/song.h"
+
+// In-memory index of the files in the album cover cache directories.
+// Each directory is listed once, the first time it is queried, and kept up to date by the code writing and deleting covers,
+// so loading songs doesn't stat the cache directory for every row.
+class CoverCacheIndex {
+
+ public:
+  // Returns the path of the cached manual cover for the album, or an empty string. The result is memoized per album.
+  static QString ManualCoverPath(const Song::Source source, const QString &albumartist, const QString &album);
+
+  static void AddFile(const QString &filepath);
+  static void RemoveFile(const QString &filepath);
+  static void Clear();
+
+  // Holds the index lock while a list of songs is loaded, so ManualCoverPath() doesn't lock once per song.
+  // Don't add or remove files on the same thread while it is in scope.
+  class Batch {
+   public:
+    Batch();
+    ~Batch();
+
+   private:
+    Q_DISABLE_COPY(Batch)
+  };
+
+ private:
+  struct CacheDirectory {
+    QSet<QString> filenames;
+    QHash<QString, QString> manual_cover_paths;  // Album key -> cover path, empty if there is none.
+  };
+
+  static CacheDirectory &Directory(const QString &path);
+  static QString ManualCoverPathLocked(const Song::Source source, const QString &albumartist, const QString &album);
+
+  static QMutex sMutex;
+  static QHash<QString, CacheDirectory> sDirectories;
+  static thread_local int sBatchDepth;
+};
+
+#endif  // COVERCACHEINDEX_H
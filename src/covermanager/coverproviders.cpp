@@ -29,6 +29,7 @@
 #include <QMap>
 #include <QString>
 #include <QStringList>
+#include <QDateTime>
 #include <QSettings>
 
 #include "core/logging.h"
@@ -38,6 +39,11 @@
 
 #include "constants/coverssettings.h"
 
+namespace {
+constexpr int kMaxBatchSearchesPerProvider = 3;
+constexpr qint64 kMinBatchSearchIntervalMsec = 250;
+}  // namespace
+
 int CoverProviders::NextOrderId = 0;
 
 CoverProviders::CoverProviders(QObject *parent) : QObject(parent) {}
@@ -120,6 +126,7 @@ void CoverProviders::RemoveProvider(CoverProvider *provider) {
   {
     QMutexLocker locker(&mutex_);
     name = cover_providers_.take(provider);
+    batch_searches_.remove(provider);
   }
 
   if (name.isNull()) {
@@ -139,3 +146,31 @@ void CoverProviders::ProviderDestroyed() {
 }
 
 int CoverProviders::NextId() { return next_id_.fetchAndAddRelaxed(1); }
+
+bool CoverProviders::StartBatchSearch(CoverProvider *provider) {
+
+  QMutexLocker locker(&mutex_);
+
+  BatchSearchState &state = batch_searches_[provider];
+  const qint64 current_time = QDateTime::currentMSecsSinceEpoch();
+  if (state.active >= kMaxBatchSearchesPerProvider || current_time - state.last_started < kMinBatchSearchIntervalMsec) {
+    return false;
+  }
+
+  ++state.active;
+  state.last_started = current_time;
+
+  return true;
+
+}
+
+void CoverProviders::BatchSearchFinished(CoverProvider *provider) {
+
+  QMutexLocker locker(&mutex_);
+
+  QHash<CoverProvider*, BatchSearchState>::iterator it = batch_searches_.find(provider);
+  if (it != batch_searches_.end() && it->active > 0) {
+    --it->active;
+  }
+
+}
@@ -29,6 +29,7 @@
 #include <QMutex>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QString>
 #include <QAtomicInt>
 
@@ -59,6 +60,11 @@ class CoverProviders : public QObject {
 
   int NextId();
 
+  // Limits how many searches run at the same time for each provider, and how often they are started, when fetching missing covers.
+  // Returns false if the provider is busy, otherwise BatchSearchFinished() has to be called when the search is finished.
+  bool StartBatchSearch(CoverProvider *provider);
+  void BatchSearchFinished(CoverProvider *provider);
+
  private Q_SLOTS:
   void ProviderDestroyed();
 
@@ -67,7 +73,14 @@ class CoverProviders : public QObject {
 
   static int NextOrderId;
 
+  struct BatchSearchState {
+    BatchSearchState() : active(0), last_started(0) {}
+    int active;
+    qint64 last_started;
+  };
+
   QMap<CoverProvider*, QString> cover_providers_;
+  QHash<CoverProvider*, BatchSearchState> batch_searches_;
   QMutex mutex_;
 
   QAtomicInt next_id_;
@@ -50,6 +50,10 @@ CoverSearchStatistics &CoverSearchStatistics::operator+=(const CoverSearchStatis
   for (const QString &key : std::as_const(keys)) {
     total_images_by_provider_[key] += other.total_images_by_provider_[key];
   }
+  keys = other.searches_by_provider_.keys();
+  for (const QString &key : std::as_const(keys)) {
+    searches_by_provider_[key] += other.searches_by_provider_[key];
+  }
 
   chosen_images_ += other.chosen_images_;
   missing_images_ += other.missing_images_;
@@ -37,6 +37,7 @@ struct CoverSearchStatistics {
   quint64 network_requests_made_;
   quint64 bytes_transferred_;
   QMap<QString, quint64> total_images_by_provider_;
+  QMap<QString, quint64> searches_by_provider_;
   QMap<QString, quint64> chosen_images_by_provider_;
 
   quint64 chosen_images_;
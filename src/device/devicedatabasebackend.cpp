@@ -217,6 +217,16 @@ void DeviceDatabaseBackend::RemoveDevice(const int id) {
     }
   }
 
+  {
+    SqlQuery q(db);
+    q.prepare(u"DELETE FROM compilation_groups WHERE songs_table = :songs_table"_s);
+    q.BindValue(u":songs_table"_s, QStringLiteral("device_%1_songs").arg(id));
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
   t.Commit();
 
 }
@@ -97,6 +97,7 @@
 #include "covermanager/coverproviders.h"
 #include "covermanager/currentalbumcoverloader.h"
 #include "covermanager/albumcoverimageresult.h"
+#include "covermanager/covercacheindex.h"
 #include "edittagdialog.h"
 #include "ui_edittagdialog.h"
 
@@ -1342,6 +1343,7 @@ void EditTagDialog::SaveData() {
               const QString art_manual = ref.original_.art_manual().toLocalFile();
               if (QFile::exists(art_manual)) {
                 QFile::remove(art_manual);
+                CoverCacheIndex::RemoveFile(art_manual);
               }
             }
             ref.current_.clear_art_manual();
@@ -0,0 +1,391 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <cstring>
+#include <optional>
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QThread>
+#include <QList>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "core/logging.h"
+#include "core/signalchecker.h"
+
+#include "audioanalysis.h"
+
+#ifdef HAVE_CHROMAPRINT
+#  include "chromaprinter.h"
+#endif
+#ifdef HAVE_EBUR128
+#  include "ebur128analysis.h"
+#endif
+#ifdef HAVE_MOODBAR
+#  include "gstfastspectrum.h"
+#  include "moodbar/moodbarbuilder.h"
+#  include "moodbar/moodbarpipeline.h"
+#endif
+
+using namespace Qt::Literals::StringLiterals;
+using std::make_unique;
+
+namespace {
+
+constexpr int kFingerprintTimeoutSecs = 10;
+constexpr int kTimeoutSecs = 60;
+
+GstElement *CreateElement(const QString &factory_name, GstElement *bin) {
+
+  GstElement *ret = gst_element_factory_make(factory_name.toLatin1().constData(), nullptr);
+
+  if (ret && bin) gst_bin_add(GST_BIN(bin), ret);
+
+  if (!ret) {
+    qLog(Warning) << "Couldn't create the gstreamer element" << factory_name;
+  }
+
+  return ret;
+
+}
+
+// Creates a queue linked to the tee, followed by the given elements.
+// The queue gives each branch its own streaming thread.
+// Returns an empty list if an element could not be created.
+QList<GstElement*> CreateBranch(GstElement *pipeline, GstElement *tee, const QStringList &factory_names) {
+
+  QList<GstElement*> elements;
+  elements.reserve(factory_names.count() + 1);
+
+  GstElement *queue = CreateElement(u"queue2"_s, pipeline);
+  if (!queue) return QList<GstElement*>();
+
+  // Allow up to 60s of audio in each queue, and disable the default buffer and byte limits.
+  g_object_set(G_OBJECT(queue), "max-size-time", 60 * GST_SECOND, nullptr);
+  g_object_set(G_OBJECT(queue), "max-size-buffers", 0, nullptr);
+  g_object_set(G_OBJECT(queue), "max-size-bytes", 0, nullptr);
+
+  if (!gst_element_link(tee, queue)) {
+    qLog(Error) << "Failed to link queue to tee";
+    return QList<GstElement*>();
+  }
+  elements << queue;
+
+  for (const QString &factory_name : factory_names) {
+    GstElement *element = CreateElement(factory_name, pipeline);
+    if (!element || !gst_element_link(elements.last(), element)) {
+      return QList<GstElement*>();
+    }
+    elements << element;
+  }
+
+  return elements;
+
+}
+
+void SetNewSampleCallback(GstElement *sink, GstFlowReturn (*new_sample)(GstAppSink*, gpointer), gpointer self) {
+
+  GstAppSinkCallbacks callbacks;
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.new_sample = new_sample;
+  gst_app_sink_set_callbacks(reinterpret_cast<GstAppSink*>(sink), &callbacks, self, nullptr);
+  g_object_set(G_OBJECT(sink), "sync", FALSE, nullptr);
+  g_object_set(G_OBJECT(sink), "emit-signals", TRUE, nullptr);
+
+}
+
+#ifdef HAVE_CHROMAPRINT
+GstPadProbeReturn FingerprintProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer data) {
+
+  Q_UNUSED(pad)
+  Q_UNUSED(data)
+
+  // The fingerprint only uses the beginning of the song, so don't convert and resample the rest.
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+  if (buffer && GST_BUFFER_PTS_IS_VALID(buffer) && GST_BUFFER_PTS(buffer) >= static_cast<GstClockTime>(Chromaprinter::kPlayLengthSecs) * GST_SECOND) {
+    return GST_PAD_PROBE_DROP;
+  }
+
+  return GST_PAD_PROBE_OK;
+
+}
+#endif
+
+}  // namespace
+
+AudioAnalysis::AudioAnalysis(const QString &filename)
+    : filename_(filename),
+      fingerprint_enabled_(false),
+      ebur128_enabled_(false),
+      moodbar_enabled_(false),
+      tee_(nullptr) {}
+
+AudioAnalysis::~AudioAnalysis() = default;
+
+bool AudioAnalysis::CreateBranches(GstElement *pipeline) {
+
+#ifdef HAVE_CHROMAPRINT
+  if (fingerprint_enabled_) {
+    const QList<GstElement*> branch = CreateBranch(pipeline, tee_, QStringList() << u"audioconvert"_s << u"audioresample"_s);
+    GstElement *sink = CreateElement(u"appsink"_s, pipeline);
+    if (branch.isEmpty() || !sink) return false;
+
+    GstCaps *caps = Chromaprinter::Caps();
+    gst_element_link_filtered(branch.last(), sink, caps);
+    gst_caps_unref(caps);
+
+    GstPad *pad = gst_element_get_static_pad(branch.first(), "sink");
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, FingerprintProbeCallback, nullptr, nullptr);
+    gst_object_unref(pad);
+
+    SetNewSampleCallback(sink, FingerprintBufferCallback, this);
+  }
+#endif
+
+#ifdef HAVE_EBUR128
+  if (ebur128_enabled_) {
+    const QList<GstElement*> branch = CreateBranch(pipeline, tee_, QStringList() << u"audioconvert"_s);
+    GstElement *sink = CreateElement(u"appsink"_s, pipeline);
+    if (branch.isEmpty() || !sink) return false;
+
+    GstCaps *caps = EBUR128Accumulator::Caps();
+    gst_element_link_filtered(branch.last(), sink, caps);
+    gst_caps_unref(caps);
+
+    ebur128_accumulator_ = make_unique<EBUR128Accumulator>();
+    SetNewSampleCallback(sink, EBUR128BufferCallback, this);
+    g_object_set(G_OBJECT(sink), "buffer-list", FALSE, nullptr);
+    // Disable in-appsink buffering, since there is a queue in front of it.
+    g_object_set(G_OBJECT(sink), "max-buffers", 1, nullptr);
+  }
+#endif
+
+#ifdef HAVE_MOODBAR
+  if (moodbar_enabled_) {
+    const QList<GstElement*> branch = CreateBranch(pipeline, tee_, QStringList() << u"audioconvert"_s << u"strawberry-fastspectrum"_s << u"fakesink"_s);
+    if (branch.isEmpty()) return false;
+
+    moodbar_builder_ = make_unique<MoodbarBuilder>();
+
+    GstElement *spectrum = branch[branch.count() - 2];
+    g_object_set(spectrum, "bands", MoodbarPipeline::kBands, nullptr);
+    GstStrawberryFastSpectrum *fastspectrum = reinterpret_cast<GstStrawberryFastSpectrum*>(spectrum);
+    fastspectrum->output_callback = [this](double *magnitudes, const int size) { moodbar_builder_->AddFrame(magnitudes, size); };
+  }
+#endif
+
+  return true;
+
+}
+
+bool AudioAnalysis::Run() {
+
+  Q_ASSERT(QThread::currentThread() != qApp->thread());
+
+#ifndef HAVE_CHROMAPRINT
+  fingerprint_enabled_ = false;
+#endif
+#ifndef HAVE_EBUR128
+  ebur128_enabled_ = false;
+#endif
+#ifndef HAVE_MOODBAR
+  moodbar_enabled_ = false;
+#endif
+
+  if (!fingerprint_enabled_ && !ebur128_enabled_ && !moodbar_enabled_) return false;
+
+  GstElement *pipeline = gst_pipeline_new("audioanalysis-pipeline");
+  if (!pipeline) return false;
+
+  GstElement *src = CreateElement(u"filesrc"_s, pipeline);
+  GstElement *decode = CreateElement(u"decodebin"_s, pipeline);
+  tee_ = CreateElement(u"tee"_s, pipeline);
+
+  if (!src || !decode || !tee_ || !gst_element_link(src, decode) || !CreateBranches(pipeline)) {
+    gst_object_unref(pipeline);
+    tee_ = nullptr;
+    return false;
+  }
+
+  // Set the filename
+  g_object_set(src, "location", filename_.toUtf8().constData(), nullptr);
+
+  // Connect signals
+  GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline));
+  CHECKED_GCONNECT(decode, "pad-added", &NewPadCallback, this);
+
+  // The loudness and the moodbar need the whole song, the fingerprint only the beginning.
+  const bool decode_all = ebur128_enabled_ || moodbar_enabled_;
+  const int timeout_secs = decode_all ? kTimeoutSecs : kFingerprintTimeoutSecs;
+
+#ifdef HAVE_CHROMAPRINT
+  if (!decode_all) {
+    // Play only first x seconds
+    gst_element_set_state(pipeline, GST_STATE_PAUSED);
+    // wait for state change before seeking
+    gst_element_get_state(pipeline, nullptr, nullptr, timeout_secs * GST_SECOND);
+    gst_element_seek(pipeline, 1.0, GST_FORMAT_TIME, GST_SEEK_FLAG_FLUSH, GST_SEEK_TYPE_SET, 0 * GST_SECOND, GST_SEEK_TYPE_SET, Chromaprinter::kPlayLengthSecs * GST_SECOND);
+  }
+#endif
+
+  QElapsedTimer time;
+  time.start();
+
+  // Start playing
+  gst_element_set_state(pipeline, GST_STATE_PLAYING);
+
+  // Wait until EOS or error
+  bool success = false;
+  bool had_error = false;
+  GstMessage *msg = gst_bus_timed_pop_filtered(bus, timeout_secs * GST_SECOND, static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  if (msg) {
+    if (msg->type == GST_MESSAGE_ERROR) {
+      had_error = true;
+      // Report error
+      GError *error = nullptr;
+      gchar *debugs = nullptr;
+      gst_message_parse_error(msg, &error, &debugs);
+      if (error) {
+        QString message = QString::fromLocal8Bit(error->message);
+        g_error_free(error);
+        qLog(Debug) << "Error processing" << filename_ << ":" << message;
+      }
+      if (debugs) g_free(debugs);
+    }
+    else {
+      success = true;
+    }
+    gst_message_unref(msg);
+  }
+
+  const qint64 decode_time = time.restart();
+
+  // Stop the streaming threads before reading what they collected.
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+
+#ifdef HAVE_CHROMAPRINT
+  if (fingerprint_enabled_) {
+    fingerprint_ = Chromaprinter::FingerprintFromData(fingerprint_pcm_);
+    fingerprint_pcm_.clear();
+  }
+#endif
+
+#ifdef HAVE_EBUR128
+  if (ebur128_accumulator_ && !had_error) {
+    ebur128_measures_ = ebur128_accumulator_->Finalize();
+  }
+#endif
+
+#ifdef HAVE_MOODBAR
+  if (moodbar_builder_ && success) {
+    moodbar_data_ = moodbar_builder_->Finish(MoodbarPipeline::kWidth);
+  }
+#endif
+
+  qLog(Debug) << "Decode time:" << decode_time << "Analysis time:" << time.elapsed();
+
+  // Cleanup
+  gst_object_unref(bus);
+  gst_object_unref(pipeline);
+  tee_ = nullptr;
+
+  return success;
+
+}
+
+void AudioAnalysis::NewPadCallback(GstElement *element, GstPad *pad, gpointer self) {
+
+  Q_UNUSED(element)
+
+  AudioAnalysis *instance = reinterpret_cast<AudioAnalysis*>(self);
+  GstPad *const audiopad = gst_element_get_static_pad(instance->tee_, "sink");
+
+  if (GST_PAD_IS_LINKED(audiopad)) {
+    qLog(Warning) << "audiopad is already linked, unlinking old pad";
+    gst_pad_unlink(audiopad, GST_PAD_PEER(audiopad));
+  }
+
+  gst_pad_link(pad, audiopad);
+  gst_object_unref(audiopad);
+
+#ifdef HAVE_MOODBAR
+  if (instance->moodbar_builder_) {
+    int rate = 0;
+    GstCaps *caps = gst_pad_get_current_caps(pad);
+    if (caps) {
+      GstStructure *structure = gst_caps_get_structure(caps, 0);
+      if (structure) {
+        gst_structure_get_int(structure, "rate", &rate);
+      }
+      gst_caps_unref(caps);
+    }
+    instance->moodbar_builder_->Init(MoodbarPipeline::kBands, rate);
+  }
+#endif
+
+}
+
+GstFlowReturn AudioAnalysis::FingerprintBufferCallback(GstAppSink *app_sink, gpointer self) {
+
+  AudioAnalysis *instance = reinterpret_cast<AudioAnalysis*>(self);
+
+  GstSample *sample = gst_app_sink_pull_sample(app_sink);
+  if (!sample) return GST_FLOW_ERROR;
+  GstBuffer *buffer = gst_sample_get_buffer(sample);
+  if (buffer) {
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      instance->fingerprint_pcm_.append(reinterpret_cast<const char*>(map.data), static_cast<qsizetype>(map.size));
+      gst_buffer_unmap(buffer, &map);
+    }
+  }
+  gst_sample_unref(sample);
+
+  return GST_FLOW_OK;
+
+}
+
+GstFlowReturn AudioAnalysis::EBUR128BufferCallback(GstAppSink *app_sink, gpointer self) {
+
+#ifdef HAVE_EBUR128
+  AudioAnalysis *instance = reinterpret_cast<AudioAnalysis*>(self);
+
+  GstSample *sample = gst_app_sink_pull_sample(app_sink);
+  if (!sample) return GST_FLOW_ERROR;
+  const bool success = instance->ebur128_accumulator_->AddSample(sample);
+  gst_sample_unref(sample);
+
+  return success ? GST_FLOW_OK : GST_FLOW_ERROR;
+#else
+  Q_UNUSED(app_sink)
+  Q_UNUSED(self)
+  return GST_FLOW_ERROR;
+#endif
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIOANALYSIS_H
+#define AUDIOANALYSIS_H
+
+#include "config.h"
+
+#include <optional>
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include "includes/scoped_ptr.h"
+#include "ebur128measures.h"
+
+#ifdef HAVE_EBUR128
+class EBUR128Accumulator;
+#endif
+#ifdef HAVE_MOODBAR
+class MoodbarBuilder;
+#endif
+
+class AudioAnalysis {
+  // Decodes a file once and fans the PCM data out to each enabled analysis:
+  // the Chromaprint fingerprint, the EBU R 128 loudness characteristics and the moodbar.
+  // Every analysis is a branch behind its own queue, so they run in parallel on the same decoded stream.
+  // Analyses that are not compiled in are ignored.
+
+ public:
+  explicit AudioAnalysis(const QString &filename);
+  ~AudioAnalysis();
+
+  void set_fingerprint_enabled(const bool enabled) { fingerprint_enabled_ = enabled; }
+  void set_ebur128_enabled(const bool enabled) { ebur128_enabled_ = enabled; }
+  void set_moodbar_enabled(const bool enabled) { moodbar_enabled_ = enabled; }
+
+  // Runs the enabled analyses.
+  // This method is blocking, so you want to call it in another thread.
+  // Returns false if the file could not be decoded to the end.
+  bool Run();
+
+  // Empty if no fingerprint could be created.
+  QString fingerprint() const { return fingerprint_; }
+  std::optional<EBUR128Measures> ebur128_measures() const { return ebur128_measures_; }
+  // Empty if no moodbar could be created.
+  QByteArray moodbar_data() const { return moodbar_data_; }
+
+ private:
+  bool CreateBranches(GstElement *pipeline);
+
+  static void NewPadCallback(GstElement *element, GstPad *pad, gpointer self);
+  static GstFlowReturn FingerprintBufferCallback(GstAppSink *app_sink, gpointer self);
+  static GstFlowReturn EBUR128BufferCallback(GstAppSink *app_sink, gpointer self);
+
+ private:
+  QString filename_;
+  bool fingerprint_enabled_;
+  bool ebur128_enabled_;
+  bool moodbar_enabled_;
+
+  GstElement *tee_;
+
+  QByteArray fingerprint_pcm_;
+#ifdef HAVE_EBUR128
+  ScopedPtr<EBUR128Accumulator> ebur128_accumulator_;
+#endif
+#ifdef HAVE_MOODBAR
+  ScopedPtr<MoodbarBuilder> moodbar_builder_;
+#endif
+
+  QString fingerprint_;
+  std::optional<EBUR128Measures> ebur128_measures_;
+  QByteArray moodbar_data_;
+};
+
+#endif  // AUDIOANALYSIS_H
@@ -0,0 +1,130 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QIODevice>
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QCryptographicHash>
+
+#include "audiocontentkey.h"
+
+namespace {
+
+constexpr qint64 kBufferSize = 65536;
+constexpr qint64 kID3v2HeaderSize = 10;
+constexpr qint64 kID3v1Size = 128;
+constexpr qint64 kAPEFooterSize = 32;
+constexpr qint64 kFLACBlockHeaderSize = 4;
+
+quint32 ReadSyncSafeInteger(const QByteArray &data, const int offset) {
+
+  return (static_cast<quint32>(static_cast<uchar>(data[offset]) & 0x7F) << 21) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 1]) & 0x7F) << 14) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 2]) & 0x7F) << 7) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 3]) & 0x7F));
+
+}
+
+quint32 ReadLittleEndianInteger(const QByteArray &data, const int offset) {
+
+  return static_cast<quint32>(static_cast<uchar>(data[offset])) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 1])) << 8) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 2])) << 16) |
+         (static_cast<quint32>(static_cast<uchar>(data[offset + 3])) << 24);
+
+}
+
+QByteArray ReadAt(QFile &file, const qint64 position, const qint64 size) {
+
+  if (position < 0 || !file.seek(position)) return QByteArray();
+
+  return file.read(size);
+
+}
+
+}  // namespace
+
+QString AudioContentKey::FromFile(const QString &filename) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) return QString();
+
+  qint64 begin = 0;
+  qint64 end = file.size();
+
+  // ID3v2 tags at the beginning of the file.
+  Q_FOREVER {
+    const QByteArray header = ReadAt(file, begin, kID3v2HeaderSize);
+    if (header.size() != kID3v2HeaderSize || !header.startsWith("ID3")) break;
+    begin += kID3v2HeaderSize + ReadSyncSafeInteger(header, 6);
+    if (static_cast<uchar>(header[5]) & 0x10) {  // Footer present
+      begin += kID3v2HeaderSize;
+    }
+  }
+
+  // FLAC metadata blocks, the frames follow the last one.
+  if (ReadAt(file, begin, 4) == "fLaC") {
+    begin += 4;
+    bool last_block = false;
+    while (!last_block) {
+      const QByteArray header = ReadAt(file, begin, kFLACBlockHeaderSize);
+      if (header.size() != kFLACBlockHeaderSize) break;
+      last_block = (static_cast<uchar>(header[0]) & 0x80) != 0;
+      begin += kFLACBlockHeaderSize + ((static_cast<qint64>(static_cast<uchar>(header[1])) << 16) | (static_cast<qint64>(static_cast<uchar>(header[2])) << 8) | static_cast<qint64>(static_cast<uchar>(header[3])));
+    }
+  }
+
+  // ID3v1 and APE tags at the end of the file, in any order.
+  bool found_tag = true;
+  while (found_tag && end > begin) {
+    found_tag = false;
+    if (end - begin >= kID3v1Size && ReadAt(file, end - kID3v1Size, 3) == "TAG") {
+      end -= kID3v1Size;
+      found_tag = true;
+    }
+    const QByteArray footer = end - begin >= kAPEFooterSize ? ReadAt(file, end - kAPEFooterSize, kAPEFooterSize) : QByteArray();
+    if (footer.size() == kAPEFooterSize && footer.startsWith("APETAGEX")) {
+      // The tag size includes the footer, but not the header.
+      end -= ReadLittleEndianInteger(footer, 12);
+      if (static_cast<uchar>(footer[23]) & 0x80) {  // Header present
+        end -= kAPEFooterSize;
+      }
+      found_tag = true;
+    }
+  }
+
+  if (begin >= end || !file.seek(begin)) return QString();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  qint64 remaining = end - begin;
+  while (remaining > 0) {
+    const QByteArray data = file.read(qMin(remaining, kBufferSize));
+    if (data.isEmpty()) return QString();
+    hash.addData(data);
+    remaining -= data.size();
+  }
+  file.close();
+
+  return QString::number(end - begin) + QLatin1Char('-') + QString::fromLatin1(hash.result().toHex());
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIOCONTENTKEY_H
+#define AUDIOCONTENTKEY_H
+
+#include "config.h"
+
+#include <QString>
+
+class AudioContentKey {
+ public:
+  ~AudioContentKey() = delete;  // Do not construct variables of this class.
+
+  // Returns a key identifying the audio payload of a file: its size and a hash of its bytes.
+  // ID3v2, ID3v1 and APE tags and FLAC metadata blocks are skipped, so editing those tags keeps the key.
+  // For other formats the whole file is hashed.
+  // Returns an empty string if the file could not be read.
+  //
+  // This method reads the whole file, so you want to call it in another thread.
+  static QString FromFile(const QString &filename);
+};
+
+#endif  // AUDIOCONTENTKEY_H
@@ -48,10 +48,11 @@ using u_int32_t = unsigned int;
 namespace {
 constexpr int kDecodeRate = 11025;
 constexpr int kDecodeChannels = 1;
-constexpr int kPlayLengthSecs = 30;
 constexpr int kTimeoutSecs = 10;
 }  // namespace
 
+const int Chromaprinter::kPlayLengthSecs = 30;
+
 Chromaprinter::Chromaprinter(const QString &filename)
     : filename_(filename),
       convert_element_(nullptr) {}
@@ -100,8 +101,7 @@ QString Chromaprinter::CreateFingerprint() {
   gst_element_link_many(src, decode, nullptr);
   gst_element_link_many(convert, resample, nullptr);
 
-  // Chromaprint expects mono 16-bit ints at a sample rate of 11025Hz.
-  GstCaps *caps = gst_caps_new_simple("audio/x-raw", "format", G_TYPE_STRING, "S16LE", "channels", G_TYPE_INT, kDecodeChannels, "rate", G_TYPE_INT, kDecodeRate, nullptr);
+  GstCaps *caps = Caps();
   gst_element_link_filtered(resample, sink, caps);
   gst_caps_unref(caps);
 
@@ -154,11 +154,36 @@ QString Chromaprinter::CreateFingerprint() {
   buffer_.close();
 
   // Generate fingerprint from recorded buffer data
-  QByteArray data = buffer_.data();
+  const QString fingerprint = FingerprintFromData(buffer_.data());
+
+  const qint64 codegen_time = time.elapsed();
+
+  qLog(Debug) << "Decode time:" << decode_time << "Codegen time:" << codegen_time;
+
+  // Cleanup
+  callbacks.new_sample = nullptr;
+  gst_object_unref(bus);
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+  gst_object_unref(pipeline);
+
+  return fingerprint;
+
+}
+
+GstCaps *Chromaprinter::Caps() {
+
+  // Chromaprint expects mono 16-bit ints at a sample rate of 11025Hz.
+  return gst_caps_new_simple("audio/x-raw", "format", G_TYPE_STRING, "S16LE", "channels", G_TYPE_INT, kDecodeChannels, "rate", G_TYPE_INT, kDecodeRate, nullptr);
+
+}
+
+QString Chromaprinter::FingerprintFromData(const QByteArray &data) {
+
+  QByteArray pcm = data.left(static_cast<qsizetype>(kPlayLengthSecs) * kDecodeRate * kDecodeChannels * static_cast<qsizetype>(sizeof(int16_t)));
 
   ChromaprintContext *chromaprint = chromaprint_new(CHROMAPRINT_ALGORITHM_DEFAULT);
   chromaprint_start(chromaprint, kDecodeRate, kDecodeChannels);
-  chromaprint_feed(chromaprint, reinterpret_cast<int16_t*>(data.data()), static_cast<int>(data.size() / 2));
+  chromaprint_feed(chromaprint, reinterpret_cast<int16_t*>(pcm.data()), static_cast<int>(pcm.size() / 2));
   chromaprint_finish(chromaprint);
 
   u_int32_t *fprint = nullptr;
@@ -177,16 +202,6 @@ QString Chromaprinter::CreateFingerprint() {
   }
   chromaprint_free(chromaprint);
 
-  const qint64 codegen_time = time.elapsed();
-
-  qLog(Debug) << "Decode time:" << decode_time << "Codegen time:" << codegen_time;
-
-  // Cleanup
-  callbacks.new_sample = nullptr;
-  gst_object_unref(bus);
-  gst_element_set_state(pipeline, GST_STATE_NULL);
-  gst_object_unref(pipeline);
-
   return QString::fromUtf8(fingerprint);
 
 }
@@ -29,6 +29,7 @@
 #include <gst/app/gstappsink.h>
 
 #include <QBuffer>
+#include <QByteArray>
 #include <QString>
 
 class Chromaprinter {
@@ -46,6 +47,15 @@ class Chromaprinter {
   // Returns an empty string if no fingerprint could be created.
   QString CreateFingerprint();
 
+  // Only this many seconds from the beginning of the song are used for the fingerprint.
+  static const int kPlayLengthSecs;
+
+  // The PCM format Chromaprint expects, link the appsink with these caps.
+  static GstCaps *Caps();
+
+  // Creates a fingerprint from PCM data in the format of Caps(), at most kPlayLengthSecs of it are used.
+  static QString FingerprintFromData(const QByteArray &data);
+
  private:
   static GstElement *CreateElement(const QString &factory_name, GstElement *bin = nullptr);
 
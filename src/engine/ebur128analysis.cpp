@@ -48,6 +48,7 @@
 
 using namespace Qt::Literals::StringLiterals;
 using std::unique_ptr;
+using std::make_unique;
 
 namespace {
 
@@ -208,7 +209,7 @@ class EBUR128AnalysisImpl {
  private:
   GstElement *convert_element_ = nullptr;
 
-  std::optional<EBUR128State> state;
+  EBUR128Accumulator accumulator_;
 
   static void NewPadCallback(GstElement *elt, GstPad *pad, gpointer data);
   static GstFlowReturn NewBufferCallback(GstAppSink *app_sink, gpointer self);
@@ -359,24 +360,7 @@ GstFlowReturn EBUR128AnalysisImpl::NewBufferCallback(GstAppSink *app_sink, gpoin
   unique_ptr<GstSample, GstSampleDeleter> sample(gst_app_sink_pull_sample(app_sink));
   if (!sample) return GST_FLOW_ERROR;
 
-  const FrameFormat dsc(gst_sample_get_caps(&*sample));
-  if (!me->state) {
-    me->state.emplace(dsc);
-  }
-  else if (me->state->dsc != dsc) {
-    return GST_FLOW_ERROR;
-  }
-
-  GstBuffer *buffer = gst_sample_get_buffer(&*sample);
-  if (buffer) {
-    GstMapInfo map;
-    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
-      me->state->AddFrames(reinterpret_cast<const char*>(map.data), static_cast<size_t>(map.size));
-      gst_buffer_unmap(buffer, &map);
-    }
-  }
-
-  return GST_FLOW_OK;
+  return me->accumulator_.AddSample(&*sample) ? GST_FLOW_OK : GST_FLOW_ERROR;
 
 }
 
@@ -419,12 +403,7 @@ std::optional<EBUR128Measures> EBUR128AnalysisImpl::Compute(const Song &song) {
   // Connect the elements
   gst_element_link_many(src, decode, nullptr);
 
-  GstStaticCaps static_caps = GST_STATIC_CAPS(
-    "audio/x-raw,"
-    "format = (string) { S16LE, S32LE, F32LE, F64LE },"
-    "layout = (string) interleaved");
-
-  GstCaps *caps = gst_static_caps_get(&static_caps);
+  GstCaps *caps = EBUR128Accumulator::Caps();
   // Place a queue before the sink. It really does matter for performance.
   gst_element_link_filtered(convert, queue, caps);
   gst_element_link_many(queue, sink, nullptr);
@@ -491,13 +470,14 @@ std::optional<EBUR128Measures> EBUR128AnalysisImpl::Compute(const Song &song) {
   const qint64 decode_time = time.restart();
 
   std::optional<EBUR128Measures> result;
-  if (!hadError && impl.state) {
+  if (!hadError) {
     // Generate loudness characteristics from sampled data.
-    result = EBUR128State::Finalize(std::move(impl.state.value()));
+    result = impl.accumulator_.Finalize();
 
-    const qint64 finalize_time = time.elapsed();
-
-    qLog(Debug) << "Decode time:" << decode_time << "Finalization time:" << finalize_time;
+    if (result) {
+      const qint64 finalize_time = time.elapsed();
+      qLog(Debug) << "Decode time:" << decode_time << "Finalization time:" << finalize_time;
+    }
   }
 
   // Cleanup
@@ -519,3 +499,57 @@ std::optional<EBUR128Measures> EBUR128Analysis::Compute(const Song &song) {
   return EBUR128AnalysisImpl::Compute(song);
 
 }
+
+class EBUR128AccumulatorState {
+ public:
+  std::optional<EBUR128State> state;
+};
+
+EBUR128Accumulator::EBUR128Accumulator() : state_(make_unique<EBUR128AccumulatorState>()) {}
+
+EBUR128Accumulator::~EBUR128Accumulator() = default;
+
+GstCaps *EBUR128Accumulator::Caps() {
+
+  static GstStaticCaps static_caps = GST_STATIC_CAPS(
+    "audio/x-raw,"
+    "format = (string) { S16LE, S32LE, F32LE, F64LE },"
+    "layout = (string) interleaved");
+
+  return gst_static_caps_get(&static_caps);
+
+}
+
+bool EBUR128Accumulator::AddSample(GstSample *sample) {
+
+  const FrameFormat dsc(gst_sample_get_caps(sample));
+  if (!state_->state) {
+    state_->state.emplace(dsc);
+  }
+  else if (state_->state->dsc != dsc) {
+    return false;
+  }
+
+  GstBuffer *buffer = gst_sample_get_buffer(sample);
+  if (buffer) {
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      state_->state->AddFrames(reinterpret_cast<const char*>(map.data), static_cast<size_t>(map.size));
+      gst_buffer_unmap(buffer, &map);
+    }
+  }
+
+  return true;
+
+}
+
+std::optional<EBUR128Measures> EBUR128Accumulator::Finalize() {
+
+  if (!state_->state) return std::nullopt;
+
+  std::optional<EBUR128Measures> result = EBUR128State::Finalize(std::move(state_->state.value()));
+  state_->state.reset();
+
+  return result;
+
+}
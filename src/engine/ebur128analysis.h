@@ -24,6 +24,9 @@
 
 #include <optional>
 
+#include <gst/gst.h>
+
+#include "includes/scoped_ptr.h"
 #include "core/song.h"
 #include "ebur128measures.h"
 
@@ -38,4 +41,25 @@ class EBUR128Analysis {
   static std::optional<EBUR128Measures> Compute(const Song &song);
 };
 
+class EBUR128AccumulatorState;
+
+// Feeds decoded audio samples to libebur128, for analysing a branch of another pipeline.
+class EBUR128Accumulator {
+ public:
+  EBUR128Accumulator();
+  ~EBUR128Accumulator();
+
+  // The raw audio formats AddSample() accepts, link the appsink with these caps.
+  static GstCaps *Caps();
+
+  // Returns false if the sample format changed in the middle of the stream.
+  bool AddSample(GstSample *sample);
+
+  // Returns `std::nullopt` if no samples were added.
+  std::optional<EBUR128Measures> Finalize();
+
+ private:
+  ScopedPtr<EBUR128AccumulatorState> state_;
+};
+
 #endif  // EBUR128ANALYSIS_H
@@ -47,6 +47,7 @@ using namespace Qt::Literals::StringLiterals;
 EngineBase::EngineBase(QObject *parent)
     : QObject(parent),
       playbin3_enabled_(true),
+      reuse_audio_output_(false),
       exclusive_mode_(false),
       volume_control_(true),
       volume_(100),
@@ -158,6 +159,7 @@ void EngineBase::ReloadSettings() {
   }
 
   playbin3_enabled_ = s.value(BackendSettings::kPlaybin3, true).toBool();
+  reuse_audio_output_ = s.value(BackendSettings::kReuseAudioOutput, false).toBool();
 
   exclusive_mode_ = s.value(BackendSettings::kExclusiveMode, false).toBool();
 
@@ -183,6 +183,7 @@ class EngineBase : public QObject {
 
  protected:
   bool playbin3_enabled_;
+  bool reuse_audio_output_;
   bool exclusive_mode_;
   bool volume_control_;
   uint volume_;
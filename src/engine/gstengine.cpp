@@ -99,6 +99,7 @@ GstEngine::GstEngine(SharedPtr<TaskManager> task_manager, QObject *parent)
       task_manager_(task_manager),
       discoverer_(nullptr),
       buffering_task_id_(-1),
+      pipeline_settings_changed_(false),
       latest_buffer_(nullptr),
       stereo_balancer_enabled_(false),
       stereo_balance_(0.0F),
@@ -215,18 +216,27 @@ bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const Engine
     }
   }
 
-  GstEnginePipelinePtr pipeline = CreatePipeline(media_url, stream_url, gst_url, static_cast<qint64>(beginning_offset_nanosec), force_stop_at_end ? end_offset_nanosec : 0, ebur128_loudness_normalizing_gain_db_);
-  if (!pipeline) return false;
+  GstEnginePipelinePtr old_pipeline;
 
-  GstEnginePipelinePtr old_pipeline = current_pipeline_;
-  current_pipeline_ = pipeline;
+  // Without crossfading only the decoder needs to be replaced, so keep the audio output open and change the URL of the current pipeline.
+  const bool reuse_pipeline = !crossfade && reuse_audio_output_ && !pipeline_settings_changed_ && current_pipeline_ && current_pipeline_ != fadeout_pause_pipeline_ && !fadeout_pipelines_.contains(current_pipeline_->id());
+  if (reuse_pipeline && current_pipeline_->ChangeUrl(media_url, stream_url, gst_url, static_cast<qint64>(beginning_offset_nanosec), force_stop_at_end ? end_offset_nanosec : 0, ebur128_loudness_normalizing_gain_db_)) {
+    qLog(Debug) << "Reusing pipeline" << current_pipeline_->id() << "for" << gst_url;
+  }
+  else {
+    GstEnginePipelinePtr pipeline = CreatePipeline(media_url, stream_url, gst_url, static_cast<qint64>(beginning_offset_nanosec), force_stop_at_end ? end_offset_nanosec : 0, ebur128_loudness_normalizing_gain_db_);
+    if (!pipeline) return false;
 
-  if (old_pipeline) {
-    if (crossfade && !old_pipeline->exclusive_mode() && !AnyExclusivePipelineActive() && !fadeout_pipelines_.contains(old_pipeline->id())) {
-      StartFadeout(old_pipeline);
-    }
-    else {
-      FinishPipeline(old_pipeline);
+    old_pipeline = current_pipeline_;
+    current_pipeline_ = pipeline;
+
+    if (old_pipeline) {
+      if (crossfade && !old_pipeline->exclusive_mode() && !AnyExclusivePipelineActive() && !fadeout_pipelines_.contains(old_pipeline->id())) {
+        StartFadeout(old_pipeline);
+      }
+      else {
+        FinishPipeline(old_pipeline);
+      }
     }
   }
 
@@ -526,6 +536,8 @@ void GstEngine::ReloadSettings() {
 
   if (output_.isEmpty()) output_ = QLatin1String(kAutoSink);
 
+  pipeline_settings_changed_ = true;
+
 #ifdef HAVE_SPOTIFY
   if (current_pipeline_ && old_spotify_access_token != spotify_access_token_) {
     current_pipeline_->set_spotify_access_token(spotify_access_token_);
@@ -547,6 +559,7 @@ void GstEngine::ConsumeBuffer(GstBuffer *buffer, const int pipeline_id, const QS
 void GstEngine::SetStereoBalancerEnabled(const bool enabled) {
 
   stereo_balancer_enabled_ = enabled;
+  pipeline_settings_changed_ = true;
   if (current_pipeline_) current_pipeline_->set_stereo_balancer_enabled(enabled);
 
 }
@@ -561,6 +574,7 @@ void GstEngine::SetStereoBalance(const float value) {
 void GstEngine::SetEqualizerEnabled(const bool enabled) {
 
   equalizer_enabled_ = enabled;
+  pipeline_settings_changed_ = true;
   if (current_pipeline_) current_pipeline_->set_equalizer_enabled(enabled);
 
 }
@@ -908,6 +922,8 @@ void GstEngine::StopTimers() {
 
 GstEnginePipelinePtr GstEngine::CreatePipeline() {
 
+  pipeline_settings_changed_ = false;
+
   GstEnginePipelinePtr pipeline = GstEnginePipelinePtr(new GstEnginePipeline);
   pipeline->set_output_device(output_, device_);
   pipeline->set_playbin3_enabled(playbin3_enabled_);
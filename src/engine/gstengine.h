@@ -161,6 +161,9 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   GstEnginePipelinePtr fadeout_pause_pipeline_;
   QMap<int, GstEnginePipelinePtr> old_pipelines_;
 
+  // Set when settings used when building a pipeline changed, the current pipeline can't be reused then.
+  bool pipeline_settings_changed_;
+
   QList<GstBufferConsumer*> buffer_consumers_;
 
   GstBuffer *latest_buffer_;
@@ -23,6 +23,8 @@
 
 #include <QtGlobal>
 
+#include <algorithm>
+#include <iterator>
 #include <cstdint>
 #include <cstring>
 #include <cmath>
@@ -31,6 +33,7 @@
 #include <glib-object.h>
 #include <gst/gst.h>
 #include <gst/audio/audio.h>
+#include <gst/app/gstappsrc.h>
 
 #ifdef Q_OS_UNIX
 #  include <pthread.h>
@@ -52,6 +55,8 @@
 #include <QVariant>
 #include <QString>
 #include <QUrl>
+#include <QFileInfo>
+#include <QStorageInfo>
 #include <QTimer>
 #include <QTimeLine>
 #include <QEasingCurve>
@@ -61,14 +66,17 @@
 
 #include "core/logging.h"
 #include "core/signalchecker.h"
+#include "core/tracing.h"
 #include "constants/timeconstants.h"
 #include "constants/backendsettings.h"
 #include "gstengine.h"
 #include "gstenginepipeline.h"
 #include "gstbufferconsumer.h"
+#include "gstenginepreroll.h"
 
 using namespace std::chrono_literals;
 using namespace Qt::Literals::StringLiterals;
+using std::make_shared;
 
 #ifdef __clang__
 #  pragma clang diagnostic push
@@ -87,6 +95,12 @@ constexpr int kGstStateTimeoutNanosecs = 10000000;
 constexpr std::chrono::milliseconds kFaderFudgeMsec = 2000ms;
 constexpr std::chrono::milliseconds kFaderTimeoutMsec = 3000ms;
 
+// How much of the next track to fetch and decode ahead of the transition.
+constexpr quint64 kPrerollBufferDurationNanosec = 10 * kNsecPerSec;
+
+// File systems that are slow enough to benefit from prerolling the next track.
+constexpr const char *kNetworkFileSystems[] = { "nfs", "nfs4", "cifs", "smb3", "smbfs", "fuse.sshfs", "9p" };
+
 constexpr int kEqBandCount = 10;
 constexpr int kEqBandFrequencies[] = { 60, 170, 310, 600, 1000, 3000, 6000, 12000, 14000, 16000 };
 
@@ -137,6 +151,7 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       pipeline_connected_(false),
       pipeline_active_(false),
       buffering_(false),
+      buffering_start_usec_(-1),
       pending_state_(GST_STATE_NULL),
       pending_seek_nanosec_(-1),
       pending_seek_ready_previous_state_(GST_STATE_NULL),
@@ -144,6 +159,11 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       next_uri_set_(false),
       next_uri_need_reset_(false),
       next_uri_reset_(false),
+      last_buffer_end_running_time_(GST_CLOCK_TIME_NONE),
+      transition_pending_(false),
+      transition_prerolled_(false),
+      first_audio_output_reused_(false),
+      first_buffer_msec_(-1),
       volume_set_(false),
       volume_internal_(-1.0),
       volume_percent_(100),
@@ -211,6 +231,12 @@ GstEnginePipeline::~GstEnginePipeline() {
     audiobin_ = nullptr;
   }
 
+  {
+    QMutexLocker l(&mutex_preroll_);
+    preroll_next_.reset();
+    preroll_source_.reset();
+  }
+
   qLog(Debug) << "Pipeline" << id() << "deleted";
 
 }
@@ -405,6 +431,15 @@ void GstEnginePipeline::Disconnect() {
       buffer_probe_cb_id_.reset();
     }
 
+    if (transition_probe_cb_id_.has_value()) {
+      GstPad *pad = gst_element_get_static_pad(audioqueueconverter_, "src");
+      if (pad) {
+        gst_pad_remove_probe(pad, transition_probe_cb_id_.value());
+        gst_object_unref(pad);
+      }
+      transition_probe_cb_id_.reset();
+    }
+
     {
       GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
       if (bus) {
@@ -444,6 +479,8 @@ bool GstEnginePipeline::Finish() {
 
 bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 beginning_offset_nanosec, const qint64 end_offset_nanosec, const double ebur128_loudness_normalizing_gain_db, QString &error) {
 
+  StartFirstAudioTimer(false);
+
   {
     QMutexLocker l(&mutex_url_);
     media_url_ = media_url;
@@ -504,6 +541,78 @@ bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_ur
 
 }
 
+bool GstEnginePipeline::ChangeUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 beginning_offset_nanosec, const qint64 end_offset_nanosec, const double ebur128_loudness_normalizing_gain_db) {
+
+  if (!pipeline_ || !pipeline_connected_.value() || finish_requested_.value() || buffering_.value() || fader_active_.value() || set_state_in_progress_ > 0 || set_state_async_in_progress_ > 0) {
+    return false;
+  }
+
+  StartFirstAudioTimer(true);
+
+  // Going to READY stops decoding the old URL, but the audio bin stays linked and the output device stays open.
+  if (gst_element_set_state(pipeline_, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+    qLog(Error) << "Failed to set pipeline" << id() << "to READY for changing URL to" << gst_url;
+    return false;
+  }
+
+  {
+    QMutexLocker l(&mutex_url_);
+    media_url_ = media_url;
+    stream_url_ = stream_url;
+    gst_url_ = gst_url;
+  }
+
+  {
+    QMutexLocker l(&mutex_next_url_);
+    next_media_url_.clear();
+    next_stream_url_.clear();
+    next_gst_url_.clear();
+  }
+
+  {
+    QMutexLocker l(&mutex_preroll_);
+    preroll_next_.reset();
+    preroll_source_.reset();
+  }
+
+  {
+    QMutexLocker l(&mutex_redirect_url_);
+    redirect_url_.clear();
+  }
+
+  beginning_offset_nanosec_ = beginning_offset_nanosec;
+  end_offset_nanosec_ = end_offset_nanosec;
+  next_beginning_offset_nanosec_ = -1;
+  next_end_offset_nanosec_ = -1;
+  ignore_next_seek_ = false;
+  ignore_tags_ = false;
+  pending_state_ = GST_STATE_NULL;
+  pending_seek_nanosec_ = -1;
+  pending_seek_ready_previous_state_ = GST_STATE_NULL;
+  next_uri_set_ = false;
+  next_uri_need_reset_ = false;
+  next_uri_reset_ = false;
+  about_to_finish_ = false;
+  segment_start_ = 0;
+  segment_start_received_ = false;
+  last_known_position_ns_ = 0;
+
+  // No streaming threads are running in READY.
+  gst_segment_init(&transition_segment_, GST_FORMAT_TIME);
+  last_buffer_end_running_time_ = GST_CLOCK_TIME_NONE;
+  transition_pending_ = false;
+  transition_prerolled_ = false;
+
+  SetEBUR128LoudnessNormalizingGain_dB(ebur128_loudness_normalizing_gain_db);
+
+  g_object_set(G_OBJECT(pipeline_), "uri", gst_url.constData(), nullptr);
+
+  qLog(Debug) << "Pipeline" << id() << "changed URL to" << gst_url;
+
+  return true;
+
+}
+
 bool GstEnginePipeline::InitAudioBin(QString &error) {
 
   gst_segment_init(&last_playbin_segment_, GST_FORMAT_TIME);
@@ -911,6 +1020,8 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
     GstPad *pad = gst_element_get_static_pad(audioqueueconverter_, "src");
     if (pad) {
       buffer_probe_cb_id_ = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, BufferProbeCallback, this, nullptr);
+      gst_segment_init(&transition_segment_, GST_FORMAT_TIME);
+      transition_probe_cb_id_ = gst_pad_add_probe(pad, static_cast<GstPadProbeType>(GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM | GST_PAD_PROBE_TYPE_EVENT_FLUSH), TransitionProbeCallback, this, nullptr);
       gst_object_unref(pad);
     }
   }
@@ -1036,41 +1147,18 @@ void GstEnginePipeline::SourceSetupCallback(GstElement *playbin, GstElement *sou
 
   GstEnginePipeline *instance = reinterpret_cast<GstEnginePipeline*>(self);
 
+  SharedPtr<GstEnginePreroll> preroll;
   {
-    QMutexLocker l(&instance->mutex_source_device_);
-    if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "device") && !instance->source_device().isEmpty()) {
-      // Gstreamer is not able to handle device in URL (referring to Gstreamer documentation, this might be added in the future).
-      // Despite that, for now we include device inside URL: we decompose it during Init and set device here, when this callback is called.
-      qLog(Debug) << "Setting device";
-      g_object_set(source, "device", instance->source_device().toLocal8Bit().constData(), nullptr);
-    }
-  }
-
-  if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "user-agent")) {
-    qLog(Debug) << "Setting user-agent";
-    QString user_agent = QStringLiteral("%1 %2").arg(QCoreApplication::applicationName(), QCoreApplication::applicationVersion());
-    g_object_set(source, "user-agent", user_agent.toUtf8().constData(), nullptr);
+    QMutexLocker l(&instance->mutex_preroll_);
+    preroll = instance->preroll_source_;
+    instance->preroll_source_.reset();
   }
 
-  if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "ssl-strict")) {
-    qLog(Debug) << "Turning" << (instance->strict_ssl_enabled_.value() ? "on" : "off") << "strict SSL";
-    g_object_set(source, "ssl-strict", instance->strict_ssl_enabled_.value() ? TRUE : FALSE, nullptr);
+  if (preroll && GST_IS_APP_SRC(source)) {
+    GstEnginePreroll::AttachSource(preroll, source);
   }
-
-  {
-    QMutexLocker l(&instance->mutex_proxy_);
-    if (!instance->proxy_address_.isEmpty() && g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy")) {
-      qLog(Debug) << "Setting proxy to" << instance->proxy_address_;
-      g_object_set(source, "proxy", instance->proxy_address_.toUtf8().constData(), nullptr);
-      if (instance->proxy_authentication_ &&
-          g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy-id") &&
-          g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy-pw") &&
-          !instance->proxy_user_.isEmpty() &&
-          !instance->proxy_pass_.isEmpty())
-      {
-        g_object_set(source, "proxy-id", instance->proxy_user_.toUtf8().constData(), "proxy-pw", instance->proxy_pass_.toUtf8().constData(), nullptr);
-      }
-    }
+  else {
+    instance->SetupSource(source);
   }
 
 #ifdef HAVE_SPOTIFY
@@ -1099,6 +1187,57 @@ void GstEnginePipeline::SourceSetupCallback(GstElement *playbin, GstElement *sou
 
 }
 
+void GstEnginePipeline::PrerollSourceSetupCallback(GstElement *decodebin, GstElement *source, gpointer self) {
+
+  Q_UNUSED(decodebin)
+
+  GstEnginePipeline *instance = reinterpret_cast<GstEnginePipeline*>(self);
+
+  instance->SetupSource(source);
+
+}
+
+void GstEnginePipeline::SetupSource(GstElement *source) {
+
+  {
+    QMutexLocker l(&mutex_source_device_);
+    if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "device") && !source_device().isEmpty()) {
+      // Gstreamer is not able to handle device in URL (referring to Gstreamer documentation, this might be added in the future).
+      // Despite that, for now we include device inside URL: we decompose it during Init and set device here, when this callback is called.
+      qLog(Debug) << "Setting device";
+      g_object_set(source, "device", source_device().toLocal8Bit().constData(), nullptr);
+    }
+  }
+
+  if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "user-agent")) {
+    qLog(Debug) << "Setting user-agent";
+    QString user_agent = QStringLiteral("%1 %2").arg(QCoreApplication::applicationName(), QCoreApplication::applicationVersion());
+    g_object_set(source, "user-agent", user_agent.toUtf8().constData(), nullptr);
+  }
+
+  if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "ssl-strict")) {
+    qLog(Debug) << "Turning" << (strict_ssl_enabled_.value() ? "on" : "off") << "strict SSL";
+    g_object_set(source, "ssl-strict", strict_ssl_enabled_.value() ? TRUE : FALSE, nullptr);
+  }
+
+  {
+    QMutexLocker l(&mutex_proxy_);
+    if (!proxy_address_.isEmpty() && g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy")) {
+      qLog(Debug) << "Setting proxy to" << proxy_address_;
+      g_object_set(source, "proxy", proxy_address_.toUtf8().constData(), nullptr);
+      if (proxy_authentication_ &&
+          g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy-id") &&
+          g_object_class_find_property(G_OBJECT_GET_CLASS(source), "proxy-pw") &&
+          !proxy_user_.isEmpty() &&
+          !proxy_pass_.isEmpty())
+      {
+        g_object_set(source, "proxy-id", proxy_user_.toUtf8().constData(), "proxy-pw", proxy_pass_.toUtf8().constData(), nullptr);
+      }
+    }
+  }
+
+}
+
 void GstEnginePipeline::NotifyVolumeCallback(GstElement *element, GParamSpec *param_spec, gpointer self) {
 
   Q_UNUSED(element)
@@ -1358,6 +1497,54 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
 
 }
 
+GstPadProbeReturn GstEnginePipeline::TransitionProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self) {
+
+  Q_UNUSED(pad)
+
+  GstEnginePipeline *instance = reinterpret_cast<GstEnginePipeline*>(self);
+
+  const GstPadProbeType info_type = GST_PAD_PROBE_INFO_TYPE(info);
+
+  if (info_type & GST_PAD_PROBE_TYPE_BUFFER) {
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (!GST_BUFFER_PTS_IS_VALID(buffer)) return GST_PAD_PROBE_OK;
+    const GstClockTime running_time = gst_segment_to_running_time(&instance->transition_segment_, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer));
+    if (!GST_CLOCK_TIME_IS_VALID(running_time)) return GST_PAD_PROBE_OK;
+    if (instance->first_buffer_msec_.value() == -1) {
+      QMutexLocker l(&instance->mutex_first_audio_);
+      if (instance->first_audio_timer_.isValid()) {
+        instance->first_buffer_msec_ = instance->first_audio_timer_.elapsed();
+      }
+    }
+    if (instance->transition_pending_) {
+      instance->transition_pending_ = false;
+      instance->ReportTransition(running_time);
+    }
+    instance->last_buffer_end_running_time_ = running_time + (GST_BUFFER_DURATION_IS_VALID(buffer) ? GST_BUFFER_DURATION(buffer) : 0);
+  }
+  else {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT(info);
+    switch (GST_EVENT_TYPE(event)) {
+      case GST_EVENT_SEGMENT:
+        gst_event_copy_segment(event, &instance->transition_segment_);
+        break;
+      case GST_EVENT_STREAM_START:
+        // Only measure transitions from a track that was playing, not the start of playback.
+        instance->transition_pending_ = GST_CLOCK_TIME_IS_VALID(instance->last_buffer_end_running_time_);
+        break;
+      case GST_EVENT_FLUSH_STOP:
+        instance->last_buffer_end_running_time_ = GST_CLOCK_TIME_NONE;
+        instance->transition_pending_ = false;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return GST_PAD_PROBE_OK;
+
+}
+
 void GstEnginePipeline::AboutToFinishCallback(GstPlayBin *playbin, gpointer self) {
 
   Q_UNUSED(playbin)
@@ -1502,6 +1689,49 @@ void GstEnginePipeline::StreamStartMessageReceived() {
 
 }
 
+void GstEnginePipeline::ReportTransition(const GstClockTime running_time) {
+
+  // The first buffer of the new track should start exactly where the last buffer of the previous track ended.
+  const qint64 discontinuity_nanosec = static_cast<qint64>(running_time) - static_cast<qint64>(last_buffer_end_running_time_);
+
+  // It also needs to get here before it's due to be played, otherwise the audio sink runs dry.
+  qint64 late_nanosec = 0;
+  if (GST_STATE(pipeline_) == GST_STATE_PLAYING) {
+    GstClock *clock = gst_element_get_clock(pipeline_);
+    if (clock) {
+      const GstClockTime now = gst_clock_get_time(clock) - gst_element_get_base_time(pipeline_);
+      late_nanosec = static_cast<qint64>(now) - static_cast<qint64>(running_time);
+      gst_object_unref(clock);
+    }
+  }
+
+  const qint64 gap_nanosec = std::max<qint64>(0, discontinuity_nanosec) + std::max<qint64>(0, late_nanosec);
+
+  qLog(Info) << "Pipeline" << id() << "transition" << (transition_prerolled_.value() ? "from preroll" : "from URL") << "gap:" << static_cast<double>(gap_nanosec) / kNsecPerMsec << "ms, discontinuity:" << static_cast<double>(discontinuity_nanosec) / kNsecPerMsec << "ms, arrived" << static_cast<double>(-late_nanosec) / kNsecPerMsec << "ms before it was due";
+
+}
+
+void GstEnginePipeline::StartFirstAudioTimer(const bool audio_output_reused) {
+
+  QMutexLocker l(&mutex_first_audio_);
+  first_audio_timer_.start();
+  first_audio_output_reused_ = audio_output_reused;
+  first_buffer_msec_ = -1;
+
+}
+
+void GstEnginePipeline::ReportFirstAudio() {
+
+  // The state change is received both from the sync handler and the bus watch, only report it once.
+  QMutexLocker l(&mutex_first_audio_);
+  if (!first_audio_timer_.isValid()) return;
+
+  qLog(Info) << "Pipeline" << id() << (first_audio_output_reused_ ? "with reused audio output" : "with new audio output") << "started playing after" << first_audio_timer_.elapsed() << "ms, first buffer decoded after" << first_buffer_msec_.value() << "ms";
+
+  first_audio_timer_.invalidate();
+
+}
+
 void GstEnginePipeline::TaskEnterCallback(GstTask *task, GThread *thread, gpointer self) {
 
   Q_UNUSED(task)
@@ -1690,9 +1920,17 @@ void GstEnginePipeline::StateChangedMessageReceived(GstMessage *msg) {
     SetVolume(volume_percent_.value());
   }
 
+  if (new_state == GST_STATE_PLAYING) {
+    ReportFirstAudio();
+  }
+
   if (next_uri_set_.value() && next_uri_need_reset_.value() && new_state == GST_STATE_READY && pending_seek_nanosec_.value() != -1) {
     qLog(Debug) << "Reverting next uri and going to pause state.";
     next_uri_set_ = false;
+    {
+      QMutexLocker l(&mutex_preroll_);
+      preroll_source_.reset();
+    }
     {
       QMutexLocker l(&mutex_url_);
       g_object_set(G_OBJECT(pipeline_), "uri", gst_url_.constData(), nullptr);
@@ -1728,12 +1966,18 @@ void GstEnginePipeline::BufferingMessageReceived(GstMessage *msg) {
 
   int percent = 0;
   gst_message_parse_buffering(msg, &percent);
+  tracing::SetCounter("engine", "Buffer percent", percent);
 
   const GstState current_state = state();
 
   if (percent < 100 && !buffering_.value()) {
     qLog(Debug) << "Buffering started";
     buffering_ = true;
+    if (tracing::IsEnabled()) {
+      buffering_start_usec_ = tracing::NowUsec();
+      // Buffering while playing means the queue ran empty.
+      if (current_state == GST_STATE_PLAYING) tracing::IncrementCounter("engine", "Buffer underruns");
+    }
     Q_EMIT BufferingStarted();
     if (current_state == GST_STATE_PLAYING) {
       SetStateAsync(GST_STATE_PAUSED);
@@ -1745,6 +1989,10 @@ void GstEnginePipeline::BufferingMessageReceived(GstMessage *msg) {
   else if (percent == 100 && buffering_.value()) {
     qLog(Debug) << "Buffering finished";
     buffering_ = false;
+    if (buffering_start_usec_ >= 0) {
+      tracing::AddDuration("engine", "Buffering", buffering_start_usec_, tracing::NowUsec() - buffering_start_usec_);
+      buffering_start_usec_ = -1;
+    }
     Q_EMIT BufferingFinished();
     if (pending_seek_nanosec_.value() != -1 && !next_uri_need_reset_.value()) {
       ProcessPendingSeek(state());
@@ -1869,7 +2117,12 @@ QFuture<GstStateChangeReturn> GstEnginePipeline::Play(const bool pause, const qu
     pending_seek_nanosec_ = static_cast<qint64>(offset_nanosec);
   }
 
-  if (!pause) {
+  if (pause) {
+    // Only measure until playback starts when it was requested.
+    QMutexLocker l(&mutex_first_audio_);
+    first_audio_timer_.invalidate();
+  }
+  else {
     pending_state_ = GST_STATE_PLAYING;
   }
 
@@ -2183,6 +2436,10 @@ void GstEnginePipeline::PrepareNextUrl(const QUrl &media_url, const QUrl &stream
   next_beginning_offset_nanosec_ = beginning_offset_nanosec;
   next_end_offset_nanosec_ = end_offset_nanosec;
 
+  if (!HasMatchingNextUrl() && ShouldPreroll(stream_url)) {
+    StartPreroll(media_url, gst_url);
+  }
+
   if (about_to_finish_.value()) {
     SetNextUrl();
   }
@@ -2197,14 +2454,66 @@ void GstEnginePipeline::SetNextUrl() {
     next_uri_set_ = true;
     {
       QMutexLocker l(&mutex_next_url_);
-      qLog(Debug) << "Setting next URL to" << next_gst_url_;
-      g_object_set(G_OBJECT(pipeline_), "uri", next_gst_url_.constData(), nullptr);
+      QMutexLocker l_preroll(&mutex_preroll_);
+      // Play the next track from the preroll buffer if it was fetched ahead, so the transition doesn't wait for the network.
+      if (preroll_next_ && preroll_next_->gst_url() == next_gst_url_ && preroll_next_->is_usable()) {
+        qLog(Debug) << "Setting next URL to" << next_gst_url_ << "from preroll with" << preroll_next_->buffered_nanosec() / kNsecPerMsec << "ms buffered";
+        preroll_source_ = preroll_next_;
+        transition_prerolled_ = true;
+        g_object_set(G_OBJECT(pipeline_), "uri", GstEnginePreroll::kUri, nullptr);
+      }
+      else {
+        qLog(Debug) << "Setting next URL to" << next_gst_url_;
+        transition_prerolled_ = false;
+        g_object_set(G_OBJECT(pipeline_), "uri", next_gst_url_.constData(), nullptr);
+      }
+      preroll_next_.reset();
     }
     about_to_finish_ = false;
   }
 
 }
 
+bool GstEnginePipeline::ShouldPreroll(const QUrl &stream_url) const {
+
+  // Streams from the network, this includes the streaming services.
+  if (stream_url.scheme() == "http"_L1 || stream_url.scheme() == "https"_L1 || stream_url.scheme() == "smb"_L1 || stream_url.scheme() == "sftp"_L1) {
+    return true;
+  }
+
+  // Files on network shares.
+  if (stream_url.isLocalFile()) {
+    const QStorageInfo storage_info(QFileInfo(stream_url.toLocalFile()).absolutePath());
+    if (storage_info.isValid()) {
+      const QByteArray file_system_type = storage_info.fileSystemType();
+      return std::any_of(std::begin(kNetworkFileSystems), std::end(kNetworkFileSystems), [&file_system_type](const char *network_file_system) { return file_system_type == network_file_system; });
+    }
+  }
+
+  return false;
+
+}
+
+void GstEnginePipeline::StartPreroll(const QUrl &media_url, const QByteArray &gst_url) {
+
+  {
+    QMutexLocker l(&mutex_preroll_);
+    if (preroll_next_ && preroll_next_->gst_url() == gst_url) return;
+    preroll_next_.reset();
+  }
+
+  SharedPtr<GstEnginePreroll> preroll = make_shared<GstEnginePreroll>(gst_url);
+  QString error;
+  if (!preroll->Start(kPrerollBufferDurationNanosec, &PrerollSourceSetupCallback, this, error)) {
+    qLog(Error) << "Failed to preroll" << media_url << error;
+    return;
+  }
+
+  QMutexLocker l(&mutex_preroll_);
+  preroll_next_ = preroll;
+
+}
+
 void GstEnginePipeline::SetSourceDevice(const QString &device) {
 
   QMutexLocker l(&mutex_source_device_);
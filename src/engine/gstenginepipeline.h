@@ -34,6 +34,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QMutex>
+#include <QElapsedTimer>
 #include <QThreadPool>
 #include <QFuture>
 #include <QTimeLine>
@@ -51,6 +52,7 @@
 
 class QTimer;
 class GstBufferConsumer;
+class GstEnginePreroll;
 struct GstPlayBin;
 
 class GstEnginePipeline : public QObject {
@@ -89,6 +91,10 @@ class GstEnginePipeline : public QObject {
   // Creates the pipeline, returns false on error
   bool InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 beginning_offset_nanosec, const qint64 end_offset_nanosec, const double ebur128_loudness_normalizing_gain_db, QString &error);
 
+  // Replaces the URL of an initialized pipeline, keeping the audio bin and the output open.
+  // Returns false if the pipeline can't be reused right now, create a new pipeline instead.
+  bool ChangeUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 beginning_offset_nanosec, const qint64 end_offset_nanosec, const double ebur128_loudness_normalizing_gain_db);
+
   // GstBufferConsumers get fed audio data.  Thread-safe.
   void AddBufferConsumer(GstBufferConsumer *consumer);
   void RemoveBufferConsumer(GstBufferConsumer *consumer);
@@ -174,6 +180,8 @@ class GstEnginePipeline : public QObject {
   static void ElementRemovedCallback(GstBin *bin, GstBin *sub_bin, GstElement *element, gpointer self);
   static void PadAddedCallback(GstElement *element, GstPad *pad, gpointer self);
   static void SourceSetupCallback(GstElement *playbin, GstElement *source, gpointer self);
+  static void PrerollSourceSetupCallback(GstElement *decodebin, GstElement *source, gpointer self);
+  static GstPadProbeReturn TransitionProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self);
   static void NotifyVolumeCallback(GstElement *element, GParamSpec *param_spec, gpointer self);
   static void AboutToFinishCallback(GstPlayBin *playbin, gpointer self);
   static GstBusSyncReply BusSyncCallback(GstBus *bus, GstMessage *msg, gpointer self);
@@ -188,6 +196,13 @@ class GstEnginePipeline : public QObject {
   void StreamStatusMessageReceived(GstMessage *msg);
   void StreamStartMessageReceived();
 
+  void SetupSource(GstElement *source);
+  bool ShouldPreroll(const QUrl &stream_url) const;
+  void StartPreroll(const QUrl &media_url, const QByteArray &gst_url);
+  void ReportTransition(const GstClockTime running_time);
+  void StartFirstAudioTimer(const bool audio_output_reused);
+  void ReportFirstAudio();
+
   static QString ParseStrTag(GstTagList *list, const char *tag);
   static guint ParseUIntTag(GstTagList *list, const char *tag);
 
@@ -287,6 +302,11 @@ class GstEnginePipeline : public QObject {
   QByteArray next_gst_url_;
   mutable QMutex mutex_next_url_;
 
+  // The next track is fetched and decoded ahead into preroll_next_, and handed to playbin's appsrc through preroll_source_ when the transition starts.
+  SharedPtr<GstEnginePreroll> preroll_next_;
+  SharedPtr<GstEnginePreroll> preroll_source_;
+  QMutex mutex_preroll_;
+
   double ebur128_loudness_normalizing_gain_db_;
 
   // These get called when there is a new audio buffer available
@@ -324,6 +344,7 @@ class GstEnginePipeline : public QObject {
   mutex_protected<bool> pipeline_connected_;
   mutex_protected<bool> pipeline_active_;
   mutex_protected<bool> buffering_;
+  qint64 buffering_start_usec_;
 
   mutex_protected<GstState> pending_state_;
   mutex_protected<qint64> pending_seek_nanosec_;
@@ -339,6 +360,18 @@ class GstEnginePipeline : public QObject {
   mutex_protected<bool> next_uri_need_reset_;
   mutex_protected<bool> next_uri_reset_;
 
+  // Measures the gap between the last buffer of a track and the first buffer of the next track.
+  GstSegment transition_segment_{};
+  GstClockTime last_buffer_end_running_time_;
+  bool transition_pending_;
+  mutex_protected<bool> transition_prerolled_;
+
+  // Measures the time from loading a URL until the pipeline is playing it.
+  QMutex mutex_first_audio_;
+  QElapsedTimer first_audio_timer_;
+  bool first_audio_output_reused_;
+  mutex_protected<qint64> first_buffer_msec_;
+
   mutex_protected<bool> volume_set_;
   mutex_protected<gdouble> volume_internal_;
   mutex_protected<uint> volume_percent_;
@@ -366,6 +399,7 @@ class GstEnginePipeline : public QObject {
 
   std::optional<gulong> upstream_events_probe_cb_id_;
   std::optional<gulong> buffer_probe_cb_id_;
+  std::optional<gulong> transition_probe_cb_id_;
   std::optional<gulong> pad_probe_cb_id_;
   std::optional<gulong> element_added_cb_id_;
   std::optional<gulong> element_removed_cb_id_;
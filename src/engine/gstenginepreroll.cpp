@@ -0,0 +1,324 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QByteArray>
+#include <QString>
+
+#include "includes/shared_ptr.h"
+#include "core/logging.h"
+#include "core/signalchecker.h"
+#include "gstenginepreroll.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+const char *GstEnginePreroll::kUri = "appsrc://";
+
+namespace {
+
+// How long to wait for the decoder before checking if the appsrc is flushing.
+constexpr GstClockTime kPullTimeoutNanosec = 100 * GST_MSECOND;
+
+GstElement *CreateElement(const QString &factory_name, GstElement *bin) {
+
+  GstElement *ret = gst_element_factory_make(factory_name.toLatin1().constData(), nullptr);
+
+  if (ret && bin) gst_bin_add(GST_BIN(bin), ret);
+
+  if (!ret) {
+    qLog(Warning) << "Couldn't create the gstreamer element" << factory_name;
+  }
+
+  return ret;
+
+}
+
+}  // namespace
+
+GstEnginePreroll::GstEnginePreroll(const QByteArray &gst_url)
+    : gst_url_(gst_url),
+      pipeline_(nullptr),
+      queue_(nullptr),
+      appsink_(nullptr),
+      error_(false),
+      started_(false),
+      tags_(nullptr),
+      tags_sent_(false) {}
+
+GstEnginePreroll::~GstEnginePreroll() {
+
+  if (pipeline_) {
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+    if (bus) {
+      gst_bus_set_sync_handler(bus, nullptr, nullptr, nullptr);
+      gst_object_unref(bus);
+    }
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+  }
+
+  if (tags_) {
+    gst_tag_list_unref(tags_);
+    tags_ = nullptr;
+  }
+
+}
+
+bool GstEnginePreroll::Start(const quint64 max_buffer_nanosec, SourceSetupCallback source_setup_callback, gpointer source_setup_data, QString &error) {
+
+  pipeline_ = gst_pipeline_new("preroll");
+
+  GstElement *decodebin = CreateElement(u"uridecodebin"_s, pipeline_);
+  queue_ = CreateElement(u"queue"_s, pipeline_);
+  appsink_ = CreateElement(u"appsink"_s, pipeline_);
+  if (!decodebin || !queue_ || !appsink_) {
+    error = u"Failed to create preroll elements."_s;
+    return false;
+  }
+
+  // Only decode audio, and keep the decoder's format, playbin converts it like any other stream.
+  GstCaps *caps = gst_caps_new_empty_simple("audio/x-raw");
+  g_object_set(G_OBJECT(decodebin), "uri", gst_url_.constData(), "caps", caps, nullptr);
+  gst_caps_unref(caps);
+
+  // Only buffer based on time, the decoder blocks when the queue is full, which bounds the buffer.
+  g_object_set(G_OBJECT(queue_), "max-size-buffers", 0, nullptr);
+  g_object_set(G_OBJECT(queue_), "max-size-bytes", 0, nullptr);
+  g_object_set(G_OBJECT(queue_), "max-size-time", max_buffer_nanosec, nullptr);
+  g_object_set(G_OBJECT(appsink_), "sync", FALSE, "max-buffers", 1U, "drop", FALSE, nullptr);
+
+  if (!gst_element_link(queue_, appsink_)) {
+    error = u"Failed to link preroll queue to appsink."_s;
+    return false;
+  }
+
+  CHECKED_GCONNECT(G_OBJECT(decodebin), "pad-added", &PadAddedCallback, this);
+
+  {
+    GstPad *pad = gst_element_get_static_pad(appsink_, "sink");
+    if (pad) {
+      gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM, &EventProbeCallback, this, nullptr);
+      gst_object_unref(pad);
+    }
+  }
+
+  {
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+    if (bus) {
+      gst_bus_set_sync_handler(bus, &BusSyncCallback, this, nullptr);
+      gst_object_unref(bus);
+    }
+  }
+
+  // The source is created while going to PAUSED, so the callback is only needed for the state change.
+  const gulong source_setup_cb_id = CHECKED_GCONNECT(G_OBJECT(decodebin), "source-setup", source_setup_callback, source_setup_data);
+  const GstStateChangeReturn state_change_return = gst_element_set_state(pipeline_, GST_STATE_PLAYING);
+  g_signal_handler_disconnect(G_OBJECT(decodebin), source_setup_cb_id);
+
+  if (state_change_return == GST_STATE_CHANGE_FAILURE) {
+    error = u"Failed to start preroll pipeline."_s;
+    return false;
+  }
+
+  qLog(Debug) << "Started preroll of" << gst_url_;
+
+  return true;
+
+}
+
+quint64 GstEnginePreroll::buffered_nanosec() const {
+
+  if (!queue_) return 0;
+
+  guint64 level = 0;
+  g_object_get(G_OBJECT(queue_), "current-level-time", &level, nullptr);
+
+  return level;
+
+}
+
+void GstEnginePreroll::AttachSource(SharedPtr<GstEnginePreroll> preroll, GstElement *appsrc) {
+
+  g_object_set(G_OBJECT(appsrc), "format", GST_FORMAT_TIME, "stream-type", GST_APP_STREAM_TYPE_SEEKABLE, nullptr);
+
+  {
+    GstPad *pad = gst_element_get_static_pad(preroll->appsink_, "sink");
+    if (pad) {
+      GstCaps *caps = gst_pad_get_current_caps(pad);
+      if (caps) {
+        gst_app_src_set_caps(GST_APP_SRC(appsrc), caps);
+        gst_caps_unref(caps);
+      }
+      gst_object_unref(pad);
+    }
+  }
+
+  gint64 duration = 0;
+  if (gst_element_query_duration(preroll->pipeline_, GST_FORMAT_TIME, &duration) && duration > 0) {
+    gst_app_src_set_duration(GST_APP_SRC(appsrc), static_cast<GstClockTime>(duration));
+  }
+
+  qLog(Debug) << "Playing" << preroll->gst_url_ << "from preroll with" << preroll->buffered_nanosec() / GST_MSECOND << "ms buffered";
+
+  GstAppSrcCallbacks callbacks{};
+  callbacks.need_data = &NeedDataCallback;
+  callbacks.seek_data = &SeekDataCallback;
+  gst_app_src_set_callbacks(GST_APP_SRC(appsrc), &callbacks, new SharedPtr<GstEnginePreroll>(preroll), &DestroyCallback);
+
+}
+
+void GstEnginePreroll::PadAddedCallback(GstElement *element, GstPad *pad, gpointer self) {
+
+  Q_UNUSED(element)
+
+  GstEnginePreroll *instance = reinterpret_cast<GstEnginePreroll*>(self);
+
+  GstPad *const queue_pad = gst_element_get_static_pad(instance->queue_, "sink");
+
+  if (GST_PAD_IS_LINKED(queue_pad)) {
+    qLog(Warning) << "Preroll of" << instance->gst_url_ << "has more than one audio stream, using the first";
+  }
+  else if (gst_pad_link(pad, queue_pad) != GST_PAD_LINK_OK) {
+    qLog(Error) << "Failed to link preroll decoder for" << instance->gst_url_;
+    instance->error_ = true;
+  }
+
+  gst_object_unref(queue_pad);
+
+}
+
+GstPadProbeReturn GstEnginePreroll::EventProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self) {
+
+  Q_UNUSED(pad)
+
+  GstEnginePreroll *instance = reinterpret_cast<GstEnginePreroll*>(self);
+
+  GstEvent *event = GST_PAD_PROBE_INFO_EVENT(info);
+  if (GST_EVENT_TYPE(event) == GST_EVENT_TAG) {
+    GstTagList *tags = nullptr;
+    gst_event_parse_tag(event, &tags);
+    QMutexLocker l(&instance->mutex_tags_);
+    if (instance->tags_) {
+      gst_tag_list_insert(instance->tags_, tags, GST_TAG_MERGE_REPLACE);
+    }
+    else {
+      instance->tags_ = gst_tag_list_copy(tags);
+    }
+  }
+
+  return GST_PAD_PROBE_OK;
+
+}
+
+GstBusSyncReply GstEnginePreroll::BusSyncCallback(GstBus *bus, GstMessage *msg, gpointer self) {
+
+  Q_UNUSED(bus)
+
+  GstEnginePreroll *instance = reinterpret_cast<GstEnginePreroll*>(self);
+
+  if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR) {
+    GError *error = nullptr;
+    gchar *debugs = nullptr;
+    gst_message_parse_error(msg, &error, &debugs);
+    qLog(Error) << "Preroll of" << instance->gst_url_ << "failed:" << QString::fromUtf8(error->message);
+    g_error_free(error);
+    g_free(debugs);
+    instance->error_ = true;
+  }
+
+  return GST_BUS_DROP;
+
+}
+
+void GstEnginePreroll::NeedDataCallback(GstAppSrc *appsrc, guint length, gpointer data) {
+
+  Q_UNUSED(length)
+
+  GstEnginePreroll *instance = reinterpret_cast<SharedPtr<GstEnginePreroll>*>(data)->get();
+
+  if (!instance->tags_sent_) {
+    instance->tags_sent_ = true;
+    GstTagList *tags = nullptr;
+    {
+      QMutexLocker l(&instance->mutex_tags_);
+      if (instance->tags_) tags = gst_tag_list_copy(instance->tags_);
+    }
+    if (tags) {
+      // The appsrc inserts the tags into the data flow in front of the next buffer.
+      gst_element_send_event(GST_ELEMENT(appsrc), gst_event_new_tag(tags));
+    }
+  }
+
+  // Wait for the decoder, but give up when the appsrc is flushing, otherwise it can't seek or stop.
+  GstPad *pad = gst_element_get_static_pad(GST_ELEMENT(appsrc), "src");
+  GstSample *sample = nullptr;
+  bool flushing = false;
+  while (!sample && !instance->error_.value() && !gst_app_sink_is_eos(GST_APP_SINK(instance->appsink_))) {
+    flushing = GST_PAD_IS_FLUSHING(pad);
+    if (flushing) break;
+    sample = gst_app_sink_try_pull_sample(GST_APP_SINK(instance->appsink_), kPullTimeoutNanosec);
+  }
+  gst_object_unref(pad);
+
+  if (sample) {
+    instance->started_ = true;
+    gst_app_src_push_sample(appsrc, sample);
+    gst_sample_unref(sample);
+  }
+  else if (!flushing) {
+    gst_app_src_end_of_stream(appsrc);
+  }
+
+}
+
+gboolean GstEnginePreroll::SeekDataCallback(GstAppSrc *appsrc, guint64 offset, gpointer data) {
+
+  Q_UNUSED(appsrc)
+
+  GstEnginePreroll *instance = reinterpret_cast<SharedPtr<GstEnginePreroll>*>(data)->get();
+
+  // The appsrc seeks to the start before it starts, keep the buffered audio for that.
+  if (offset == 0 && !instance->started_.value()) {
+    return TRUE;
+  }
+
+  qLog(Debug) << "Seeking preroll of" << instance->gst_url_ << "to" << offset;
+
+  instance->started_ = true;
+
+  return gst_element_seek_simple(instance->pipeline_, GST_FORMAT_TIME, static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE), static_cast<gint64>(offset));
+
+}
+
+void GstEnginePreroll::DestroyCallback(gpointer data) {
+
+  delete reinterpret_cast<SharedPtr<GstEnginePreroll>*>(data);
+
+}
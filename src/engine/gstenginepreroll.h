@@ -0,0 +1,90 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GSTENGINEPREROLL_H
+#define GSTENGINEPREROLL_H
+
+#include "config.h"
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QByteArray>
+#include <QString>
+
+#include "includes/shared_ptr.h"
+#include "includes/mutex_protected.h"
+
+class GstEnginePreroll {
+  // Fetches and decodes the next track into a bounded buffer before the current track ends.
+  // Playbin then plays the decoded audio from an appsrc, so the gapless transition doesn't have to wait for the network or a slow disk.
+
+ public:
+  explicit GstEnginePreroll(const QByteArray &gst_url);
+  ~GstEnginePreroll();
+
+  // Set this as playbin's URI to play from the preroll buffer.
+  static const char *kUri;
+
+  QByteArray gst_url() const { return gst_url_; }
+
+  using SourceSetupCallback = void (*)(GstElement *decodebin, GstElement *source, gpointer data);
+
+  // Starts decoding, at most max_buffer_nanosec is decoded ahead.
+  // The source_setup_callback is called with the source element before it is started, like playbin's source-setup signal.
+  bool Start(const quint64 max_buffer_nanosec, SourceSetupCallback source_setup_callback, gpointer source_setup_data, QString &error);
+
+  // False if decoding failed, the track should then be played from the URL instead.
+  bool is_usable() const { return !error_.value(); }
+
+  quint64 buffered_nanosec() const;
+
+  // Feeds the decoded audio to playbin's appsrc.  The appsrc keeps a reference to the preroll.
+  static void AttachSource(SharedPtr<GstEnginePreroll> preroll, GstElement *appsrc);
+
+ private:
+  static void PadAddedCallback(GstElement *element, GstPad *pad, gpointer self);
+  static GstPadProbeReturn EventProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self);
+  static GstBusSyncReply BusSyncCallback(GstBus *bus, GstMessage *msg, gpointer self);
+  static void NeedDataCallback(GstAppSrc *appsrc, guint length, gpointer data);
+  static gboolean SeekDataCallback(GstAppSrc *appsrc, guint64 offset, gpointer data);
+  static void DestroyCallback(gpointer data);
+
+ private:
+  QByteArray gst_url_;
+
+  GstElement *pipeline_;
+  GstElement *queue_;
+  GstElement *appsink_;
+
+  mutex_protected<bool> error_;
+  // Set when the appsrc has taken audio from the preroll or seeked it.
+  mutex_protected<bool> started_;
+
+  // Tags from the decoder, these are sent before the audio so ReplayGain and metadata still work.
+  QMutex mutex_tags_;
+  GstTagList *tags_;
+  bool tags_sent_;
+};
+
+#endif  // GSTENGINEPREROLL_H
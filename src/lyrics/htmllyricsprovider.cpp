@@ -91,6 +91,11 @@ void HtmlLyricsProvider::HandleLyricsReply(QNetworkReply *reply, const int id, c
 
   if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid()) {
     const int http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (http_status_code == 404) {  // Not found replies from the cache
+      qLog(Debug) << name_ << "No lyrics for" << request.artist << request.album << request.title;
+      reply->readAll(); // QTBUG-135641
+      return;
+    }
     if (http_status_code < 200 || http_status_code > 207) {
       qLog(Error) << name_ << "Received HTTP code" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
       reply->readAll(); // QTBUG-135641
@@ -53,6 +53,7 @@ class LyricsProvider : public HttpBaseRequest {
   virtual bool authenticated() const override { return false; }
   virtual bool use_authorization_header() const override { return authentication_required_; }
   virtual QByteArray authorization_header() const override { return QByteArray(); }
+  virtual bool cache_replies() const override { return true; }
 
   virtual bool StartSearchAsync(const int id, const LyricsSearchRequest &request);
   virtual void CancelSearchAsync(const int id) { Q_UNUSED(id); }
@@ -95,6 +95,7 @@
 
 #include "core/iconloader.h"
 #include "core/commandlineoptions.h"
+#include "core/tracing.h"
 #include "core/networkproxyfactory.h"
 
 #include "core/application.h"
@@ -171,6 +172,10 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (!options.trace_filename().isEmpty() || options.print_stats()) {
+    tracing::Init(options.trace_filename(), options.print_stats());
+  }
+
 #ifdef Q_OS_MACOS
   // Must happen after QCoreApplication::setOrganizationName().
   Utilities::SetEnv("XDG_CONFIG_HOME", StandardPaths::WritableLocation(StandardPaths::StandardLocation::AppConfigLocation));
@@ -206,6 +211,8 @@ int main(int argc, char *argv[]) {
 
   QThread::currentThread()->setObjectName(u"Main"_s);
 
+  tracing::StartStallDetector();
+
   if (QGuiApplication::platformName() != "wayland"_L1) {
     QGuiApplication::setWindowIcon(IconLoader::Load(u"strawberry"_s));
   }
@@ -376,6 +383,8 @@ int main(int argc, char *argv[]) {
 
   int ret = QCoreApplication::exec();
 
+  tracing::Shutdown();
+
 #ifdef __MINGW32__
   // Workaround crash on exit with win32 threads
   TerminateProcess(GetCurrentProcess(), 0);
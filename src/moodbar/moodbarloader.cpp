@@ -197,52 +197,68 @@ void MoodbarLoader::RequestFinished(MoodbarPipelinePtr pipeline, const QUrl &url
   Q_ASSERT(QThread::currentThread() == qApp->thread());
 
   if (pipeline->success()) {
+    qLog(Info) << "Moodbar data generated successfully for" << url.toLocalFile();
+    SaveMoodbar(url, pipeline->data());
+  }
 
-    const QString filename = url.toLocalFile();
+  // Remove the request from the active list and delete it
+  requests_.remove(url);
+  active_requests_.remove(url);
 
-    qLog(Info) << "Moodbar data generated successfully for" << filename;
+  MaybeTakeNextRequest();
 
-    // Save the data in the cache
-    QNetworkCacheMetaData disk_cache_metadata;
-    disk_cache_metadata.setSaveToDisk(true);
-    disk_cache_metadata.setUrl(CacheUrlEntry(filename));
-    // Qt 6 now ignores any entry without headers, so add a fake header.
-    disk_cache_metadata.setRawHeaders(QNetworkCacheMetaData::RawHeaderList() << qMakePair(QByteArray("moodbar"), QByteArray("moodbar")));
+}
 
-    QIODevice *device_cache_file = cache_->prepare(disk_cache_metadata);
-    if (device_cache_file) {
-      const qint64 data_written = device_cache_file->write(pipeline->data());
-      if (data_written > 0) {
-        cache_->insert(device_cache_file);
-      }
+void MoodbarLoader::StoreMoodbars(const QMap<QUrl, QByteArray> &moodbars) {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  for (QMap<QUrl, QByteArray>::const_iterator it = moodbars.constBegin(); it != moodbars.constEnd(); ++it) {
+    SaveMoodbar(it.key(), it.value());
+  }
+
+  qLog(Info) << "Stored" << moodbars.count() << "moodbars created during the collection scan";
+
+}
+
+void MoodbarLoader::SaveMoodbar(const QUrl &url, const QByteArray &data) {
+
+  const QString filename = url.toLocalFile();
+
+  // Save the data in the cache
+  QNetworkCacheMetaData disk_cache_metadata;
+  disk_cache_metadata.setSaveToDisk(true);
+  disk_cache_metadata.setUrl(CacheUrlEntry(filename));
+  // Qt 6 now ignores any entry without headers, so add a fake header.
+  disk_cache_metadata.setRawHeaders(QNetworkCacheMetaData::RawHeaderList() << qMakePair(QByteArray("moodbar"), QByteArray("moodbar")));
+
+  QIODevice *device_cache_file = cache_->prepare(disk_cache_metadata);
+  if (device_cache_file) {
+    const qint64 data_written = device_cache_file->write(data);
+    if (data_written > 0) {
+      cache_->insert(device_cache_file);
     }
+  }
 
-    // Save the data alongside the original as well if we're configured to.
-    if (save_) {
-      QStringList mood_filenames = MoodFilenames(url.toLocalFile());
-      const QString mood_filename(mood_filenames[0]);
-      QFile mood_file(mood_filename);
-      if (mood_file.open(QIODevice::WriteOnly)) {
-        if (mood_file.write(pipeline->data()) <= 0) {
-          qLog(Error) << "Error writing to mood file" << mood_filename << mood_file.errorString();
-        }
-        mood_file.close();
-#ifdef Q_OS_WIN32
-        if (!SetFileAttributes(reinterpret_cast<LPCTSTR>(mood_filename.utf16()), FILE_ATTRIBUTE_HIDDEN)) {
-          qLog(Warning) << "Error setting hidden attribute for file" << mood_filename;
-        }
-#endif
+  // Save the data alongside the original as well if we're configured to.
+  if (save_) {
+    QStringList mood_filenames = MoodFilenames(url.toLocalFile());
+    const QString mood_filename(mood_filenames[0]);
+    QFile mood_file(mood_filename);
+    if (mood_file.open(QIODevice::WriteOnly)) {
+      if (mood_file.write(data) <= 0) {
+        qLog(Error) << "Error writing to mood file" << mood_filename << mood_file.errorString();
       }
-      else {
-        qLog(Error) << "Error opening mood file" << mood_filename << "for writing:" << mood_file.errorString();
+      mood_file.close();
+#ifdef Q_OS_WIN32
+      if (!SetFileAttributes(reinterpret_cast<LPCTSTR>(mood_filename.utf16()), FILE_ATTRIBUTE_HIDDEN)) {
+        qLog(Warning) << "Error setting hidden attribute for file" << mood_filename;
       }
+#endif
+    }
+    else {
+      qLog(Error) << "Error opening mood file" << mood_filename << "for writing:" << mood_file.errorString();
     }
   }
 
-  // Remove the request from the active list and delete it
-  requests_.remove(url);
-  active_requests_.remove(url);
-
-  MaybeTakeNextRequest();
-
 }
@@ -70,9 +70,13 @@ class MoodbarLoader : public QObject {
 
   LoadResult Load(const QUrl &url, const bool has_cue);
 
+  // Saves moodbars created outside of the loader, like during the collection scan.
+  void StoreMoodbars(const QMap<QUrl, QByteArray> &moodbars);
+
  private:
   static QStringList MoodFilenames(const QString &song_filename);
   static QUrl CacheUrlEntry(const QString &filename);
+  void SaveMoodbar(const QUrl &url, const QByteArray &data);
   void RequestFinished(MoodbarPipelinePtr pipeline, const QUrl &url);
   void MaybeTakeNextRequest();
 
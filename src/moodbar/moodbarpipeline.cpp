@@ -44,9 +44,8 @@
 using namespace Qt::Literals::StringLiterals;
 using std::make_unique;
 
-namespace {
-constexpr int kBands = 128;
-}
+const int MoodbarPipeline::kBands = 128;
+const int MoodbarPipeline::kWidth = 1000;
 
 MoodbarPipeline::MoodbarPipeline(const QUrl &url, QObject *parent)
     : QObject(parent),
@@ -245,7 +244,7 @@ void MoodbarPipeline::Finish(const bool success) {
   success_ = success;
 
   if (builder_) {
-    data_ = builder_->Finish(1000);
+    data_ = builder_->Finish(kWidth);
     builder_.reset();
   }
 
@@ -44,6 +44,10 @@ class MoodbarPipeline : public QObject {
   explicit MoodbarPipeline(const QUrl &url, QObject *parent = nullptr);
   ~MoodbarPipeline() override;
 
+  // Number of spectrum bands and the width of the generated moodbar data.
+  static const int kBands;
+  static const int kWidth;
+
   bool success() const { return success_; }
   const QByteArray &data() const { return data_; }
 
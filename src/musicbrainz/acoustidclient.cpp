@@ -87,6 +87,7 @@ void AcoustidClient::Start(const int id, const QString &fingerprint, int duratio
 
   QNetworkRequest network_request(url);
   network_request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+  network_request.setAttribute(NetworkAccessManager::kCacheLifetimeAttribute, NetworkAccessManager::kReplyCacheLifetimeSec);
   QNetworkReply *reply = network_->get(network_request);
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, id]() { RequestFinished(reply, id); });
   requests_[id] = reply;
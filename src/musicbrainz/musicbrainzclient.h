@@ -56,6 +56,7 @@ class MusicBrainzClient : public JsonBaseRequest {
   virtual bool authenticated() const override { return true; }
   virtual bool use_authorization_header() const override { return false; }
   virtual QByteArray authorization_header() const override { return QByteArray(); }
+  virtual bool cache_replies() const override { return true; }
 
   struct Result {
    public:
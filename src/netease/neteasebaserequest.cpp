@@ -9,6 +9,7 @@
 #include <QRandomGenerator>
 
 #include "core/logging.h"
+#include "core/jsonreply.h"
 #include "netease/neteasecrypto.h"
 #include "neteaseservice.h"
 #include "neteasebaserequest.h"
@@ -142,11 +143,10 @@ JsonBaseRequest::JsonObjectResult NeteaseBaseRequest::ParseJsonObject(QNetworkRe
     result.http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   }
 
-  const QByteArray data = reply->readAll();
-  if (!data.isEmpty()) {
-    QJsonParseError json_parse_error;
-    const QJsonDocument json_document = QJsonDocument::fromJson(data, &json_parse_error);
-    if (json_parse_error.error == QJsonParseError::NoError) {
+  const JsonReply json_reply = JsonReply::Read(reply);
+  if (!json_reply.empty) {
+    const QJsonDocument &json_document = json_reply.json_document;
+    if (json_reply.json_parse_error.error == QJsonParseError::NoError) {
       const QJsonObject json_object = json_document.object();
       if (json_object.contains("msg"_L1) && json_object.contains("code"_L1)) {
         const QString error = json_object["msg"_L1].toString();
@@ -160,7 +160,7 @@ JsonBaseRequest::JsonObjectResult NeteaseBaseRequest::ParseJsonObject(QNetworkRe
     }
     else {
       result.error_code = ErrorCode::ParseError;
-      result.error_message = json_parse_error.errorString();
+      result.error_message = json_reply.json_parse_error.errorString();
     }
   }
 
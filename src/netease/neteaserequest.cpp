@@ -18,9 +18,11 @@
 #include "constants/timeconstants.h"
 #include "utilities/imageutils.h"
 #include "utilities/coverutils.h"
+#include "covermanager/covercacheindex.h"
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
+#include "core/jsonreply.h"
 #include "neteaseservice.h"
 #include "neteasebaserequest.h"
 #include "neteaserequest.h"
@@ -216,7 +218,7 @@ void NeteaseRequest::FlushArtistsRequests() {
       reply = CreatePostRequest(u"/weapi/search/get"_s, parameters);
     // }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++artists_requests_active_;
 
@@ -266,7 +268,7 @@ void NeteaseRequest::FlushAlbumsRequests() {
       reply = CreatePostRequest(u"/weapi/search/get"_s, parameters);
     // }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++albums_requests_active_;
 
@@ -317,7 +319,7 @@ void NeteaseRequest::FlushSongsRequests() {
       reply = CreatePostRequest(u"/weapi/cloudsearch/get/web"_s, parameters);
     // }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++songs_requests_active_;
 
@@ -421,7 +423,7 @@ void NeteaseRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_
     artists_total_ = array_artists.size();
 
   if (offset_requested == 0)
-    Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+    SetProgress(artists_received_, artists_total_);
 
   for (const QJsonValue &v : array_artists) {
     if (!v.isObject()) {
@@ -453,7 +455,7 @@ void NeteaseRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_
   artists_received_ += artists_received;
 
   if (offset_requested != 0)
-    Q_EMIT UpdateProgress(query_id_, GetProgress(artists_total_, artists_received_));
+    SetProgress(artists_total_, artists_received_);
 
 }
 
@@ -521,7 +523,7 @@ void NeteaseRequest::FlushArtistAlbumsRequests() {
                                          // << Param("limit"_L1, QString::number(request.limit));
     QNetworkReply *reply = CreatePostRequest(QStringLiteral("/weapi/artist/albums/%1").arg(request.artist.artist_id), params);
 
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); }); });
 
     ++artist_albums_requests_active_;
 
@@ -533,7 +535,7 @@ void NeteaseRequest::ArtistAlbumsReplyReceived(QNetworkReply *reply, const Artis
 
   --artist_albums_requests_active_;
   ++artist_albums_requests_received_;
-  Q_EMIT UpdateProgress(query_id_, GetProgress(artist_albums_requests_received_, artist_albums_requests_total_));
+  SetProgress(artist_albums_requests_received_, artist_albums_requests_total_);
   ArtistAlbumsReceived(reply, artist, 0, offset_requested);
 
 }
@@ -685,7 +687,7 @@ void NeteaseRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_a
 
   // if (type_ == Type::FavouriteAlbums || type_ == Type::SearchAlbums) {
     albums_received_ += albums_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
+    SetProgress(albums_received_, albums_total_);
   // }
 
 }
@@ -778,7 +780,7 @@ void NeteaseRequest::FlushAlbumSongsRequests() {
     ++album_songs_requests_active_;
     // TODO: if (request.offset > 0) parameters << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreatePostRequest(QStringLiteral("/weapi/v1/album/%1").arg(request.album.album_id), ParamList());
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); }); });
   }
 
 }
@@ -788,7 +790,7 @@ void NeteaseRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const Artist
   --album_songs_requests_active_;
   ++album_songs_requests_received_;
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(album_songs_requests_received_, album_songs_requests_total_));
+    SetProgress(album_songs_requests_received_, album_songs_requests_total_);
   }
   AlbumSongsReceived(reply, artist, album, 0, offset_requested);
 
@@ -879,7 +881,7 @@ void NeteaseRequest::SongsReceived(QNetworkReply *reply, const Artist &artist, c
   // if (type_ == Type::FavouriteSongs || type_ == Type::SearchSongs) {
     songs_total_ = songs_total;
     songs_received_ += songs_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
+    SetProgress(songs_received_, songs_total_);
   // }
 
 }
@@ -1179,7 +1181,7 @@ void NeteaseRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &alb
 
   const QScopeGuard finish_check = qScopeGuard([this]() { AlbumCoverFinishCheck(); });
 
-  Q_EMIT UpdateProgress(query_id_, GetProgress(album_covers_requests_received_, album_covers_requests_total_));
+  SetProgress(album_covers_requests_received_, album_covers_requests_total_);
 
   if (!album_covers_requests_sent_.contains(album_id)) {
     return;
@@ -1227,6 +1229,7 @@ void NeteaseRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &alb
   QImage image;
   if (image.loadFromData(data, format)) {
     if (image.save(filename, format)) {
+      CoverCacheIndex::AddFile(filename);
       while (album_covers_requests_sent_.contains(album_id)) {
         const QString song_id = album_covers_requests_sent_.take(album_id);
         if (songs_.contains(song_id)) {
@@ -1302,6 +1305,15 @@ int NeteaseRequest::GetProgress(const int count, const int total) {
 
 }
 
+void NeteaseRequest::SetProgress(const int count, const int total) {
+
+  const int progress = GetProgress(count, total);
+  if (progress_throttle_.Update(progress, 100)) {
+    Q_EMIT UpdateProgress(query_id_, progress);
+  }
+
+}
+
 void NeteaseRequest::Error(const QString &error_message, const QVariant &debug_output) {
 
   qLog(Error) << "Netease:" << error_message;
@@ -14,6 +14,7 @@
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "streaming/progressthrottle.h"
 #include "neteasebaserequest.h"
 
 class QNetworkReply;
@@ -139,6 +140,7 @@ class NeteaseRequest : public NeteaseBaseRequest {
   void AlbumCoverFinishCheck();
 
   int GetProgress(const int count, const int total);
+  void SetProgress(const int count, const int total);
   void FinishCheck();
   void Error(const QString &error_message, const QVariant &debug_output = QVariant()) override;
   void Warn(const QString &error_message, const QVariant &debug);
@@ -156,6 +158,7 @@ class NeteaseRequest : public NeteaseBaseRequest {
   QString search_text_;
 
   bool finished_;
+  ProgressThrottle progress_throttle_;
 
   QQueue<Request> artists_requests_queue_;
   QQueue<Request> albums_requests_queue_;
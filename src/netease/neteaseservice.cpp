@@ -298,6 +298,21 @@ void NeteaseService::StartSearch() {
 
 void NeteaseService::CancelSearch() {}
 
+int NeteaseService::search_limit(const SearchType type) const {
+
+  switch (type) {
+    case SearchType::Artists:
+      return artistssearchlimit_;
+    case SearchType::Albums:
+      return albumssearchlimit_;
+    case SearchType::Songs:
+      return songssearchlimit_;
+  }
+
+  return 0;
+
+}
+
 void NeteaseService::SendSearch() {
 
   NeteaseBaseRequest::Type type = NeteaseBaseRequest::Type::None;
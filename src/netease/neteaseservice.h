@@ -52,6 +52,7 @@ class NeteaseService : public StreamingService {
   int artistssearchlimit() const { return artistssearchlimit_; }
   int albumssearchlimit() const { return albumssearchlimit_; }
   int songssearchlimit() const { return songssearchlimit_; }
+  int search_limit(const SearchType type) const override;
   bool fetchalbums() const { return fetchalbums_; }
   bool download_album_covers() const { return download_album_covers_; }
   // bool remove_remastered() const { return remove_remastered_; }
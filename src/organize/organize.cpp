@@ -26,6 +26,12 @@
 #include <chrono>
 
 #include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QFile>
 #include <QFileInfo>
 #include <QTimer>
@@ -41,6 +47,7 @@
 #include "core/musicstorage.h"
 #include "core/song.h"
 #include "utilities/strutils.h"
+#include "utilities/fileutils.h"
 #include "tagreader/tagreaderclient.h"
 #include "organize.h"
 #include "transcoder/transcoder.h"
@@ -52,6 +59,7 @@ class OrganizeFormat;
 namespace {
 constexpr int kBatchSize = 10;
 constexpr int kTranscodeProgressInterval = 500;
+constexpr int kCopyProgressInterval = 250;
 }  // namespace
 
 Organize::Organize(const SharedPtr<TaskManager> task_manager,
@@ -72,6 +80,7 @@ Organize::Organize(const SharedPtr<TaskManager> task_manager,
       tagreader_client_(tagreader_client),
       transcoder_(new Transcoder(this)),
       process_files_timer_(new QTimer(this)),
+      copy_thread_pool_(new QThreadPool(this)),
       destination_(destination),
       format_(format),
       copy_(copy),
@@ -84,6 +93,7 @@ Organize::Organize(const SharedPtr<TaskManager> task_manager,
       started_(false),
       task_id_(0),
       current_copy_progress_(0),
+      files_copied_(false),
       finished_(false) {
 
   original_thread_ = thread();
@@ -130,6 +140,9 @@ void Organize::ProcessSomeFiles() {
 
   if (finished_) return;
 
+  // Wait for the current batch of concurrent copies, CopyBatchFinished() will start us off again.
+  if (!copy_tasks_.isEmpty()) return;
+
   if (!started_) {
     if (!destination_->StartCopy(&supported_filetypes_)) {
       // Failed to start - mark everything as failed :(
@@ -152,6 +165,11 @@ void Organize::ProcessSomeFiles() {
 
     UpdateProgress();
 
+    // Sync the destination once, instead of after every file.
+    if (files_copied_ && !destination_->LocalPath().isEmpty()) {
+      Utilities::SyncFilesystem(destination_->LocalPath());
+    }
+
     QString error_text;
     if (!destination_->FinishCopy(files_with_errors_.isEmpty(), error_text) && !error_text.isEmpty()) {
       log_ << error_text;
@@ -173,9 +191,8 @@ void Organize::ProcessSomeFiles() {
   }
 
   // We process files in batches so we can be cancelled part-way through.
+  QList<CopyTask> copy_tasks;
   for (int i = 0; i < kBatchSize; ++i) {
-    SetSongProgress(0);
-
     if (tasks_pending_.isEmpty()) break;
 
     Task task = tasks_pending_.takeFirst();
@@ -231,6 +248,7 @@ void Organize::ProcessSomeFiles() {
     job.remove_original_ = !copy_;
     job.playlist_ = playlist_;
 
+    bool load_embedded_cover = false;
     if (task.song_info_.song_.art_manual_is_valid() && !task.song_info_.song_.art_unset()) {
       if (task.song_info_.song_.art_manual().isLocalFile() && QFile::exists(task.song_info_.song_.art_manual().toLocalFile())) {
         job.cover_source_ = task.song_info_.song_.art_manual().toLocalFile();
@@ -248,50 +266,155 @@ void Organize::ProcessSomeFiles() {
       }
     }
     else if (destination_->source() == Song::Source::Device) {
-      const TagReaderResult result = tagreader_client_->LoadCoverImageBlocking(task.song_info_.song_.url().toLocalFile(), job.cover_image_);
-      if (!result.success()) {
-        qLog(Error) << "Could not load embedded art from" << task.song_info_.song_.url() << result.error_string();
-      }
+      // Loaded together with the copy, so it runs on the copy thread pool.
+      load_embedded_cover = true;
     }
 
     if (!job.cover_source_.isEmpty()) {
       job.cover_dest_ = QFileInfo(job.destination_).path() + QLatin1Char('/') + QFileInfo(job.cover_source_).fileName();
+      // Songs from the same album share the cover, only the first copy job copies it, so concurrent jobs don't race on the same file.
+      if (cover_dests_.contains(job.cover_dest_)) {
+        job.cover_source_.clear();
+        job.cover_dest_.clear();
+      }
+      else {
+        cover_dests_ << job.cover_dest_;
+      }
     }
 
-    job.progress_ = std::bind(&Organize::SetSongProgress, this, std::placeholders::_1, !task.transcoded_filename_.isEmpty());
+    CopyTask copy_task;
+    copy_task.index = static_cast<int>(copy_tasks.count());
+    copy_task.task = task;
+    copy_task.song = song;
+    copy_task.job = job;
+    copy_task.load_embedded_cover = load_embedded_cover;
+    copy_tasks << copy_task;
+  }
 
-    QString error_text;
-    if (destination_->CopyToStorage(job, error_text)) {
-      if (job.remove_original_ && song.is_local_collection_song() && destination_->source() == Song::Source::Collection) {
-        // Notify other aspects of system that song has been invalidated
-        QString root = destination_->LocalPath();
-        QFileInfo new_file = QFileInfo(root + QLatin1Char('/') + task.song_info_.new_filename_);
-        Q_EMIT SongPathChanged(song, new_file, destination_->collection_directory_id());
-      }
+  if (copy_tasks.isEmpty()) {
+    if (!process_files_timer_->isActive()) {
+      process_files_timer_->start();
     }
-    else {
-      files_with_errors_ << task.song_info_.song_.basefilename();
-      if (!error_text.isEmpty()) {
-        log_ << error_text;
-      }
+    return;
+  }
+
+  // Copy one file at a time if the destination can't handle concurrent copies.
+  if (destination_->MaxConcurrentCopyJobs() <= 1) {
+    for (CopyTask &copy_task : copy_tasks) {
+      SetSongProgress(0);
+      copy_task.job.progress_ = std::bind(&Organize::SetSongProgress, this, std::placeholders::_1, !copy_task.task.transcoded_filename_.isEmpty());
+      RunCopyTask(&copy_task);
+      CopyTaskFinished(copy_task);
     }
+    SetSongProgress(0);
 
-    // Clean up the temporary transcoded file
-    if (!task.transcoded_filename_.isEmpty()) {
-      QFile::remove(task.transcoded_filename_);
+    if (!process_files_timer_->isActive()) {
+      process_files_timer_->start();
     }
+    return;
+  }
+
+  // Otherwise run the batch on the copy thread pool, while the transcoder keeps working on the next files.
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    copy_tasks_progress_ = QList<int>(copy_tasks.count(), 0);
+  }
+  for (CopyTask &copy_task : copy_tasks) {
+    const int index = copy_task.index;
+    const bool transcoded = !copy_task.task.transcoded_filename_.isEmpty();
+    copy_task.job.progress_ = [this, index, transcoded](const float progress) { SetCopyTaskProgress(index, progress, transcoded); };
+  }
+  copy_tasks_ = copy_tasks;
+
+  copy_thread_pool_->setMaxThreadCount(destination_->MaxConcurrentCopyJobs());
+  copy_progress_timer_.start(kCopyProgressInterval, this);
 
-    tasks_complete_++;
+  QFutureWatcher<void> *watcher = new QFutureWatcher<void>();
+  QObject::connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher]() {
+    watcher->deleteLater();
+    CopyBatchFinished();
+  });
+  watcher->setFuture(QtConcurrent::map(copy_thread_pool_, copy_tasks_, [this](CopyTask &copy_task) { RunCopyTask(&copy_task); }));
+
+}
+
+void Organize::RunCopyTask(CopyTask *copy_task) {
+
+  if (copy_task->load_embedded_cover) {
+    const QUrl url = copy_task->task.song_info_.song_.url();
+    const TagReaderResult result = tagreader_client_->LoadCoverImageBlocking(url.toLocalFile(), copy_task->job.cover_image_);
+    if (!result.success()) {
+      qLog(Error) << "Could not load embedded art from" << url << result.error_string();
+    }
   }
-  SetSongProgress(0);
+
+  copy_task->success = destination_->CopyToStorage(copy_task->job, copy_task->error_text);
+
+}
+
+void Organize::CopyTaskFinished(const CopyTask &copy_task) {
+
+  const Task &task = copy_task.task;
+
+  if (copy_task.success) {
+    files_copied_ = true;
+    if (copy_task.job.remove_original_ && copy_task.song.is_local_collection_song() && destination_->source() == Song::Source::Collection) {
+      // Notify other aspects of system that song has been invalidated
+      QString root = destination_->LocalPath();
+      QFileInfo new_file = QFileInfo(root + QLatin1Char('/') + task.song_info_.new_filename_);
+      Q_EMIT SongPathChanged(copy_task.song, new_file, destination_->collection_directory_id());
+    }
+  }
+  else {
+    files_with_errors_ << task.song_info_.song_.basefilename();
+    if (!copy_task.error_text.isEmpty()) {
+      log_ << copy_task.error_text;
+    }
+  }
+
+  // Clean up the temporary transcoded file
+  if (!task.transcoded_filename_.isEmpty()) {
+    QFile::remove(task.transcoded_filename_);
+  }
+
+  tasks_complete_++;
+
+}
+
+void Organize::CopyBatchFinished() {
+
+  copy_progress_timer_.stop();
+
+  for (const CopyTask &copy_task : std::as_const(copy_tasks_)) {
+    CopyTaskFinished(copy_task);
+  }
+  copy_tasks_.clear();
+
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    copy_tasks_progress_.clear();
+  }
+
+  UpdateProgress();
 
   if (!process_files_timer_->isActive()) {
     process_files_timer_->start();
   }
 
+}
+
+void Organize::SetCopyTaskProgress(const int index, const float progress, const bool transcoded) {
+
+  const int max = transcoded ? 50 : 100;
+
+  QMutexLocker l(&copy_progress_mutex_);
+  if (index >= 0 && index < copy_tasks_progress_.count()) {
+    copy_tasks_progress_[index] = (transcoded ? 50 : 0) + qBound(0, static_cast<int>(progress * static_cast<float>(max)), max - 1);
+  }
 
 }
 
+
 Song::FileType Organize::CheckTranscode(const Song::FileType original_type) const {
 
   if (original_type == Song::FileType::Stream) return Song::FileType::Unknown;
@@ -355,6 +478,14 @@ void Organize::UpdateProgress() {
   // Add the progress of the track that's currently copying
   progress += current_copy_progress_;
 
+  // Add the progress of the tracks copying on the copy thread pool
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    for (const int copy_progress : std::as_const(copy_tasks_progress_)) {
+      progress += copy_progress;
+    }
+  }
+
   task_manager_->SetTaskProgress(task_id_, static_cast<quint64>(progress), total);
 
 }
@@ -384,7 +515,7 @@ void Organize::timerEvent(QTimerEvent *e) {
 
   QObject::timerEvent(e);
 
-  if (e->timerId() == transcode_progress_timer_.timerId()) {
+  if (e->timerId() == transcode_progress_timer_.timerId() || e->timerId() == copy_progress_timer_.timerId()) {
     UpdateProgress();
   }
 
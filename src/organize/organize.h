@@ -32,20 +32,22 @@
 #include <QSet>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QString>
 #include <QStringList>
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "core/musicstorage.h"
 #include "organizeformat.h"
 
 class QThread;
+class QThreadPool;
 class QTimer;
 class QTimerEvent;
 
 class TaskManager;
 class TagReaderClient;
-class MusicStorage;
 class Transcoder;
 
 class Organize : public QObject {
@@ -108,12 +110,29 @@ class Organize : public QObject {
     Song::FileType new_filetype_;
   };
 
+  struct CopyTask {
+    CopyTask() : index(0), load_embedded_cover(false), success(false) {}
+    int index;
+    Task task;
+    Song song;
+    MusicStorage::CopyJob job;
+    bool load_embedded_cover;
+    bool success;
+    QString error_text;
+  };
+
+  void RunCopyTask(CopyTask *copy_task);
+  void CopyTaskFinished(const CopyTask &copy_task);
+  void CopyBatchFinished();
+  void SetCopyTaskProgress(const int index, const float progress, const bool transcoded);
+
   QThread *thread_;
   QThread *original_thread_;
   const SharedPtr<TaskManager> task_manager_;
   const SharedPtr<TagReaderClient> tagreader_client_;
   Transcoder *transcoder_;
   QTimer *process_files_timer_;
+  QThreadPool *copy_thread_pool_;
   const SharedPtr<MusicStorage> destination_;
   QList<Song::FileType> supported_filetypes_;
 
@@ -134,8 +153,18 @@ class Organize : public QObject {
 
   int task_id_;
   int current_copy_progress_;
+  bool files_copied_;
   bool finished_;
 
+  // Batch of files being copied on the copy thread pool.
+  QList<CopyTask> copy_tasks_;
+  QMutex copy_progress_mutex_;
+  QList<int> copy_tasks_progress_;
+  QBasicTimer copy_progress_timer_;
+
+  // Cover destinations already handled by a copy job.
+  QSet<QString> cover_dests_;
+
   QStringList files_with_errors_;
   QStringList log_;
 };
@@ -26,18 +26,25 @@
 #include <utility>
 #include <memory>
 #include <functional>
+#include <numeric>
 #include <unordered_map>
 #include <random>
 #include <chrono>
+#include <optional>
+#include <vector>
 
 #include <QObject>
 #include <QCoreApplication>
 #include <QtConcurrentRun>
+#include <QtConcurrentMap>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QIODevice>
 #include <QDataStream>
 #include <QBuffer>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QThread>
 #include <QFile>
 #include <QList>
 #include <QMap>
@@ -156,7 +163,10 @@ Playlist::Playlist(const SharedPtr<TaskManager> task_manager,
       scrobble_point_(-1),
       auto_sort_(false),
       sort_column_(Column::Title),
-      sort_order_(Qt::AscendingOrder) {
+      sort_order_(Qt::AscendingOrder),
+      album_count_(0),
+      album_index_dirty_(true),
+      sort_id_(0) {
 
   undo_stack_->setUndoLimit(kUndoStackSize);
 
@@ -312,6 +322,73 @@ bool Playlist::set_column_value(Song &song, const Playlist::Column column, const
 
 }
 
+QVariant Playlist::ColumnData(const Song &song, const Column column, const int role) {
+
+  // Don't forget to change InitSortKey when adding new columns
+  switch (column) {
+    case Column::Title:              return song.PrettyTitle();
+    case Column::TitleSort:          return song.titlesort();
+    case Column::Artist:             return song.artist();
+    case Column::ArtistSort:         return song.artistsort();
+    case Column::Album:              return song.album();
+    case Column::AlbumSort:          return song.albumsort();
+    case Column::Length:             return song.length_nanosec();
+    case Column::Track:              return song.track();
+    case Column::Disc:               return song.disc();
+    case Column::Year:               return song.year();
+    case Column::OriginalYear:       return song.effective_originalyear();
+    case Column::Genre:              return song.genre();
+    case Column::AlbumArtist:        return song.playlist_effective_albumartist();
+    case Column::AlbumArtistSort:    return song.albumartistsort();
+    case Column::Composer:           return song.composer();
+    case Column::ComposerSort:       return song.composersort();
+    case Column::Performer:          return song.performer();
+    case Column::PerformerSort:      return song.performersort();
+    case Column::Grouping:           return song.grouping();
+
+    case Column::PlayCount:          return song.playcount();
+    case Column::SkipCount:          return song.skipcount();
+    case Column::LastPlayed:         return song.lastplayed();
+
+    case Column::Samplerate:         return song.samplerate();
+    case Column::Bitdepth:           return song.bitdepth();
+    case Column::Bitrate:            return song.bitrate();
+
+    case Column::URL:                return song.effective_url();
+    case Column::BaseFilename:       return song.basefilename();
+    case Column::Filesize:           return song.filesize();
+    case Column::Filetype:           return QVariant::fromValue(song.filetype());
+    case Column::DateModified:       return song.mtime();
+    case Column::DateCreated:        return song.ctime();
+
+    case Column::Comment:
+      if (role == Qt::DisplayRole)   return song.comment().simplified();
+      return song.comment();
+
+    case Column::EBUR128IntegratedLoudness: return song.ebur128_integrated_loudness_lufs().has_value() ? song.ebur128_integrated_loudness_lufs().value() : QVariant();
+
+    case Column::EBUR128LoudnessRange:      return song.ebur128_loudness_range_lu().has_value() ? song.ebur128_loudness_range_lu().value() : QVariant();
+
+    case Column::Source:             return QVariant::fromValue(song.source());
+
+    case Column::Rating:             return song.rating();
+
+    case Column::HasCUE:             return song.has_cue();
+
+    case Column::BPM:                return song.bpm();
+    case Column::Mood:               return song.mood();
+    case Column::InitialKey:         return song.initial_key();
+
+    case Column::Moodbar:
+    case Column::ColumnCount:
+      break;
+
+  }
+
+  return QVariant();
+
+}
+
 QVariant Playlist::data(const QModelIndex &idx, const int role) const {
 
   if (!idx.isValid()) {
@@ -334,76 +411,20 @@ QVariant Playlist::data(const QModelIndex &idx, const int role) const {
     case Role_CanSetRating:
       return static_cast<Column>(idx.column()) == Column::Rating && items_[idx.row()]->IsLocalCollectionItem() && items_[idx.row()]->EffectiveMetadata().id() != -1;
 
-    case Qt::EditRole:
-    case Qt::ToolTipRole:
     case Qt::DisplayRole:{
-      const PlaylistItemPtr item = items_[idx.row()];
-      const Song song = item->EffectiveMetadata();
-
-      // Don't forget to change Playlist::CompareItems when adding new columns
-      switch (static_cast<Column>(idx.column())) {
-        case Column::Title:              return song.PrettyTitle();
-        case Column::TitleSort:          return song.titlesort();
-        case Column::Artist:             return song.artist();
-        case Column::ArtistSort:         return song.artistsort();
-        case Column::Album:              return song.album();
-        case Column::AlbumSort:          return song.albumsort();
-        case Column::Length:             return song.length_nanosec();
-        case Column::Track:              return song.track();
-        case Column::Disc:               return song.disc();
-        case Column::Year:               return song.year();
-        case Column::OriginalYear:       return song.effective_originalyear();
-        case Column::Genre:              return song.genre();
-        case Column::AlbumArtist:        return song.playlist_effective_albumartist();
-        case Column::AlbumArtistSort:    return song.albumartistsort();
-        case Column::Composer:           return song.composer();
-        case Column::ComposerSort:       return song.composersort();
-        case Column::Performer:          return song.performer();
-        case Column::PerformerSort:      return song.performersort();
-        case Column::Grouping:           return song.grouping();
-
-        case Column::PlayCount:          return song.playcount();
-        case Column::SkipCount:          return song.skipcount();
-        case Column::LastPlayed:         return song.lastplayed();
-
-        case Column::Samplerate:         return song.samplerate();
-        case Column::Bitdepth:           return song.bitdepth();
-        case Column::Bitrate:            return song.bitrate();
-
-        case Column::URL:                return song.effective_url();
-        case Column::BaseFilename:       return song.basefilename();
-        case Column::Filesize:           return song.filesize();
-        case Column::Filetype:           return QVariant::fromValue(song.filetype());
-        case Column::DateModified:       return song.mtime();
-        case Column::DateCreated:        return song.ctime();
-
-        case Column::Comment:
-          if (role == Qt::DisplayRole)   return song.comment().simplified();
-          return song.comment();
-
-        case Column::EBUR128IntegratedLoudness: return song.ebur128_integrated_loudness_lufs().has_value() ? song.ebur128_integrated_loudness_lufs().value() : QVariant();
-
-        case Column::EBUR128LoudnessRange:      return song.ebur128_loudness_range_lu().has_value() ? song.ebur128_loudness_range_lu().value() : QVariant();
-
-        case Column::Source:             return QVariant::fromValue(song.source());
-
-        case Column::Rating:             return song.rating();
-
-        case Column::HasCUE:             return song.has_cue();
-
-        case Column::BPM:                return song.bpm();
-        case Column::Mood:               return song.mood();
-        case Column::InitialKey:         return song.initial_key();
-
-        case Column::Moodbar:
-        case Column::ColumnCount:
-          break;
-
+      const PlaylistItemPtr &item = items_[idx.row()];
+      if (item->HasDisplayValue(idx.column())) {
+        return item->DisplayValue(idx.column());
       }
-
-      return QVariant();
+      const QVariant value = ColumnData(item->EffectiveMetadata(), static_cast<Column>(idx.column()), role);
+      item->SetDisplayValue(idx.column(), value);
+      return value;
     }
 
+    case Qt::EditRole:
+    case Qt::ToolTipRole:
+      return ColumnData(items_[idx.row()]->EffectiveMetadata(), static_cast<Column>(idx.column()), role);
+
     case Qt::TextAlignmentRole:
       return QVariant(column_alignments_.value(idx.column(), (Qt::AlignLeft | Qt::AlignVCenter)));
 
@@ -476,6 +497,7 @@ bool Playlist::setData(const QModelIndex &idx, const QVariant &value, const int
   }
   else if (song.is_radio()) {
     item->SetOriginalMetadata(song);
+    item->ClearDisplayValues();
     ScheduleSave();
   }
 
@@ -589,16 +611,12 @@ int Playlist::NextVirtualIndex(int i, const bool ignore_repeat_track) const {
   }
 
   // We need to advance i until we get something else on the same album
-  const Song last_song = current_item_metadata();
+  const int last_album_id = album_id(current_row());
   for (int j = i + 1; j < virtual_items_.count(); ++j) {
     if (item_at(virtual_items_[j])->GetShouldSkip()) {
       continue;
     }
-    const Song this_song = item_at(virtual_items_[j])->EffectiveMetadata();
-    if (((last_song.is_compilation() && this_song.is_compilation()) ||
-         last_song.effective_albumartist() == this_song.effective_albumartist()) &&
-        last_song.album() == this_song.album() &&
-        FilterContainsVirtualIndex(j)) {
+    if (album_ids_[virtual_items_[j]] == last_album_id && FilterContainsVirtualIndex(j)) {
       return j;  // Found one
     }
   }
@@ -629,13 +647,12 @@ int Playlist::PreviousVirtualIndex(int i, const bool ignore_repeat_track) const
   }
 
   // We need to decrement i until we get something else on the same album
-  Song last_song = current_item_metadata();
+  const int last_album_id = album_id(current_row());
   for (int j = i - 1; j >= 0; --j) {
     if (item_at(virtual_items_[j])->GetShouldSkip()) {
       continue;
     }
-    Song this_song = item_at(virtual_items_[j])->EffectiveMetadata();
-    if (((last_song.is_compilation() && this_song.is_compilation()) || last_song.artist() == this_song.artist()) && last_song.album() == this_song.album() && FilterContainsVirtualIndex(j)) {
+    if (album_ids_[virtual_items_[j]] == last_album_id && FilterContainsVirtualIndex(j)) {
       return j;  // Found one
     }
   }
@@ -722,6 +739,7 @@ void Playlist::set_current_row(const int i, const AutoScroll autoscroll, const b
     PlaylistItemPtr next_item = item_at(nextrow);
     if (next_item) {
       next_item->ClearStreamMetadata();
+      album_index_dirty_ = true;
       Q_EMIT dataChanged(index(nextrow, 0), index(nextrow, ColumnCount - 1));
     }
   }
@@ -989,6 +1007,8 @@ void Playlist::MoveItemsWithoutUndo(const QList<int> &source_rows, int pos) {
 
   Q_EMIT layoutAboutToBeChanged();
 
+  album_index_dirty_ = true;
+
   PlaylistItemPtrList old_items = items_;
   PlaylistItemPtrList moved_items;
   moved_items.reserve(source_rows.count());
@@ -1059,6 +1079,8 @@ void Playlist::MoveItemsWithoutUndo(int start, const QList<int> &dest_rows) {
 
   Q_EMIT layoutAboutToBeChanged();
 
+  album_index_dirty_ = true;
+
   PlaylistItemPtrList old_items = items_;
   PlaylistItemPtrList moved_items;
   moved_items.reserve(dest_rows.count());
@@ -1158,6 +1180,8 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   const int start = pos == -1 ? static_cast<int>(items_.count()) : pos;
   const int end = start + static_cast<int>(items.count()) - 1;
 
+  album_index_dirty_ = true;
+
   beginInsertRows(QModelIndex(), start, end);
   for (int i = start; i <= end; ++i) {
     const PlaylistItemPtr item = items[i - start];
@@ -1290,6 +1314,7 @@ void Playlist::UpdateItems(SongList songs) {
           }
         }
         items_[i] = new_item;
+        album_index_dirty_ = true;
         Q_EMIT dataChanged(index(i, 0), index(i, ColumnCount - 1));
         // Also update undo actions
         for (int y = 0; y < undo_stack_->count(); y++) {
@@ -1352,80 +1377,149 @@ QMimeData *Playlist::mimeData(const QModelIndexList &indexes) const {
 
 namespace {
 
-inline bool CompareStr(const QString &a, const QString &b) {
-  return QString::localeAwareCompare(a.toLower(), b.toLower()) < 0;
+constexpr int kAsyncSortThreshold = 5000;
+constexpr int kSortChunkSize = 4096;
+
+// Sort key extracted once per item, so comparisons don't need to fetch metadata or do locale aware string compares.
+struct PlaylistSortKey {
+  int row = 0;
+  std::optional<QCollatorSortKey> text;
+  QString string;
+  qint64 number1 = 0;
+  qint64 number2 = 0;
+  double real = 0.0;
+};
+
+struct PlaylistSortChunk {
+  qsizetype begin;
+  qsizetype end;
+};
+
+void InitSortKey(const QCollator &collator, const Playlist::Column column, const PlaylistSortSource &source, PlaylistSortKey *key) {
+
+  const Song &song = source.metadata;
+
+  switch (column) {
+    case Playlist::Column::Title:                     key->text = collator.sortKey(song.effective_titlesort()); break;
+    case Playlist::Column::TitleSort:                 key->text = collator.sortKey(song.titlesort()); break;
+    case Playlist::Column::Artist:                    key->text = collator.sortKey(song.effective_artistsort()); break;
+    case Playlist::Column::ArtistSort:                key->text = collator.sortKey(song.artistsort()); break;
+    case Playlist::Column::AlbumSort:                 key->text = collator.sortKey(song.albumsort()); break;
+    case Playlist::Column::Genre:                     key->text = collator.sortKey(song.genre()); break;
+    case Playlist::Column::AlbumArtist:               key->text = collator.sortKey(song.playlist_effective_albumartistsort()); break;
+    case Playlist::Column::AlbumArtistSort:           key->text = collator.sortKey(song.albumartistsort()); break;
+    case Playlist::Column::Composer:                  key->text = collator.sortKey(song.effective_composersort()); break;
+    case Playlist::Column::ComposerSort:              key->text = collator.sortKey(song.composersort()); break;
+    case Playlist::Column::Performer:                 key->text = collator.sortKey(song.effective_performersort()); break;
+    case Playlist::Column::PerformerSort:             key->text = collator.sortKey(song.performersort()); break;
+    case Playlist::Column::Grouping:                  key->text = collator.sortKey(song.grouping()); break;
+    case Playlist::Column::URL:                       key->text = collator.sortKey(source.url_path); break;
+    case Playlist::Column::BaseFilename:              key->string = song.basefilename(); break;
+    case Playlist::Column::Comment:                   key->text = collator.sortKey(song.comment()); break;
+    case Playlist::Column::Mood:                      key->text = collator.sortKey(song.mood()); break;
+    case Playlist::Column::InitialKey:                key->text = collator.sortKey(song.initial_key()); break;
+
+    // When sorting by album, also take into account discs and tracks.
+    case Playlist::Column::Album:
+      key->text = collator.sortKey(song.effective_albumsort());
+      key->number1 = song.disc();
+      key->number2 = song.track();
+      break;
+
+    case Playlist::Column::Length:                    key->number1 = song.length_nanosec(); break;
+    case Playlist::Column::Track:                     key->number1 = song.track(); break;
+    case Playlist::Column::Disc:                      key->number1 = song.disc(); break;
+    case Playlist::Column::Year:                      key->number1 = song.year(); break;
+    case Playlist::Column::OriginalYear:              key->number1 = song.effective_originalyear(); break;
+    case Playlist::Column::PlayCount:                 key->number1 = song.playcount(); break;
+    case Playlist::Column::SkipCount:                 key->number1 = song.skipcount(); break;
+    case Playlist::Column::LastPlayed:                key->number1 = song.lastplayed(); break;
+    case Playlist::Column::Bitrate:                   key->number1 = song.bitrate(); break;
+    case Playlist::Column::Samplerate:                key->number1 = song.samplerate(); break;
+    case Playlist::Column::Bitdepth:                  key->number1 = song.bitdepth(); break;
+    case Playlist::Column::Filesize:                  key->number1 = song.filesize(); break;
+    case Playlist::Column::Filetype:                  key->number1 = static_cast<qint64>(song.filetype()); break;
+    case Playlist::Column::DateModified:              key->number1 = song.mtime(); break;
+    case Playlist::Column::DateCreated:               key->number1 = song.ctime(); break;
+    case Playlist::Column::Source:                    key->number1 = static_cast<qint64>(song.source()); break;
+    case Playlist::Column::HasCUE:                    key->number1 = song.has_cue() ? 1 : 0; break;
+    case Playlist::Column::Rating:                    key->real = song.rating(); break;
+    case Playlist::Column::BPM:                       key->real = song.bpm(); break;
+
+    case Playlist::Column::EBUR128IntegratedLoudness:
+      key->number1 = song.ebur128_integrated_loudness_lufs().has_value() ? 1 : 0;
+      key->real = song.ebur128_integrated_loudness_lufs().value_or(0.0);
+      break;
+    case Playlist::Column::EBUR128LoudnessRange:
+      key->number1 = song.ebur128_loudness_range_lu().has_value() ? 1 : 0;
+      key->real = song.ebur128_loudness_range_lu().value_or(0.0);
+      break;
+
+    case Playlist::Column::Moodbar:
+    case Playlist::Column::ColumnCount:
+      break;
+  }
+
 }
 
-template<typename T>
-inline bool CompareVal(const T &a, const T &b) {
-  return a < b;
+bool SortKeyLessThan(const PlaylistSortKey &a, const PlaylistSortKey &b) {
+
+  if (a.text.has_value() && b.text.has_value()) {
+    const int result = a.text->compare(*b.text);
+    if (result != 0) return result < 0;
+  }
+  // File names are compared case sensitively.
+  if (a.string != b.string) return a.string < b.string;
+  if (a.number1 != b.number1) return a.number1 < b.number1;
+  if (a.number2 != b.number2) return a.number2 < b.number2;
+  return a.real < b.real;
+
 }
 
 }  // namespace
 
-bool Playlist::CompareItems(const Column column, const Qt::SortOrder order, PlaylistItemPtr _a, PlaylistItemPtr _b) {
+QList<int> Playlist::SortRows(const QList<PlaylistSortSource> &sources, const Column column, const Qt::SortOrder order) {
 
-  PlaylistItemPtr a = (order == Qt::AscendingOrder) ? _a : _b;
-  PlaylistItemPtr b = (order == Qt::AscendingOrder) ? _b : _a;
+  std::vector<PlaylistSortKey> keys(static_cast<size_t>(sources.count()));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i].row = static_cast<int>(i);
+  }
 
-  const auto &ma = a->EffectiveMetadata();
-  const auto &mb = b->EffectiveMetadata();
+  const auto less_than = [order](const PlaylistSortKey &a, const PlaylistSortKey &b) {
+    return order == Qt::AscendingOrder ? SortKeyLessThan(a, b) : SortKeyLessThan(b, a);
+  };
 
-  switch (column) {
-    case Column::Title:                     return CompareStr(ma.effective_titlesort(), mb.effective_titlesort());
-    case Column::TitleSort:                 return CompareStr(ma.titlesort(), mb.titlesort());
-    case Column::Artist:                    return CompareStr(ma.effective_artistsort(), mb.effective_artistsort());
-    case Column::ArtistSort:                return CompareStr(ma.artistsort(), mb.artistsort());
-    case Column::Album:                     return CompareStr(ma.effective_albumsort(), mb.effective_albumsort());
-    case Column::AlbumSort:                 return CompareStr(ma.albumsort(), mb.albumsort());
-    case Column::Length:                    return CompareVal(ma.length_nanosec(), mb.length_nanosec());
-    case Column::Track:                     return CompareVal(ma.track(), mb.track());
-    case Column::Disc:                      return CompareVal(ma.disc(), mb.disc());
-    case Column::Year:                      return CompareVal(ma.year(), mb.year());
-    case Column::OriginalYear:              return CompareVal(ma.effective_originalyear(), mb.effective_originalyear());
-    case Column::Genre:                     return CompareStr(ma.genre(), mb.genre());
-    case Column::AlbumArtist:               return CompareStr(ma.playlist_effective_albumartistsort(), mb.playlist_effective_albumartistsort());
-    case Column::AlbumArtistSort:           return CompareStr(ma.albumartistsort(), mb.albumartistsort());
-    case Column::Composer:                  return CompareStr(ma.effective_composersort(), mb.effective_composersort());
-    case Column::ComposerSort:              return CompareStr(ma.composersort(), mb.composersort());
-    case Column::Performer:                 return CompareStr(ma.effective_performersort(), mb.effective_performersort());
-    case Column::PerformerSort:             return CompareStr(ma.performersort(), mb.performersort());
-    case Column::Grouping:                  return CompareStr(ma.grouping(), mb.grouping());
-
-    case Column::PlayCount:                 return CompareVal(ma.playcount(), mb.playcount());
-    case Column::SkipCount:                 return CompareVal(ma.skipcount(), mb.skipcount());
-    case Column::LastPlayed:                return CompareVal(ma.lastplayed(), mb.lastplayed());
-
-    case Column::Bitrate:                   return CompareVal(ma.bitrate(), mb.bitrate());
-    case Column::Samplerate:                return CompareVal(ma.samplerate(), mb.samplerate());
-    case Column::Bitdepth:                  return CompareVal(ma.bitdepth(), mb.bitdepth());
-    case Column::URL:                       return CompareStr(a->OriginalUrl().path(), b->OriginalUrl().path());
-    case Column::BaseFilename:              return CompareVal(ma.basefilename(), mb.basefilename());
-    case Column::Filesize:                  return CompareVal(ma.filesize(), mb.filesize());
-    case Column::Filetype:                  return CompareVal(ma.filetype(), mb.filetype());
-    case Column::DateModified:              return CompareVal(ma.mtime(), mb.mtime());
-    case Column::DateCreated:               return CompareVal(ma.ctime(), mb.ctime());
-
-    case Column::Comment:                   return CompareStr(ma.comment(), mb.comment());
-    case Column::Source:                    return CompareVal(ma.source(), mb.source());
-
-    case Column::Rating:                    return CompareVal(ma.rating(), mb.rating());
-
-    case Column::HasCUE:                    return CompareVal(ma.has_cue(), mb.has_cue());
-
-    case Column::EBUR128IntegratedLoudness: return CompareVal(ma.ebur128_integrated_loudness_lufs(), mb.ebur128_integrated_loudness_lufs());
-    case Column::EBUR128LoudnessRange:      return CompareVal(ma.ebur128_loudness_range_lu(), mb.ebur128_loudness_range_lu());
-
-    case Column::BPM:                       return CompareVal(ma.bpm(), mb.bpm());
-    case Column::Mood:                      return CompareStr(ma.mood(), mb.mood());
-    case Column::InitialKey:                return CompareStr(ma.initial_key(), mb.initial_key());
+  // Extract the keys and sort each chunk in parallel, every chunk uses its own collator.
+  QList<PlaylistSortChunk> chunks;
+  for (qsizetype begin = 0; begin < static_cast<qsizetype>(keys.size()); begin += kSortChunkSize) {
+    chunks << PlaylistSortChunk { begin, qMin(begin + kSortChunkSize, static_cast<qsizetype>(keys.size())) };
+  }
 
-    case Column::Moodbar:
-    case Column::ColumnCount:
-      break;
+  QtConcurrent::blockingMap(chunks, [&sources, &keys, column, &less_than](const PlaylistSortChunk &chunk) {
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    for (qsizetype i = chunk.begin; i < chunk.end; ++i) {
+      InitSortKey(collator, column, sources[i], &keys[static_cast<size_t>(i)]);
+    }
+    std::stable_sort(keys.begin() + chunk.begin, keys.begin() + chunk.end, less_than);
+  });
+
+  // Merge the sorted chunks, std::inplace_merge keeps equal items in their original order.
+  for (qsizetype width = kSortChunkSize; width < static_cast<qsizetype>(keys.size()); width *= 2) {
+    for (qsizetype begin = 0; begin + width < static_cast<qsizetype>(keys.size()); begin += width * 2) {
+      const qsizetype end = qMin(begin + width * 2, static_cast<qsizetype>(keys.size()));
+      std::inplace_merge(keys.begin() + begin, keys.begin() + begin + width, keys.begin() + end, less_than);
+    }
   }
 
-  return false;
+  QList<int> rows;
+  rows.reserve(static_cast<qsizetype>(keys.size()));
+  for (const PlaylistSortKey &key : keys) {
+    rows << key.row;
+  }
+
+  return rows;
+
 }
 
 QString Playlist::column_name(const Column column) {
@@ -1512,20 +1606,52 @@ void Playlist::sort(const int column_number, const Qt::SortOrder order) {
 
   if (ignore_sorting_) return;
 
-  PlaylistItemPtrList new_items(items_);
-  PlaylistItemPtrList::iterator begin = new_items.begin();
+  const int sort_id = ++sort_id_;
 
-  if (dynamic_playlist_ && current_item_index_.isValid())
-    begin += current_item_index_.row() + 1;
+  int begin = 0;
+  if (dynamic_playlist_ && current_item_index_.isValid()) {
+    begin = current_item_index_.row() + 1;
+  }
 
-  if (column == Column::Album) {
-    // When sorting by album, also take into account discs and tracks.
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Track, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Disc, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Album, order, std::placeholders::_1, std::placeholders::_2));
+  // Copy the metadata so the keys can be extracted outside the GUI thread.
+  QList<PlaylistSortSource> sources;
+  sources.reserve(items_.count() - begin);
+  for (int i = begin; i < items_.count(); ++i) {
+    const PlaylistItemPtr &item = items_[i];
+    sources << PlaylistSortSource { item->EffectiveMetadata(), column == Column::URL ? item->OriginalUrl().path() : QString() };
   }
-  else {
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, column, order, std::placeholders::_1, std::placeholders::_2));
+
+  if (sources.count() < kAsyncSortThreshold) {
+    SortFinished(items_, begin, SortRows(sources, column, order), column, order);
+    return;
+  }
+
+  const PlaylistItemPtrList items = items_;
+  QFuture<QList<int>> future = QtConcurrent::run(&Playlist::SortRows, sources, column, order);
+  QFutureWatcher<QList<int>> *watcher = new QFutureWatcher<QList<int>>(this);
+  QObject::connect(watcher, &QFutureWatcher<QList<int>>::finished, this, [this, watcher, sort_id, items, begin, column, order]() {
+    const QList<int> rows = watcher->result();
+    watcher->deleteLater();
+    // Ignore the result if the user sorted again or the playlist was changed while sorting.
+    if (sort_id != sort_id_ || items != items_) {
+      qLog(Debug) << "Playlist" << id_ << "changed while sorting, ignoring sort result";
+      return;
+    }
+    SortFinished(items, begin, rows, column, order);
+  });
+  watcher->setFuture(future);
+
+}
+
+void Playlist::SortFinished(const PlaylistItemPtrList &items, const int begin, const QList<int> &rows, const Column column, const Qt::SortOrder order) {
+
+  PlaylistItemPtrList new_items;
+  new_items.reserve(items.count());
+  for (int i = 0; i < begin; ++i) {
+    new_items << items[i];
+  }
+  for (const int row : rows) {
+    new_items << items[begin + row];
   }
 
   undo_stack_->push(new PlaylistUndoCommandSortItems(this, column, order, new_items));
@@ -1538,6 +1664,7 @@ void Playlist::ReOrderWithoutUndo(const PlaylistItemPtrList &new_items) {
 
   PlaylistItemPtrList old_items = items_;
   items_ = new_items;
+  album_index_dirty_ = true;
 
   QHash<const PlaylistItem*, int> new_rows;
   for (int i = 0; i < new_items.length(); ++i) {
@@ -1625,6 +1752,7 @@ void Playlist::Restore() {
 
   items_.clear();
   virtual_items_.clear();
+  album_index_dirty_ = true;
   ClearCollectionItems();
 
   cancel_restore_ = false;
@@ -1782,6 +1910,8 @@ PlaylistItemPtrList Playlist::RemoveItemsWithoutUndo(const int row, const int co
     return PlaylistItemPtrList();
   }
 
+  album_index_dirty_ = true;
+
   // Remove items
   beginRemoveRows(QModelIndex(), row, row + count - 1);
   PlaylistItemPtrList items;
@@ -2005,20 +2135,6 @@ void Playlist::Shuffle() {
 
 }
 
-namespace {
-
-bool AlbumShuffleComparator(const QMap<QString, int> &album_key_positions, const QMap<int, QString> &album_keys, const int left, const int right) {
-
-  const int left_pos = album_key_positions[album_keys[left]];
-  const int right_pos = album_key_positions[album_keys[right]];
-
-  if (left_pos == right_pos) return left < right;
-  return left_pos < right_pos;
-
-}
-
-}  // namespace
-
 void Playlist::ReshuffleIndices() {
 
   const PlaylistSequence::ShuffleMode shuffle_mode = ShuffleMode();
@@ -2037,39 +2153,39 @@ void Playlist::ReshuffleIndices() {
     }
 
     case PlaylistSequence::ShuffleMode::Albums:{
-      QMap<int, QString> album_keys;  // real index -> key
-      QSet<QString> album_key_set;    // unique keys
-
-      // Find all the unique albums in the playlist
-      for (QList<int>::const_iterator it = virtual_items_.constBegin(); it != virtual_items_.constEnd(); ++it) {
-        const int index = *it;
-        const QString key = items_[index]->EffectiveMetadata().AlbumKey();
-        album_keys[index] = key;
-        album_key_set << key;
-      }
+      UpdateAlbumIndex();
 
-      // Shuffle them
-      QStringList shuffled_album_keys = album_key_set.values();
+      // Shuffle the albums
+      QList<int> shuffled_album_ids(album_count_);
+      std::iota(shuffled_album_ids.begin(), shuffled_album_ids.end(), 0);
       std::random_device rd;
-      std::shuffle(shuffled_album_keys.begin(), shuffled_album_keys.end(), std::mt19937(rd()));
+      std::shuffle(shuffled_album_ids.begin(), shuffled_album_ids.end(), std::mt19937(rd()));
 
       // If the user is currently playing a song, force its album to be first
       if (current_row() != -1) {
-        const QString key = items_[current_row()]->EffectiveMetadata().AlbumKey();
-        const qint64 pos = shuffled_album_keys.indexOf(key);
+        const qint64 pos = shuffled_album_ids.indexOf(album_ids_[current_row()]);
         if (pos >= 1) {
-          std::swap(shuffled_album_keys[0], shuffled_album_keys[pos]);
+          std::swap(shuffled_album_ids[0], shuffled_album_ids[pos]);
         }
       }
 
-      // Create album key -> position mapping for fast lookup
-      QMap<QString, int> album_key_positions;
-      for (int i = 0; i < shuffled_album_keys.count(); ++i) {
-        album_key_positions[shuffled_album_keys[i]] = i;
+      // Create album id -> position mapping
+      QList<int> album_positions(album_count_);
+      for (int i = 0; i < shuffled_album_ids.count(); ++i) {
+        album_positions[shuffled_album_ids[i]] = i;
       }
 
-      // Sort the virtual items
-      std::stable_sort(virtual_items_.begin(), virtual_items_.end(), std::bind(AlbumShuffleComparator, album_key_positions, album_keys, std::placeholders::_1, std::placeholders::_2));
+      // Bucket the rows by album position, keeping the rows of each album in playlist order
+      QList<int> rows = virtual_items_;
+      std::sort(rows.begin(), rows.end());
+      QList<int> offsets(album_count_ + 1, 0);
+      for (const int row : std::as_const(rows)) {
+        ++offsets[album_positions[album_ids_[row]] + 1];
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (const int row : std::as_const(rows)) {
+        virtual_items_[offsets[album_positions[album_ids_[row]]]++] = row;
+      }
 
       break;
     }
@@ -2085,6 +2201,36 @@ void Playlist::ReshuffleIndices() {
 
 }
 
+void Playlist::UpdateAlbumIndex() const {
+
+  if (!album_index_dirty_ && album_ids_.count() == items_.count()) return;
+
+  QHash<QString, int> album_keys;
+  album_ids_.clear();
+  album_ids_.reserve(items_.count());
+  for (const PlaylistItemPtr &item : items_) {
+    const QString album_key = item->EffectiveMetadata().AlbumKey();
+    QHash<QString, int>::const_iterator it = album_keys.constFind(album_key);
+    if (it == album_keys.constEnd()) {
+      it = album_keys.insert(album_key, static_cast<int>(album_keys.count()));
+    }
+    album_ids_ << it.value();
+  }
+
+  album_count_ = static_cast<int>(album_keys.count());
+  album_index_dirty_ = false;
+
+}
+
+int Playlist::album_id(const int row) const {
+
+  UpdateAlbumIndex();
+
+  if (row < 0 || row >= album_ids_.count()) return -1;
+  return album_ids_[row];
+
+}
+
 void Playlist::set_sequence(PlaylistSequence *v) {
 
   playlist_sequence_ = v;
@@ -2329,6 +2475,8 @@ void Playlist::UpdateItemMetadata(const int row, PlaylistItemPtr item, const Son
       item->UpdateStreamMetadata(new_metadata);
     }
   }
+  item->ClearDisplayValues();
+  album_index_dirty_ = true;
 
   if (!changed_columns.isEmpty()) {
     RowDataChanged(row, changed_columns);
@@ -2345,6 +2493,11 @@ void Playlist::UpdateItemMetadata(const int row, PlaylistItemPtr item, const Son
 
 void Playlist::RowDataChanged(const int row, const Columns &columns) {
 
+  if (has_item_at(row)) {
+    items_[row]->ClearDisplayValues();
+  }
+  album_index_dirty_ = true;
+
   if (columns.count() > 5) {
     const QModelIndex idx_column_first = index(row, 0);
     const QModelIndex idx_column_last = index(row, ColumnCount - 1);
@@ -72,6 +72,12 @@ class SortItems;
 }  // namespace PlaylistUndoCommands
 
 using ColumnAlignmentMap = QMap<int, Qt::Alignment>;
+
+// Metadata copied out of the items for sorting outside the GUI thread.
+struct PlaylistSortSource {
+  Song metadata;
+  QString url_path;
+};
 Q_DECLARE_METATYPE(Qt::Alignment)
 Q_DECLARE_METATYPE(ColumnAlignmentMap)
 
@@ -166,8 +172,6 @@ class Playlist : public QAbstractListModel {
   static const int kUndoStackSize;
   static const int kUndoItemLimit;
 
-  static bool CompareItems(const Column column, const Qt::SortOrder order, PlaylistItemPtr a, PlaylistItemPtr b);
-
   static QString column_name(const Column column);
   static QString abbreviated_column_name(const Column column);
 
@@ -339,11 +343,21 @@ class Playlist : public QAbstractListModel {
   void Rename(const int id, const QString &name);
 
  private:
+  static QVariant ColumnData(const Song &song, const Column column, const int role);
+
+  // Returns the sorted order of the sources as indexes into the list.
+  static QList<int> SortRows(const QList<PlaylistSortSource> &sources, const Column column, const Qt::SortOrder order);
+  void SortFinished(const PlaylistItemPtrList &items, const int begin, const QList<int> &rows, const Column column, const Qt::SortOrder order);
+
   void SetCurrentIsPaused(const bool paused);
   int NextVirtualIndex(int i, const bool ignore_repeat_track) const;
   int PreviousVirtualIndex(int i, const bool ignore_repeat_track) const;
   bool FilterContainsVirtualIndex(const int i) const;
 
+  // Interned album ids, used by album shuffle and album repeat instead of comparing album keys.
+  void UpdateAlbumIndex() const;
+  int album_id(const int row) const;
+
   template<typename T>
   void InsertSongItems(const SongList &songs, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next = false);
 
@@ -434,6 +448,14 @@ class Playlist : public QAbstractListModel {
   bool auto_sort_;
   Column sort_column_;
   Qt::SortOrder sort_order_;
+
+  // Album id for each row in items_, rebuilt lazily when items or their metadata change.
+  mutable QList<int> album_ids_;
+  mutable int album_count_;
+  mutable bool album_index_dirty_;
+
+  // Incremented for every sort, so results from an older background sort are ignored.
+  int sort_id_;
 };
 
 #endif  // PLAYLIST_H
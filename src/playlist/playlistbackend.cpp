@@ -111,8 +111,7 @@ PlaylistBackend::PlaylistList PlaylistBackend::GetAllFavoritePlaylists() {
 
 PlaylistBackend::PlaylistList PlaylistBackend::GetPlaylists(const GetPlaylistsFlags flags) {
 
-  QMutexLocker l(database_->Mutex());
-  QSqlDatabase db(database_->Connect());
+  QSqlDatabase db(database_->ConnectReadOnly());
 
   PlaylistList ret;
 
@@ -155,8 +154,7 @@ PlaylistBackend::PlaylistList PlaylistBackend::GetPlaylists(const GetPlaylistsFl
 
 PlaylistBackend::Playlist PlaylistBackend::GetPlaylist(const int id) {
 
-  QMutexLocker l(database_->Mutex());
-  QSqlDatabase db(database_->Connect());
+  QSqlDatabase db(database_->ConnectReadOnly());
 
   SqlQuery q(db);
   q.prepare(u"SELECT ROWID, name, last_played, special_type, ui_path, is_favorite, dynamic_playlist_type, dynamic_playlist_data, dynamic_playlist_backend FROM playlists WHERE ROWID=:id"_s);
@@ -200,8 +198,7 @@ PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
 
   {
 
-    QMutexLocker l(database_->Mutex());
-    QSqlDatabase db(database_->Connect());
+    QSqlDatabase db(database_->ConnectReadOnly());
     SqlQuery q(db);
     // Forward iterations only may be faster
     q.setForwardOnly(true);
@@ -233,8 +230,7 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
   SongList songs;
 
   {
-    QMutexLocker l(database_->Mutex());
-    QSqlDatabase db(database_->Connect());
+    QSqlDatabase db(database_->ConnectReadOnly());
     SqlQuery q(db);
     // Forward iterations only may be faster
     q.setForwardOnly(true);
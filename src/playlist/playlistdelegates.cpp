@@ -81,6 +81,7 @@ constexpr QRgb kQueueBoxGradientColor1 = qRgb(102, 150, 227);
 constexpr QRgb kQueueBoxGradientColor2 = qRgb(77, 121, 200);
 constexpr int kQueueOpacitySteps = 10;
 constexpr float kQueueOpacityLowerBound = 0.4F;
+constexpr int kDisplayTextCacheSize = 8192;
 }  // namespace
 
 const int PlaylistDelegateBase::kMinHeight = 19;
@@ -204,6 +205,25 @@ QString PlaylistDelegateBase::displayText(const QVariant &value, const QLocale &
 
 }
 
+bool PlaylistDelegateBase::CachedDisplayText(const qint64 key, QString *text) const {
+
+  QHash<qint64, QString>::const_iterator it = display_text_cache_.constFind(key);
+  if (it == display_text_cache_.constEnd()) return false;
+
+  *text = it.value();
+  return true;
+
+}
+
+void PlaylistDelegateBase::CacheDisplayText(const qint64 key, const QString &text) const {
+
+  if (display_text_cache_.count() >= kDisplayTextCacheSize) {
+    display_text_cache_.clear();
+  }
+  display_text_cache_.insert(key, text);
+
+}
+
 QSize PlaylistDelegateBase::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &idx) const {
 
   QSize size = QueuedItemDelegate::sizeHint(option, idx);
@@ -306,8 +326,15 @@ QString LengthItemDelegate::displayText(const QVariant &value, const QLocale &lo
   bool ok = false;
   qint64 nanoseconds = value.toLongLong(&ok);
 
-  if (ok && nanoseconds > 0) return Utilities::PrettyTimeNanosec(nanoseconds);
-  return QString();
+  if (!ok || nanoseconds <= 0) return QString();
+
+  QString text;
+  if (!CachedDisplayText(nanoseconds, &text)) {
+    text = Utilities::PrettyTimeNanosec(nanoseconds);
+    CacheDisplayText(nanoseconds, text);
+  }
+
+  return text;
 
 }
 
@@ -319,8 +346,15 @@ QString SizeItemDelegate::displayText(const QVariant &value, const QLocale &loca
   bool ok = false;
   qint64 bytes = value.toLongLong(&ok);
 
-  if (ok && bytes > 0) return Utilities::PrettySize(static_cast<quint64>(bytes));
-  return QString();
+  if (!ok || bytes <= 0) return QString();
+
+  QString text;
+  if (!CachedDisplayText(bytes, &text)) {
+    text = Utilities::PrettySize(static_cast<quint64>(bytes));
+    CacheDisplayText(bytes, text);
+  }
+
+  return text;
 
 }
 
@@ -335,7 +369,13 @@ QString DateItemDelegate::displayText(const QVariant &value, const QLocale &loca
     return QString();
   }
 
-  return QDateTime::fromSecsSinceEpoch(time).toString(QLocale::system().dateTimeFormat(QLocale::ShortFormat));
+  QString text;
+  if (!CachedDisplayText(time, &text)) {
+    text = QDateTime::fromSecsSinceEpoch(time).toString(QLocale::system().dateTimeFormat(QLocale::ShortFormat));
+    CacheDisplayText(time, text);
+  }
+
+  return text;
 
 }
 
@@ -361,7 +401,13 @@ QString FileTypeItemDelegate::displayText(const QVariant &value, const QLocale &
 
   if (!ok) return tr("Unknown");
 
-  return Song::TextForFiletype(type);
+  QString text;
+  if (!CachedDisplayText(static_cast<qint64>(type), &text)) {
+    text = Song::TextForFiletype(type);
+    CacheDisplayText(static_cast<qint64>(type), text);
+  }
+
+  return text;
 
 }
 
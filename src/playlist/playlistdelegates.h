@@ -33,6 +33,7 @@
 #include <QCompleter>
 #include <QLocale>
 #include <QVariant>
+#include <QHash>
 #include <QUrl>
 #include <QPixmap>
 #include <QPainter>
@@ -86,9 +87,17 @@ class PlaylistDelegateBase : public QueuedItemDelegate {
  public Q_SLOTS:
   bool helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &idx) override;
 
+ protected:
+  // Formatted text keyed by the raw value, so repainting doesn't format the same lengths, sizes and dates again.
+  bool CachedDisplayText(const qint64 key, QString *text) const;
+  void CacheDisplayText(const qint64 key, const QString &text) const;
+
  protected:
   QTreeView *view_;
   QString suffix_;
+
+ private:
+  mutable QHash<qint64, QString> display_text_cache_;
 };
 
 class LengthItemDelegate : public PlaylistDelegateBase {
@@ -95,6 +95,7 @@ PlaylistItemPtr PlaylistItem::NewFromSong(const Song &song) {
 
 void PlaylistItem::SetStreamMetadata(const Song &song) {
   stream_song_ = song;
+  display_values_.clear();
 }
 
 void PlaylistItem::UpdateStreamMetadata(const Song &song) {
@@ -113,6 +114,7 @@ void PlaylistItem::UpdateStreamMetadata(const Song &song) {
 
 void PlaylistItem::ClearStreamMetadata() {
   stream_song_ = Song();
+  display_values_.clear();
 }
 
 void PlaylistItem::BindToQuery(SqlQuery *query) const {
@@ -30,6 +30,7 @@
 #include <QMetaType>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QSet>
 #include <QVariant>
 #include <QString>
@@ -111,6 +112,13 @@ class PlaylistItem : public enable_shared_from_this<PlaylistItem> {
   void SetShouldSkip(const bool should_skip);
   bool GetShouldSkip() const;
 
+  // Display values cached by Playlist::data(), so repainting a row does not copy and reformat the song every time.
+  // Only used from the GUI thread, the playlist clears it when the row data changes.
+  bool HasDisplayValue(const int column) const { return display_values_.contains(column); }
+  QVariant DisplayValue(const int column) const { return display_values_.value(column); }
+  void SetDisplayValue(const int column, const QVariant &value) const { display_values_.insert(column, value); }
+  void ClearDisplayValues() const { display_values_.clear(); }
+
  protected:
   bool should_skip_;
 
@@ -127,6 +135,8 @@ class PlaylistItem : public enable_shared_from_this<PlaylistItem> {
   QMap<short, QColor> background_colors_;
   QMap<short, QColor> foreground_colors_;
 
+  mutable QHash<int, QVariant> display_values_;
+
   Q_DISABLE_COPY(PlaylistItem)
 };
 using PlaylistItemPtr = SharedPtr<PlaylistItem>;
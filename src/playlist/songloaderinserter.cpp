@@ -186,7 +186,7 @@ void SongLoaderInserter::AsyncLoad() {
   int async_progress = 0;
   int async_load_id = task_manager_->StartTask(tr("Loading tracks"));
   task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(async_progress), static_cast<quint64>(pending_.count()));
-  bool first_loaded = false;
+  SongLoader *first_loaded = nullptr;
   for (int i = 0; i < pending_.count(); ++i) {
     SongLoader *loader = pending_.value(i);
     const SongLoader::Result result = loader->LoadFilenamesBlocking();
@@ -204,7 +204,7 @@ void SongLoaderInserter::AsyncLoad() {
       // Load everything from the first song.
       // It'll start playing as soon as we emit PreloadFinished, so it needs to have the duration set to show properly in the UI.
       loader->LoadMetadataBlocking();
-      first_loaded = true;
+      first_loaded = loader;
     }
 
     songs_ << loader->songs();
@@ -218,21 +218,25 @@ void SongLoaderInserter::AsyncLoad() {
   async_progress = 0;
   async_load_id = task_manager_->StartTask(tr("Loading tracks info"));
   task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(async_progress), static_cast<quint64>(songs_.count()));
-  SongList songs;
   for (int i = 0; i < pending_.count(); ++i) {
     SongLoader *loader = pending_.value(i);
-    if (i != 0) {
+    if (loader == first_loaded) {
       // We already did this earlier for the first song.
-      loader->LoadMetadataBlocking();
+      async_progress += static_cast<int>(loader->songs().count());
+      task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(async_progress));
+      Q_EMIT EffectiveLoadFinished(loader->songs());
+      continue;
     }
-    songs << loader->songs();
-    task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(songs.count()));
+    // Replace the partially-loaded items by the new ones, fully loaded, as they come in.
+    QObject::connect(loader, &SongLoader::MetadataLoaded, this, [this, async_load_id, &async_progress](const SongList &songs) {
+      async_progress += static_cast<int>(songs.count());
+      task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(async_progress));
+      Q_EMIT EffectiveLoadFinished(songs);
+    }, Qt::DirectConnection);
+    loader->LoadMetadataBlocking();
   }
   task_manager_->SetTaskFinished(async_load_id);
 
-  // Replace the partially-loaded items by the new ones, fully loaded.
-  Q_EMIT EffectiveLoadFinished(songs);
-
   deleteLater();
 
 }
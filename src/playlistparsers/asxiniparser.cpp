@@ -23,6 +23,7 @@
 #include <QIODevice>
 #include <QByteArray>
 #include <QDir>
+#include <QList>
 #include <QString>
 #include <QTextStream>
 
@@ -46,7 +47,7 @@ ParserBase::LoadResult AsxIniParser::Load(QIODevice *device, const QString &play
 
   Q_UNUSED(playlist_path);
 
-  SongList ret;
+  QList<SongReference> references;
 
   while (!device->atEnd()) {
     QString line = QString::fromUtf8(device->readLine()).trimmed();
@@ -55,10 +56,15 @@ ParserBase::LoadResult AsxIniParser::Load(QIODevice *device, const QString &play
     QString value = line.mid(equals + 1);
 
     if (key.startsWith("ref"_L1)) {
-      Song song = LoadSong(value, 0, 0, dir, collection_lookup);
-      if (song.is_valid()) {
-        ret << song;
-      }
+      references << SongReference(value);
+    }
+  }
+
+  SongList ret;
+  const SongList songs = LoadSongs(references, dir, collection_lookup);
+  for (const Song &song : songs) {
+    if (song.is_valid()) {
+      ret << song;
     }
   }
 
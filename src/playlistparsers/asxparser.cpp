@@ -23,6 +23,7 @@
 #include <QIODevice>
 #include <QBuffer>
 #include <QDir>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QRegularExpression>
@@ -72,21 +73,39 @@ ParserBase::LoadResult ASXParser::Load(QIODevice *device, const QString &playlis
     return SongList();
   }
 
-  SongList ret;
+  QList<SongReference> references;
+  SongList playlist_songs;
   while (!reader.atEnd() && Utilities::ParseUntilElementCI(&reader, u"entry"_s)) {
-    Song song = ParseTrack(&reader, dir, collection_lookup);
+    SongReference reference;
+    playlist_songs << ParseTrack(&reader, &reference);
+    references << reference;
+  }
+
+  buffer.close();
+
+  SongList ret;
+  const SongList loaded_songs = LoadSongs(references, dir, collection_lookup);
+  for (qsizetype i = 0; i < loaded_songs.count(); ++i) {
+    Song song = loaded_songs[i];
+
+    // Override metadata with what was in the playlist
+    if (song.source() != Song::Source::Collection) {
+      const Song &playlist_song = playlist_songs[i];
+      if (!playlist_song.title().isEmpty()) song.set_title(playlist_song.title());
+      if (!playlist_song.artist().isEmpty()) song.set_artist(playlist_song.artist());
+      if (!playlist_song.album().isEmpty()) song.set_album(playlist_song.album());
+    }
+
     if (song.is_valid()) {
       ret << song;
     }
   }
 
-  buffer.close();
-
   return ret;
 
 }
 
-Song ASXParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_lookup) const {
+Song ASXParser::ParseTrack(QXmlStreamReader *reader, SongReference *reference) const {
 
   QString title, artist, album, ref;
 
@@ -120,14 +139,13 @@ Song ASXParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool
   }
 
 return_song:
-  Song song = LoadSong(ref, 0, 0, dir, collection_lookup);
+  *reference = SongReference(ref);
 
-  // Override metadata with what was in the playlist
-  if (song.source() != Song::Source::Collection) {
-    if (!title.isEmpty()) song.set_title(title);
-    if (!artist.isEmpty()) song.set_artist(artist);
-    if (!album.isEmpty()) song.set_album(album);
-  }
+  // The metadata from the playlist, used for songs not in the collection.
+  Song song;
+  song.set_title(title);
+  song.set_artist(artist);
+  song.set_album(album);
 
   return song;
 
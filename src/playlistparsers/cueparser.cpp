@@ -19,6 +19,8 @@
  *
  */
 
+#include <utility>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QIODevice>
@@ -253,11 +255,18 @@ ParserBase::LoadResult CueParser::Load(QIODevice *device, const QString &playlis
 
   QDateTime cue_mtime = QFileInfo(playlist_path).lastModified();
 
+  QList<SongReference> references;
+  references.reserve(entries.count());
+  for (const CueEntry &entry : std::as_const(entries)) {
+    references << SongReference(entry.file, IndexToMarker(entry.index));
+  }
+  const SongList songs = LoadSongs(references, dir, collection_lookup);
+
   // Finalize parsing songs
   for (int i = 0; i < entries.length(); i++) {
     CueEntry entry = entries.at(i);
 
-    Song song = LoadSong(entry.file, IndexToMarker(entry.index), 0, dir, collection_lookup);
+    Song song = songs[i];
 
     // Cue song has mtime equal to qMax(media_file_mtime, cue_sheet_mtime)
     if (cue_mtime.isValid()) {
@@ -21,6 +21,7 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
+#include <QList>
 #include <QBuffer>
 #include <QByteArray>
 #include <QString>
@@ -63,7 +64,8 @@ ParserBase::LoadResult M3UParser::Load(QIODevice *device, const QString &playlis
     line = QString::fromUtf8(buffer.readLine()).trimmed();
   }
 
-  SongList ret;
+  QList<SongReference> references;
+  QList<Metadata> metadata;
   Q_FOREVER {
     if (line.startsWith(u'#')) {
       // Extended info or comment.
@@ -74,17 +76,8 @@ ParserBase::LoadResult M3UParser::Load(QIODevice *device, const QString &playlis
       }
     }
     else if (!line.isEmpty()) {
-      Song song = LoadSong(line, 0, 0, dir, collection_lookup);
-      if (!current_metadata.title.isEmpty()) {
-        song.set_title(current_metadata.title);
-      }
-      if (!current_metadata.artist.isEmpty()) {
-        song.set_artist(current_metadata.artist);
-      }
-      if (current_metadata.length > 0) {
-        song.set_length_nanosec(current_metadata.length);
-      }
-      ret << song;
+      references << SongReference(line);
+      metadata << current_metadata;
 
       current_metadata = Metadata();
     }
@@ -96,6 +89,20 @@ ParserBase::LoadResult M3UParser::Load(QIODevice *device, const QString &playlis
 
   buffer.close();
 
+  SongList ret = LoadSongs(references, dir, collection_lookup);
+  for (qsizetype i = 0; i < ret.count(); ++i) {
+    Song &song = ret[i];
+    if (!metadata[i].title.isEmpty()) {
+      song.set_title(metadata[i].title);
+    }
+    if (!metadata[i].artist.isEmpty()) {
+      song.set_artist(metadata[i].artist);
+    }
+    if (metadata[i].length > 0) {
+      song.set_length_nanosec(metadata[i].length);
+    }
+  }
+
   return ret;
 
 }
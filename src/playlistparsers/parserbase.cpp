@@ -19,13 +19,19 @@
  *
  */
 
+#include <utility>
+
 #include <QtGlobal>
+#include <QList>
+#include <QHash>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QString>
+#include <QStringList>
 #include <QRegularExpression>
 #include <QUrl>
+#include <QtConcurrentMap>
 
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
@@ -36,15 +42,32 @@
 
 using namespace Qt::Literals::StringLiterals;
 
-ParserBase::ParserBase(const SharedPtr<TagReaderClient> tagreader_client, const SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent)
-    : QObject(parent), tagreader_client_(tagreader_client), collection_backend_(collection_backend) {}
+namespace {
 
-void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const {
+// Picks the song the same way as CollectionBackend::GetSongByUrlAndTrack() and GetSongByUrl().
+Song FindSong(const SongList &songs, const qint64 beginning, const int track) {
 
-  if (filename_or_url.isEmpty()) {
-    return;
+  if (track > 0) {
+    for (const Song &song : songs) {
+      if (song.track() == track) return song;
+    }
+  }
+
+  for (const Song &song : songs) {
+    if (song.beginning_nanosec() == beginning) return song;
   }
 
+  return Song();
+
+}
+
+}  // namespace
+
+ParserBase::ParserBase(const SharedPtr<TagReaderClient> tagreader_client, const SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent)
+    : QObject(parent), tagreader_client_(tagreader_client), collection_backend_(collection_backend) {}
+
+QString ParserBase::LocalFilename(const QString &filename_or_url, const QDir &dir, Song *song) const {
+
   QString filename = filename_or_url;
 
   static const QRegularExpression regex_url_schema(QStringLiteral("^[a-z]{2,}:"), QRegularExpression::CaseInsensitiveOption);
@@ -65,12 +88,12 @@ void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning
       song->set_url(url);
       song->set_filetype(Song::FileType::Stream);
       song->set_valid(true);
-      return;
+      return QString();
     }
     else {
       qLog(Error) << "Don't know how to handle" << url;
       Q_EMIT Error(tr("Don't know how to handle %1").arg(filename_or_url));
-      return;
+      return QString();
     }
   }
 
@@ -81,6 +104,21 @@ void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning
     filename = dir.absoluteFilePath(filename);
   }
 
+  return filename;
+
+}
+
+void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const {
+
+  if (filename_or_url.isEmpty()) {
+    return;
+  }
+
+  const QString filename = LocalFilename(filename_or_url, dir, song);
+  if (filename.isEmpty()) {
+    return;
+  }
+
   const QUrl url = QUrl::fromLocalFile(filename);
 
   // Search the collection
@@ -130,6 +168,108 @@ Song ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning
 
 }
 
+SongList ParserBase::LoadSongs(const QList<SongReference> &references, const QDir &dir, const bool collection_lookup) const {
+
+  SongList songs;
+  songs.reserve(references.count());
+  QStringList filenames;
+  filenames.reserve(references.count());
+  QList<qsizetype> missing;
+  for (const SongReference &reference : references) {
+    Song song(Song::Source::LocalFile);
+    const QString filename = reference.filename_or_url.isEmpty() ? QString() : LocalFilename(reference.filename_or_url, dir, &song);
+    if (!filename.isEmpty()) {
+      missing << songs.count();
+    }
+    filenames << filename;
+    songs << song;
+  }
+
+  if (missing.isEmpty()) return songs;
+
+  // Search the collection for all files at once, then for the canonical paths of the files that were not found.
+  if (collection_backend_ && collection_lookup) {
+    const auto find_in_collection = [this, &references, &songs](const QHash<qsizetype, QUrl> &urls, QList<qsizetype> *not_found) {
+      // Songs stored with a different encoding of the URL are found under every encoding.
+      QHash<QString, SongList> collection_songs;
+      const SongList songs_by_urls = collection_backend_->GetSongsByUrls(urls.values());
+      for (const Song &collection_song : songs_by_urls) {
+        const QStringList encodings = CollectionBackend::UrlEncodings(collection_song.url());
+        for (const QString &encoding : encodings) {
+          collection_songs[encoding] << collection_song;
+        }
+      }
+      for (QHash<qsizetype, QUrl>::const_iterator it = urls.constBegin(); it != urls.constEnd(); ++it) {
+        const SongReference &reference = references[it.key()];
+        SongList url_songs;
+        const QStringList encodings = CollectionBackend::UrlEncodings(it.value());
+        for (const QString &encoding : encodings) {
+          url_songs = collection_songs.value(encoding);
+          if (!url_songs.isEmpty()) break;
+        }
+        const Song collection_song = FindSong(url_songs, reference.beginning, reference.track);
+        if (collection_song.is_valid()) {
+          songs[it.key()] = collection_song;
+        }
+        else if (not_found) {
+          *not_found << it.key();
+        }
+      }
+    };
+
+    QHash<qsizetype, QUrl> urls;
+    for (const qsizetype i : std::as_const(missing)) {
+      urls.insert(i, QUrl::fromLocalFile(filenames[i]));
+    }
+    QList<qsizetype> not_found;
+    find_in_collection(urls, &not_found);
+
+    QHash<qsizetype, QUrl> canonical_urls;
+    for (const qsizetype i : std::as_const(not_found)) {
+      const QString canonical_filepath = QFileInfo(filenames[i]).canonicalFilePath();
+      if (!canonical_filepath.isEmpty() && canonical_filepath != filenames[i]) {
+        canonical_urls.insert(i, QUrl::fromLocalFile(canonical_filepath));
+      }
+    }
+    if (!canonical_urls.isEmpty()) {
+      find_in_collection(canonical_urls, nullptr);
+    }
+
+    missing.clear();
+    for (const qsizetype i : std::as_const(not_found)) {
+      if (!songs[i].is_valid()) missing << i;
+    }
+  }
+
+  // Load the metadata for the rest from disk, each file is only read once, a cue sheet has several songs in the same file.
+  if (tagreader_client_ && !missing.isEmpty()) {
+    QHash<QString, qsizetype> read_indexes;
+    QList<qsizetype> reads;
+    for (const qsizetype i : std::as_const(missing)) {
+      if (!read_indexes.contains(filenames[i])) {
+        read_indexes.insert(filenames[i], i);
+        reads << i;
+      }
+    }
+    Song *songs_data = songs.data();
+    QtConcurrent::blockingMap(reads, [this, songs_data, &filenames](const qsizetype i) {
+      const TagReaderResult result = tagreader_client_->ReadFileBlocking(filenames[i], &songs_data[i]);
+      if (!result.success()) {
+        qLog(Error) << "Could not read file" << filenames[i] << result.error_string();
+      }
+    });
+    for (const qsizetype i : std::as_const(missing)) {
+      const qsizetype read_index = read_indexes.value(filenames[i]);
+      if (read_index != i) {
+        songs[i] = songs[read_index];
+      }
+    }
+  }
+
+  return songs;
+
+}
+
 QString ParserBase::URLOrFilename(const QUrl &url, const QDir &dir, const PlaylistSettings::PathType path_type) {
 
   if (!url.isLocalFile()) return url.toString();
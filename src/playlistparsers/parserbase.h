@@ -31,6 +31,7 @@
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <QList>
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
@@ -73,16 +74,33 @@ class ParserBase : public QObject {
   void Error(const QString &error) const;
 
  protected:
+  // A file or URL from the playlist, to be loaded with LoadSongs().
+  class SongReference {
+   public:
+    SongReference(const QString &_filename_or_url = QString(), const qint64 _beginning = 0, const int _track = 0) : filename_or_url(_filename_or_url), beginning(_beginning), track(_track) {}
+    QString filename_or_url;
+    qint64 beginning;
+    int track;
+  };
+
   // Loads a song.  If filename_or_url is a URL (with a scheme other than "file") then it is set on the song and the song marked as a stream.
   // Also sets the song's metadata by searching in the Collection, or loading from the file as a fallback.
   // This function should always be used when loading a playlist.
   Song LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, const bool collection_lookup) const;
   void LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const;
 
+  // Loads the songs for all references, the same as calling LoadSong() for each of them, returns one song for each reference in the same order.
+  // The collection is searched for all files at once and the files not in the collection are read in parallel, parsers should collect the references first and use this.
+  SongList LoadSongs(const QList<SongReference> &references, const QDir &dir, const bool collection_lookup) const;
+
   // If the URL is a file:// URL then returns its path, absolute or relative to the directory depending on the path_type option.
   // Otherwise, returns the URL as is. This function should always be used when saving a playlist.
   static QString URLOrFilename(const QUrl &url, const QDir &dir, const PlaylistSettings::PathType path_type);
 
+ private:
+  // Sets up streams directly on the song, returns the absolute filename for local files, or an empty string if there is nothing more to load.
+  QString LocalFilename(const QString &filename_or_url, const QDir &dir, Song *song) const;
+
  private:
   const SharedPtr<TagReaderClient> tagreader_client_;
   const SharedPtr<CollectionBackendInterface> collection_backend_;
@@ -18,11 +18,14 @@
  *
  */
 
+#include <utility>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
 #include <QMap>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QRegularExpression>
@@ -45,6 +48,7 @@ ParserBase::LoadResult PLSParser::Load(QIODevice *device, const QString &playlis
 
   Q_UNUSED(playlist_path);
 
+  QMap<int, QString> files;
   QMap<int, Song> songs;
   static const QRegularExpression n_re(u"\\d+$"_s);
 
@@ -58,15 +62,7 @@ ParserBase::LoadResult PLSParser::Load(QIODevice *device, const QString &playlis
     int n = re_match.captured(0).toInt();
 
     if (key.startsWith("file"_L1)) {
-      Song song = LoadSong(value, 0, 0, dir, collection_lookup);
-
-      // Use the title and length we've already loaded if any
-      if (!songs[n].title().isEmpty()) song.set_title(songs[n].title());
-      if (songs[n].length_nanosec() != -1) {
-        song.set_length_nanosec(songs[n].length_nanosec());
-      }
-
-      songs[n] = song;
+      files[n] = value;
     }
     else if (key.startsWith("title"_L1)) {
       songs[n].set_title(value);
@@ -79,6 +75,26 @@ ParserBase::LoadResult PLSParser::Load(QIODevice *device, const QString &playlis
     }
   }
 
+  QList<SongReference> references;
+  references.reserve(files.count());
+  for (const QString &file : std::as_const(files)) {
+    references << SongReference(file);
+  }
+  const SongList loaded_songs = LoadSongs(references, dir, collection_lookup);
+
+  qsizetype i = 0;
+  for (QMap<int, QString>::const_iterator it = files.constBegin(); it != files.constEnd(); ++it, ++i) {
+    Song song = loaded_songs[i];
+
+    // Use the title and length from the playlist if any
+    if (!songs[it.key()].title().isEmpty()) song.set_title(songs[it.key()].title());
+    if (songs[it.key()].length_nanosec() != -1) {
+      song.set_length_nanosec(songs[it.key()].length_nanosec());
+    }
+
+    songs[it.key()] = song;
+  }
+
   return songs.values();
 
 }
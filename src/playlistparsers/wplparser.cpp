@@ -55,16 +55,24 @@ ParserBase::LoadResult WplParser::Load(QIODevice *device, const QString &playlis
     return LoadResult();
   }
 
-  SongList songs;
+  QList<SongReference> references;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, u"seq"_s)) {
-    ParseSeq(dir, &reader, &songs, collection_lookup);
+    ParseSeq(&reader, &references);
+  }
+
+  SongList songs;
+  const SongList loaded_songs = LoadSongs(references, dir, collection_lookup);
+  for (const Song &song : loaded_songs) {
+    if (song.is_valid()) {
+      songs << song;
+    }
   }
 
   return songs;
 
 }
 
-void WplParser::ParseSeq(const QDir &dir, QXmlStreamReader *reader, SongList *songs, const bool collection_lookup) const {
+void WplParser::ParseSeq(QXmlStreamReader *reader, QList<SongReference> *references) const {
 
   while (!reader->atEnd()) {
     QXmlStreamReader::TokenType type = reader->readNext();
@@ -74,10 +82,7 @@ void WplParser::ParseSeq(const QDir &dir, QXmlStreamReader *reader, SongList *so
         if (name == "media"_L1) {
           QString src = reader->attributes().value("src"_L1).toString();
           if (!src.isEmpty()) {
-            Song song = LoadSong(src, 0, 0, dir, collection_lookup);
-            if (song.is_valid()) {
-              songs->append(song);
-            }
+            references->append(SongReference(src));
           }
         }
         else {
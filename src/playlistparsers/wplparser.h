@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <QDir>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
@@ -59,7 +60,7 @@ class WplParser : public XMLParser {
   void Save(const QString &playlist_name, const SongList &songs, QIODevice *device, const QDir &dir, const PlaylistSettings::PathType path_type = PlaylistSettings::PathType::Automatic) const override;
 
  private:
-  void ParseSeq(const QDir &dir, QXmlStreamReader *reader, SongList *songs, const bool collection_lookup) const;
+  void ParseSeq(QXmlStreamReader *reader, QList<SongReference> *references) const;
   static void WriteMeta(const QString &name, const QString &content, QXmlStreamWriter *writer);
 };
 
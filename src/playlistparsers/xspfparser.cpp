@@ -22,6 +22,7 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QUrl>
@@ -64,9 +65,30 @@ ParserBase::LoadResult XSPFParser::Load(QIODevice *device, const QString &playli
   if (!Utilities::ParseUntilElement(&reader, u"trackList"_s)) {
     return LoadResult();
   }
-  SongList songs;
+  QList<SongReference> references;
+  SongList playlist_songs;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, u"track"_s)) {
-    const Song song = ParseTrack(&reader, dir, collection_lookup);
+    SongReference reference;
+    playlist_songs << ParseTrack(&reader, &reference);
+    references << reference;
+  }
+
+  SongList songs;
+  const SongList loaded_songs = LoadSongs(references, dir, collection_lookup);
+  for (qsizetype i = 0; i < loaded_songs.count(); ++i) {
+    Song song = loaded_songs[i];
+
+    // Override metadata with what was in the playlist
+    if (song.source() != Song::Source::Collection) {
+      const Song &playlist_song = playlist_songs[i];
+      if (!playlist_song.title().isEmpty()) song.set_title(playlist_song.title());
+      if (!playlist_song.artist().isEmpty()) song.set_artist(playlist_song.artist());
+      if (!playlist_song.album().isEmpty()) song.set_album(playlist_song.album());
+      if (!playlist_song.art_manual().isEmpty()) song.set_art_manual(playlist_song.art_manual());
+      if (playlist_song.length_nanosec() > 0) song.set_length_nanosec(playlist_song.length_nanosec());
+      if (playlist_song.track() > 0) song.set_track(playlist_song.track());
+    }
+
     if (song.is_valid()) {
       songs << song;
     }
@@ -76,7 +98,7 @@ ParserBase::LoadResult XSPFParser::Load(QIODevice *device, const QString &playli
 
 }
 
-Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_lookup) const {
+Song XSPFParser::ParseTrack(QXmlStreamReader *reader, SongReference *reference) const {
 
   QString platform, location, title, artist, album, art;
   qint64 nanosec = -1;
@@ -137,17 +159,16 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
   }
 
 return_song:
-  Song song = LoadSong(location, 0, track_num, dir, collection_lookup);
-
-  // Override metadata with what was in the playlist
-  if (song.source() != Song::Source::Collection) {
-    if (!title.isEmpty()) song.set_title(title);
-    if (!artist.isEmpty()) song.set_artist(artist);
-    if (!album.isEmpty()) song.set_album(album);
-    if (!art.isEmpty()) song.set_art_manual(QUrl(art));
-    if (nanosec > 0) song.set_length_nanosec(nanosec);
-    if (track_num > 0) song.set_track(track_num);
-  }
+  *reference = SongReference(location, 0, track_num);
+
+  // The metadata from the playlist, used for songs not in the collection.
+  Song song;
+  song.set_title(title);
+  song.set_artist(artist);
+  song.set_album(album);
+  if (!art.isEmpty()) song.set_art_manual(QUrl(art));
+  song.set_length_nanosec(nanosec);
+  song.set_track(track_num);
 
   return song;
 
@@ -56,7 +56,7 @@ class XSPFParser : public XMLParser {
   void Save(const QString &playlist_name, const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettings::PathType path_type = PlaylistSettings::PathType::Automatic) const override;
 
  private:
-  Song ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_lookup) const;
+  Song ParseTrack(QXmlStreamReader *reader, SongReference *reference) const;
 };
 
 #endif
@@ -39,6 +39,7 @@
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
+#include "core/jsonreply.h"
 #include "qobuzservice.h"
 #include "qobuzbaserequest.h"
 
@@ -123,11 +124,10 @@ JsonBaseRequest::JsonObjectResult QobuzBaseRequest::ParseJsonObject(QNetworkRepl
     result.http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   }
 
-  const QByteArray data = reply->readAll();
-  if (!data.isEmpty()) {
-    QJsonParseError json_parse_error;
-    const QJsonDocument json_document = QJsonDocument::fromJson(data, &json_parse_error);
-    if (json_parse_error.error == QJsonParseError::NoError) {
+  const JsonReply json_reply = JsonReply::Read(reply);
+  if (!json_reply.empty) {
+    const QJsonDocument &json_document = json_reply.json_document;
+    if (json_reply.json_parse_error.error == QJsonParseError::NoError) {
       const QJsonObject json_object = json_document.object();
       if (json_object.contains("code"_L1) && json_object.contains("status"_L1) && json_object.contains("message"_L1)) {
         const int code = json_object["code"_L1].toInt();
@@ -141,7 +141,7 @@ JsonBaseRequest::JsonObjectResult QobuzBaseRequest::ParseJsonObject(QNetworkRepl
     }
     else {
       result.error_code = ErrorCode::ParseError;
-      result.error_message = json_parse_error.errorString();
+      result.error_message = json_reply.json_parse_error.errorString();
     }
   }
 
@@ -39,10 +39,12 @@
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
 #include "core/song.h"
+#include "core/jsonreply.h"
 #include "core/networkaccessmanager.h"
 #include "constants/timeconstants.h"
 #include "utilities/imageutils.h"
 #include "utilities/coverutils.h"
+#include "covermanager/covercacheindex.h"
 #include "qobuzservice.h"
 #include "qobuzurlhandler.h"
 #include "qobuzbaserequest.h"
@@ -224,7 +226,7 @@ void QobuzRequest::FlushArtistsRequests() {
     }
     if (!reply) continue;
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++artists_requests_active_;
 
@@ -276,7 +278,7 @@ void QobuzRequest::FlushAlbumsRequests() {
     }
     if (!reply) continue;
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++albums_requests_active_;
 
@@ -328,7 +330,7 @@ void QobuzRequest::FlushSongsRequests() {
     }
     if (!reply) continue;
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++songs_requests_active_;
 
@@ -442,7 +444,7 @@ void QobuzRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
 
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+    SetProgress(artists_received_, artists_total_);
   }
 
   const JsonArrayResult json_array_result = GetJsonArray(object_artists, u"items"_s);
@@ -499,7 +501,7 @@ void QobuzRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
   artists_received_ += artists_received;
 
-  if (offset_requested != 0) Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+  if (offset_requested != 0) SetProgress(artists_received_, artists_total_);
 
 }
 
@@ -568,7 +570,7 @@ void QobuzRequest::FlushArtistAlbumsRequests() {
 
     if (request.offset > 0) params << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(u"artist/get"_s, params);
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); }); });
     replies_ << reply;
 
     ++artist_albums_requests_active_;
@@ -581,7 +583,7 @@ void QobuzRequest::ArtistAlbumsReplyReceived(QNetworkReply *reply, const Artist
 
   --artist_albums_requests_active_;
   ++artist_albums_requests_received_;
-  Q_EMIT UpdateProgress(query_id_, GetProgress(artist_albums_requests_received_, artist_albums_requests_total_));
+  SetProgress(artist_albums_requests_received_, artist_albums_requests_total_);
   AlbumsReceived(reply, artist, 0, offset_requested);
 
 }
@@ -731,7 +733,7 @@ void QobuzRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
 
   if (query_type_ == Type::FavouriteAlbums || query_type_ == Type::SearchAlbums) {
     albums_received_ += albums_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
+    SetProgress(albums_received_, albums_total_);
   }
 
 }
@@ -820,7 +822,7 @@ void QobuzRequest::FlushAlbumSongsRequests() {
     if (request.offset > 0) params << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(u"album/get"_s, params);
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); }); });
 
     ++album_songs_requests_active_;
 
@@ -833,7 +835,7 @@ void QobuzRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const Artist &a
   --album_songs_requests_active_;
   ++album_songs_requests_received_;
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(album_songs_requests_received_, album_songs_requests_total_));
+    SetProgress(album_songs_requests_received_, album_songs_requests_total_);
   }
   SongsReceived(reply, artist, album, 0, offset_requested);
 
@@ -987,7 +989,7 @@ void QobuzRequest::SongsReceived(QNetworkReply *reply, const Artist &artist_requ
 
   if (query_type_ == Type::FavouriteSongs || query_type_ == Type::SearchSongs) {
     songs_received_ += songs_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
+    SetProgress(songs_received_, songs_total_);
   }
 
 }
@@ -1283,7 +1285,7 @@ void QobuzRequest::AlbumCoverReceived(QNetworkReply *reply, const QUrl &cover_ur
 
   const QScopeGuard finish_check = qScopeGuard([this]() { AlbumCoverFinishCheck(); });
 
-  Q_EMIT UpdateProgress(query_id_, GetProgress(album_covers_requests_received_, album_covers_requests_total_));
+  SetProgress(album_covers_requests_received_, album_covers_requests_total_);
 
   if (!album_covers_requests_sent_.contains(cover_url)) {
     return;
@@ -1327,6 +1329,7 @@ void QobuzRequest::AlbumCoverReceived(QNetworkReply *reply, const QUrl &cover_ur
   QImage image;
   if (image.loadFromData(data, format)) {
     if (image.save(filename, format)) {
+      CoverCacheIndex::AddFile(filename);
       while (album_covers_requests_sent_.contains(cover_url)) {
         const QString song_id = album_covers_requests_sent_.take(cover_url);
         if (songs_.contains(song_id)) {
@@ -1402,6 +1405,15 @@ int QobuzRequest::GetProgress(const int count, const int total) {
 
 }
 
+void QobuzRequest::SetProgress(const int count, const int total) {
+
+  const int progress = GetProgress(count, total);
+  if (progress_throttle_.Update(progress, 100)) {
+    Q_EMIT UpdateProgress(query_id_, progress);
+  }
+
+}
+
 void QobuzRequest::Error(const QString &error_message, const QVariant &debug_output) {
 
   qLog(Error) << "Qobuz:" << error_message;
@@ -35,6 +35,7 @@
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "streaming/progressthrottle.h"
 #include "qobuzbaserequest.h"
 
 class QNetworkReply;
@@ -156,6 +157,7 @@ class QobuzRequest : public QobuzBaseRequest {
   void AlbumCoverFinishCheck();
 
   int GetProgress(const int count, const int total);
+  void SetProgress(const int count, const int total);
 
   void FinishCheck();
   static void Warn(const QString &error_message, const QVariant &debug_output = QVariant());
@@ -169,6 +171,7 @@ class QobuzRequest : public QobuzBaseRequest {
   QString search_text_;
 
   bool finished_;
+  ProgressThrottle progress_throttle_;
 
   QQueue<Request> artists_requests_queue_;
   QQueue<Request> albums_requests_queue_;
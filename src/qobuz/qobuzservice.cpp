@@ -672,6 +672,21 @@ void QobuzService::StartSearch() {
 
 void QobuzService::CancelSearch() {}
 
+int QobuzService::search_limit(const SearchType type) const {
+
+  switch (type) {
+    case SearchType::Artists:
+      return artistssearchlimit_;
+    case SearchType::Albums:
+      return albumssearchlimit_;
+    case SearchType::Songs:
+      return songssearchlimit_;
+  }
+
+  return 0;
+
+}
+
 void QobuzService::SendSearch() {
 
   QobuzBaseRequest::Type query_type = QobuzBaseRequest::Type::None;
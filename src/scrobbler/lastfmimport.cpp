@@ -50,7 +50,9 @@
 using namespace Qt::Literals::StringLiterals;
 
 namespace {
-constexpr int kRequestsDelay = 2000;
+// Last.fm allows 5 requests per second averaged over 5 minutes.
+constexpr int kRequestsDelay = 250;
+constexpr int kMaxConcurrentRequests = 4;
 }
 
 LastFMImport::LastFMImport(const SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -94,6 +96,12 @@ void LastFMImport::AbortAll() {
   top_tracks_requests_.clear();
   timer_flush_requests_->stop();
 
+  // Import the pages received so far, the statistics of each received track are complete.
+  if (!statistics_.isEmpty()) {
+    Q_EMIT ImportStatistics(statistics_.values());
+    statistics_.clear();
+  }
+
 }
 
 void LastFMImport::ReloadSettings() {
@@ -196,6 +204,8 @@ void LastFMImport::ImportData(const bool lastplayed, const bool playcount) {
 
 void LastFMImport::FlushRequests() {
 
+  if (replies_.count() >= kMaxConcurrentRequests) return;
+
   if (!recent_tracks_requests_.isEmpty() && (!playcount_ || (playcount_total_ > 0 || top_tracks_requests_.isEmpty()))) {
     SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
     return;
@@ -347,13 +357,14 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
       const QString title = obj_track["name"_L1].toString();
       const QDateTime datetime = QDateTime::fromString(date, u"dd MMM yyyy, hh:mm"_s);
       if (datetime.isValid()) {
-        Q_EMIT UpdateLastPlayed(artist, album, title, datetime.toSecsSinceEpoch());
+        ImportedPlayStatistics &statistics = Statistics(artist, album, title);
+        statistics.lastplayed = qMax(statistics.lastplayed, datetime.toSecsSinceEpoch());
       }
 
-      UpdateProgressCheck();
-
     }
 
+    UpdateProgressCheck();
+
     if (page == 1) {
       for (int i = 2; i <= pages; ++i) {
         AddGetRecentTracksRequest(i);
@@ -499,11 +510,13 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
 
       if (playcount <= 0) continue;
 
-      Q_EMIT UpdatePlayCount(artist, title, playcount, false);
-      UpdateProgressCheck();
+      ImportedPlayStatistics &statistics = Statistics(artist, QString(), title);
+      statistics.playcount = qMax(statistics.playcount, playcount);
 
     }
 
+    UpdateProgressCheck();
+
     if (page == 1) {
       for (int i = 2; i <= pages; ++i) {
         AddGetTopTracksRequest(i);
@@ -516,6 +529,23 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
 
 }
 
+ImportedPlayStatistics &LastFMImport::Statistics(const QString &artist, const QString &album, const QString &title) {
+
+  // Scrobbles of the same track are merged, so the collection only has to be updated once per track.
+  const QString key = artist.toLower() + QLatin1Char('\n') + album.toLower() + QLatin1Char('\n') + title.toLower();
+  QHash<QString, ImportedPlayStatistics>::iterator it = statistics_.find(key);
+  if (it == statistics_.end()) {
+    ImportedPlayStatistics statistics;
+    statistics.artist = artist;
+    statistics.album = album;
+    statistics.title = title;
+    it = statistics_.insert(key, statistics);
+  }
+
+  return it.value();
+
+}
+
 void LastFMImport::UpdateTotalCheck() {
 
   Q_EMIT UpdateTotal(lastplayed_total_, playcount_total_);
@@ -527,7 +557,16 @@ void LastFMImport::UpdateProgressCheck() {
 }
 
 void LastFMImport::FinishCheck() {
-  if (replies_.isEmpty() && recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) Q_EMIT Finished();
+
+  if (!replies_.isEmpty() || !recent_tracks_requests_.isEmpty() || !top_tracks_requests_.isEmpty()) return;
+
+  if (!statistics_.isEmpty()) {
+    Q_EMIT ImportStatistics(statistics_.values());
+    statistics_.clear();
+  }
+
+  Q_EMIT Finished();
+
 }
 
 void LastFMImport::Error(const QString &error, const QVariant &debug) {
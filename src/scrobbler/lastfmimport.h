@@ -23,15 +23,16 @@
 #include "config.h"
 
 #include <QList>
+#include <QHash>
 #include <QVariant>
 #include <QByteArray>
 #include <QString>
 #include <QQueue>
 #include <QDateTime>
 
-#include "core/jsonbaserequest.h"
 #include "includes/shared_ptr.h"
 #include "core/jsonbaserequest.h"
+#include "collection/importedplaystatistics.h"
 
 class QTimer;
 class QNetworkReply;
@@ -80,14 +81,15 @@ class LastFMImport : public JsonBaseRequest {
 
   void Error(const QString &error, const QVariant &debug = QVariant()) override;
 
+  ImportedPlayStatistics &Statistics(const QString &artist, const QString &album, const QString &title);
+
   void UpdateTotalCheck();
   void UpdateProgressCheck();
 
   void FinishCheck();
 
  Q_SIGNALS:
-  void UpdatePlayCount(const QString&, const QString&, const int, const bool = false);
-  void UpdateLastPlayed(const QString&, const QString&, const QString&, const qint64);
+  void ImportStatistics(const ImportedPlayStatisticsList &statistics);
   void UpdateTotal(const int, const int);
   void UpdateProgress(const int, const int);
   void Finished();
@@ -111,6 +113,7 @@ class LastFMImport : public JsonBaseRequest {
   int lastplayed_received_;
   QQueue<GetRecentTracksRequest> recent_tracks_requests_;
   QQueue<GetTopTracksRequest> top_tracks_requests_;
+  QHash<QString, ImportedPlayStatistics> statistics_;
 };
 
 #endif  // LASTFMIMPORT_H
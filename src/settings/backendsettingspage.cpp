@@ -179,6 +179,7 @@ void BackendSettingsPage::Load() {
   ui_->checkbox_bs2b->setChecked(s.value(kBS2B, false).toBool());
 
   ui_->checkbox_playbin3->setChecked(s.value(kPlaybin3, true).toBool());
+  ui_->checkbox_reuse_audio_output->setChecked(s.value(kReuseAudioOutput, false).toBool());
 
   ui_->checkbox_http2->setChecked(s.value(kHTTP2, false).toBool());
   ui_->checkbox_strict_ssl->setChecked(s.value(kStrictSSL, false).toBool());
@@ -443,6 +444,7 @@ void BackendSettingsPage::Save() {
   s.setValue(kBS2B, ui_->checkbox_bs2b->isChecked());
 
   s.setValue(kPlaybin3, ui_->checkbox_playbin3->isChecked());
+  s.setValue(kReuseAudioOutput, ui_->checkbox_reuse_audio_output->isChecked());
 
   s.setValue(kHTTP2, ui_->checkbox_http2->isChecked());
   s.setValue(kStrictSSL, ui_->checkbox_strict_ssl->isChecked());
@@ -24,6 +24,7 @@
 
 #include "includes/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/jsonreply.h"
 #include "spotifyservice.h"
 #include "spotifybaserequest.h"
 
@@ -81,11 +82,10 @@ JsonBaseRequest::JsonObjectResult SpotifyBaseRequest::ParseJsonObject(QNetworkRe
     result.http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   }
 
-  const QByteArray data = reply->readAll();
-  if (!data.isEmpty()) {
-    QJsonParseError json_parse_error;
-    const QJsonDocument json_document = QJsonDocument::fromJson(data, &json_parse_error);
-    if (json_parse_error.error == QJsonParseError::NoError) {
+  const JsonReply json_reply = JsonReply::Read(reply);
+  if (!json_reply.empty) {
+    const QJsonDocument &json_document = json_reply.json_document;
+    if (json_reply.json_parse_error.error == QJsonParseError::NoError) {
       const QJsonObject json_object = json_document.object();
       if (json_object.contains("error"_L1) && json_object["error"_L1].isObject()) {
         const QJsonObject object_error = json_object["error"_L1].toObject();
@@ -102,7 +102,7 @@ JsonBaseRequest::JsonObjectResult SpotifyBaseRequest::ParseJsonObject(QNetworkRe
     }
     else {
       result.error_code = ErrorCode::ParseError;
-      result.error_message = json_parse_error.errorString();
+      result.error_message = json_reply.json_parse_error.errorString();
     }
   }
 
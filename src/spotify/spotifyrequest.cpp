@@ -37,9 +37,11 @@
 #include "constants/timeconstants.h"
 #include "utilities/imageutils.h"
 #include "utilities/coverutils.h"
+#include "covermanager/covercacheindex.h"
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
+#include "core/jsonreply.h"
 #include "spotifyservice.h"
 #include "spotifybaserequest.h"
 #include "spotifyrequest.h"
@@ -237,7 +239,7 @@ void SpotifyRequest::FlushArtistsRequests() {
       reply = CreateRequest(u"search"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++artists_requests_active_;
 
@@ -290,7 +292,7 @@ void SpotifyRequest::FlushAlbumsRequests() {
       reply = CreateRequest(u"search"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++albums_requests_active_;
 
@@ -344,7 +346,7 @@ void SpotifyRequest::FlushSongsRequests() {
       reply = CreateRequest(u"search"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++songs_requests_active_;
 
@@ -454,7 +456,7 @@ void SpotifyRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_
   }
 
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+    SetProgress(artists_received_, artists_total_);
   }
 
   const JsonArrayResult json_array_result = GetJsonArray(obj_artists, u"items"_s);
@@ -506,7 +508,7 @@ void SpotifyRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_
   }
   artists_received_ += artists_received;
 
-  if (offset_requested != 0) Q_EMIT UpdateProgress(query_id_, GetProgress(artists_total_, artists_received_));
+  if (offset_requested != 0) SetProgress(artists_total_, artists_received_);
 
 }
 
@@ -573,7 +575,7 @@ void SpotifyRequest::FlushArtistAlbumsRequests() {
     ParamList parameters;
     if (request.offset > 0) parameters << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters);
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); }); });
 
     ++artist_albums_requests_active_;
 
@@ -585,7 +587,7 @@ void SpotifyRequest::ArtistAlbumsReplyReceived(QNetworkReply *reply, const Artis
 
   --artist_albums_requests_active_;
   ++artist_albums_requests_received_;
-  Q_EMIT UpdateProgress(query_id_, GetProgress(artist_albums_requests_received_, artist_albums_requests_total_));
+  SetProgress(artist_albums_requests_received_, artist_albums_requests_total_);
   AlbumsReceived(reply, artist, 0, offset_requested);
 
 }
@@ -787,7 +789,7 @@ void SpotifyRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_a
 
   if (type_ == Type::FavouriteAlbums || type_ == Type::SearchAlbums) {
     albums_received_ += albums_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
+    SetProgress(albums_received_, albums_total_);
   }
 
 }
@@ -881,7 +883,7 @@ void SpotifyRequest::FlushAlbumSongsRequests() {
     ParamList parameters;
     if (request.offset > 0) parameters << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters);
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); }); });
   }
 
 }
@@ -891,7 +893,7 @@ void SpotifyRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const Artist
   --album_songs_requests_active_;
   ++album_songs_requests_received_;
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(album_songs_requests_received_, album_songs_requests_total_));
+    SetProgress(album_songs_requests_received_, album_songs_requests_total_);
   }
   SongsReceived(reply, artist, album, 0, offset_requested);
 
@@ -996,7 +998,7 @@ void SpotifyRequest::SongsReceived(QNetworkReply *reply, const Artist &artist, c
 
   if (type_ == Type::FavouriteSongs || type_ == Type::SearchSongs) {
     songs_received_ += songs_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
+    SetProgress(songs_received_, songs_total_);
   }
 
 }
@@ -1235,7 +1237,7 @@ void SpotifyRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &alb
 
   const QScopeGuard finish_check = qScopeGuard([this]() { AlbumCoverFinishCheck(); });
 
-  Q_EMIT UpdateProgress(query_id_, GetProgress(album_covers_requests_received_, album_covers_requests_total_));
+  SetProgress(album_covers_requests_received_, album_covers_requests_total_);
 
   if (!album_covers_requests_sent_.contains(album_id)) {
     return;
@@ -1279,6 +1281,7 @@ void SpotifyRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &alb
   QImage image;
   if (image.loadFromData(data, format)) {
     if (image.save(filename, format)) {
+      CoverCacheIndex::AddFile(filename);
       while (album_covers_requests_sent_.contains(album_id)) {
         const QString song_id = album_covers_requests_sent_.take(album_id);
         if (songs_.contains(song_id)) {
@@ -1354,6 +1357,15 @@ int SpotifyRequest::GetProgress(const int count, const int total) {
 
 }
 
+void SpotifyRequest::SetProgress(const int count, const int total) {
+
+  const int progress = GetProgress(count, total);
+  if (progress_throttle_.Update(progress, 100)) {
+    Q_EMIT UpdateProgress(query_id_, progress);
+  }
+
+}
+
 void SpotifyRequest::Error(const QString &error_message, const QVariant &debug_output) {
 
   qLog(Error) << "Spotify:" << error_message;
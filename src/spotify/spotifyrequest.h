@@ -35,6 +35,7 @@
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "streaming/progressthrottle.h"
 #include "spotifybaserequest.h"
 
 class QNetworkReply;
@@ -153,6 +154,7 @@ class SpotifyRequest : public SpotifyBaseRequest {
   void AlbumCoverFinishCheck();
 
   int GetProgress(const int count, const int total);
+  void SetProgress(const int count, const int total);
   void FinishCheck();
   void Error(const QString &error_message, const QVariant &debug_output = QVariant()) override;
   void Warn(const QString &error_message, const QVariant &debug);
@@ -169,6 +171,7 @@ class SpotifyRequest : public SpotifyBaseRequest {
   QString search_text_;
 
   bool finished_;
+  ProgressThrottle progress_throttle_;
 
   QQueue<Request> artists_requests_queue_;
   QQueue<Request> albums_requests_queue_;
@@ -415,6 +415,21 @@ void SpotifyService::StartSearch() {
 
 void SpotifyService::CancelSearch() {}
 
+int SpotifyService::search_limit(const SearchType type) const {
+
+  switch (type) {
+    case SearchType::Artists:
+      return artistssearchlimit_;
+    case SearchType::Albums:
+      return albumssearchlimit_;
+    case SearchType::Songs:
+      return songssearchlimit_;
+  }
+
+  return 0;
+
+}
+
 void SpotifyService::SendSearch() {
 
   SpotifyBaseRequest::Type type = SpotifyBaseRequest::Type::None;
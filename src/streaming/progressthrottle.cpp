@@ -0,0 +1,38 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+
+#include "progressthrottle.h"
+
+namespace {
+constexpr qint64 kUpdateIntervalMsec = 100;
+}  // namespace
+
+bool ProgressThrottle::Update(const int value, const int maximum) {
+
+  if (value > 0 && value < maximum && timer_.isValid() && timer_.elapsed() < kUpdateIntervalMsec) {
+    return false;
+  }
+  timer_.start();
+
+  return true;
+
+}
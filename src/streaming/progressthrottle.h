@@ -0,0 +1,36 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PROGRESSTHROTTLE_H
+#define PROGRESSTHROTTLE_H
+
+#include <QElapsedTimer>
+
+// Limits how often the streaming requests update the progress in the GUI, they receive a reply for every page or album.
+
+class ProgressThrottle {
+ public:
+  // Returns true if the progress should be updated now, the start and the end are always updated.
+  bool Update(const int value, const int maximum);
+
+ private:
+  QElapsedTimer timer_;
+};
+
+#endif  // PROGRESSTHROTTLE_H
@@ -33,9 +33,11 @@
 #include <QApplication>
 #include <QWidget>
 #include <QTimer>
+#include <QDateTime>
 #include <QPair>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QRegularExpression>
@@ -63,11 +65,15 @@
 #include <QContextMenuEvent>
 #include <QShowEvent>
 #include <QHideEvent>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QFutureWatcher>
 
 #include "core/song.h"
 #include "core/iconloader.h"
 #include "core/settings.h"
 #include "core/mimedata.h"
+#include "collection/collectionbackend.h"
 #include "collection/collectionfilterwidget.h"
 #include "collection/collectionmodel.h"
 #include "collection/groupbydialog.h"
@@ -90,6 +96,9 @@ namespace {
 constexpr int kSwapModelsTimeoutMsec = 250;
 constexpr int kDelayedSearchTimeoutMs = 200;
 constexpr int kArtHeight = 32;
+constexpr int kSearchCacheSize = 50;
+constexpr qint64 kSearchCacheTimeoutSec = 600;
+constexpr int kMaxLocalResults = 500;
 }  // namespace
 
 StreamingSearchView::StreamingSearchView(QWidget *parent)
@@ -210,6 +219,9 @@ void StreamingSearchView::Init(const StreamingServicePtr service, const SharedPt
 
 void StreamingSearchView::ReloadSettings() {
 
+  // The search limits might have changed.
+  search_cache_.clear();
+
   Settings s;
 
   // Collection settings
@@ -298,7 +310,7 @@ bool StreamingSearchView::SearchKeyEvent(QKeyEvent *e) {
       break;
 
     case Qt::Key_Return:
-      TextEdited(ui_->search->text());
+      Search(ui_->search->text(), false);
       break;
 
     default:
@@ -363,6 +375,7 @@ void StreamingSearchView::timerEvent(QTimerEvent *e) {
 
   QMap<int, DelayedSearch>::const_iterator it = delayed_searches_.constFind(e->timerId());
   if (it != delayed_searches_.constEnd()) {
+    SearchLocal(it.value().id_, it.value().query_, it.value().type_);
     SearchAsync(it.value().id_, it.value().query_, it.value().type_);
     delayed_searches_.erase(it);
     return;
@@ -385,10 +398,17 @@ void StreamingSearchView::StartSearch(const QString &query) {
 
 void StreamingSearchView::TextEdited(const QString &text) {
 
+  Search(text, true);
+
+}
+
+void StreamingSearchView::Search(const QString &text, const bool use_cache) {
+
   const QString trimmed(text.trimmed());
 
   search_error_ = false;
   cover_loader_tasks_.clear();
+  result_song_keys_.clear();
 
   // Add results to the back model, switch models after some delay.
   back_model_->Clear();
@@ -409,7 +429,10 @@ void StreamingSearchView::TextEdited(const QString &text) {
   }
   else {
     ui_->progressbar->reset();
-    last_search_id_ = SearchAsync(trimmed, search_type_);
+    last_search_id_ = searches_next_id_++;
+    if (!use_cache || !SearchCached(last_search_id_, trimmed, search_type_)) {
+      SearchDelayed(last_search_id_, trimmed, search_type_);
+    }
   }
 
 }
@@ -464,53 +487,181 @@ bool StreamingSearchView::Matches(const QStringList &tokens, const QString &stri
 
 }
 
-int StreamingSearchView::SearchAsync(const QString &query, const StreamingService::SearchType type) {
-
-  const int id = searches_next_id_++;
+void StreamingSearchView::SearchDelayed(const int id, const QString &query, const StreamingService::SearchType type) {
 
   int timer_id = startTimer(kDelayedSearchTimeoutMs);
   delayed_searches_[timer_id].id_ = id;
   delayed_searches_[timer_id].query_ = query;
   delayed_searches_[timer_id].type_ = type;
 
-  return id;
-
 }
 
 void StreamingSearchView::SearchAsync(const int id, const QString &query, const StreamingService::SearchType type) {
 
   const int service_id = service_->Search(query, type);
-  pending_searches_[service_id] = PendingState(id, TokenizeQuery(query));
+  pending_searches_[service_id] = PendingState(id, query, type, TokenizeQuery(query));
 
 }
 
-void StreamingSearchView::SearchDone(const int service_id, const SongMap &songs, const QString &error) {
+bool StreamingSearchView::SearchCached(const int id, const QString &query, const StreamingService::SearchType type) {
 
-  if (!pending_searches_.contains(service_id)) return;
+  const qint64 current_time = QDateTime::currentSecsSinceEpoch();
 
-  // Map back to the original id.
-  const PendingState state = pending_searches_.take(service_id);
-  const int search_id = state.orig_id_;
+  for (QList<CachedSearch>::iterator it = search_cache_.begin(); it != search_cache_.end();) {
+    if (current_time - it->time_ > kSearchCacheTimeoutSec) {
+      it = search_cache_.erase(it);
+      continue;
+    }
+    if (it->type_ == type && query.compare(it->query_, Qt::CaseInsensitive) == 0) {
+      AddSongs(id, it->songs_);
+      return true;
+    }
+    ++it;
+  }
 
-  if (songs.isEmpty()) {
-    SearchError(search_id, error);
-    return;
+  // A longer query can only match fewer songs, so filter the results of a shorter one.
+  // If the service limited the results of the shorter query, show them while the service is searched too.
+  const QStringList tokens = TokenizeQuery(query);
+  for (const CachedSearch &cached_search : std::as_const(search_cache_)) {
+    if (cached_search.type_ != type || !query.startsWith(cached_search.query_, Qt::CaseInsensitive)) continue;
+    SongMap songs;
+    for (const Song &song : cached_search.songs_) {
+      if (Matches(tokens, song.artist() + u' ' + song.albumartist() + u' ' + song.album() + u' ' + song.title())) {
+        songs.insert(song.song_id(), song);
+      }
+    }
+    if (songs.isEmpty()) return false;
+    AddSongs(id, songs);
+    return cached_search.complete_;
+  }
+
+  return false;
+
+}
+
+void StreamingSearchView::SearchLocal(const int id, const QString &query, const StreamingService::SearchType type) {
+
+  // Search the synced table and the columns matching the search type, services without that table only have songs.
+  SharedPtr<CollectionBackend> collection_backend;
+  QStringList columns;
+  switch (type) {
+    case StreamingService::SearchType::Artists:
+      collection_backend = service_->artists_collection_backend();
+      columns << u"artist"_s << u"albumartist"_s;
+      break;
+    case StreamingService::SearchType::Albums:
+      collection_backend = service_->albums_collection_backend();
+      columns << u"albumartist"_s << u"album"_s;
+      break;
+    case StreamingService::SearchType::Songs:
+      collection_backend = service_->songs_collection_backend();
+      columns << u"artist"_s << u"title"_s;
+      break;
+  }
+  if (!collection_backend) collection_backend = service_->songs_collection_backend();
+  if (!collection_backend) return;
+
+  // The tables can have tens of thousands of songs and LIKE can't use an index, so don't block the GUI thread.
+  const QStringList tokens = TokenizeQuery(query);
+  QFuture<SongList> future = QtConcurrent::run([collection_backend, tokens, columns]() { return collection_backend->SearchSongs(tokens, columns, kMaxLocalResults); });
+  QFutureWatcher<SongList> *watcher = new QFutureWatcher<SongList>();
+  QObject::connect(watcher, &QFutureWatcher<SongList>::finished, this, [this, watcher, id]() {
+    const SongList songs = watcher->result();
+    watcher->deleteLater();
+    SongMap song_map;
+    for (const Song &song : songs) {
+      song_map.insert(song.song_id(), song);
+    }
+    AddSongs(id, song_map);
+  });
+  watcher->setFuture(future);
+
+}
+
+void StreamingSearchView::AddCachedSearch(const QString &query, const StreamingService::SearchType type, const SongMap &songs) {
+
+  for (QList<CachedSearch>::iterator it = search_cache_.begin(); it != search_cache_.end(); ++it) {
+    if (it->type_ == type && query.compare(it->query_, Qt::CaseInsensitive) == 0) {
+      search_cache_.erase(it);
+      break;
+    }
   }
 
+  CachedSearch cached_search;
+  cached_search.query_ = query;
+  cached_search.type_ = type;
+  cached_search.songs_ = songs;
+  cached_search.time_ = QDateTime::currentSecsSinceEpoch();
+
+  // The search limit counts artists or albums for those search types, not their songs.
+  const int limit = service_->search_limit(type);
+  QSet<QString> items;
+  for (const Song &song : songs) {
+    switch (type) {
+      case StreamingService::SearchType::Artists:
+        items.insert(song.artist_id().isEmpty() ? song.effective_albumartist() : song.artist_id());
+        break;
+      case StreamingService::SearchType::Albums:
+        items.insert(song.album_id().isEmpty() ? song.effective_albumartist() + u'\n' + song.album() : song.album_id());
+        break;
+      case StreamingService::SearchType::Songs:
+        items.insert(song.song_id());
+        break;
+    }
+  }
+  cached_search.complete_ = limit > 0 && items.count() < limit;
+
+  search_cache_.prepend(cached_search);
+
+  while (search_cache_.count() > kSearchCacheSize) {
+    search_cache_.removeLast();
+  }
+
+}
+
+void StreamingSearchView::AddSongs(const int id, const SongMap &songs) {
+
+  if (id != last_search_id_) return;
+
   ResultList results;
   results.reserve(songs.count());
   for (const Song &song : songs) {
+    const QString key = song.song_id().isEmpty() ? song.url().toString() : song.song_id();
+    if (result_song_keys_.contains(key)) continue;
+    result_song_keys_.insert(key);
     Result result;
     result.metadata_ = song;
+    // Load cached pixmaps into the results
+    result.pixmap_cache_key_ = PixmapCacheKey(result);
     results << result;
   }
 
-  // Load cached pixmaps into the results
-  for (StreamingSearchView::ResultList::iterator it = results.begin(); it != results.end(); ++it) {
-    it->pixmap_cache_key_ = PixmapCacheKey(*it);
+  AddResults(id, results);
+
+}
+
+void StreamingSearchView::SearchDone(const int service_id, const SongMap &songs, const QString &error) {
+
+  if (!pending_searches_.contains(service_id)) return;
+
+  // Map back to the original id.
+  const PendingState state = pending_searches_.take(service_id);
+  const int search_id = state.orig_id_;
+
+  if (songs.isEmpty()) {
+    // Keep showing the results from the local collection.
+    if (search_id == last_search_id_ && !result_song_keys_.isEmpty()) {
+      ui_->label_status->clear();
+      ui_->progressbar->reset();
+      ui_->progressbar->hide();
+      return;
+    }
+    SearchError(search_id, error);
+    return;
   }
 
-  AddResults(search_id, results);
+  AddCachedSearch(state.query_, state.type_, songs);
+  AddSongs(search_id, songs);
 
 }
 
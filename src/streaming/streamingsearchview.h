@@ -28,6 +28,7 @@
 #include <QPair>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -82,9 +83,11 @@ class StreamingSearchView : public QWidget {
 
  protected:
   struct PendingState {
-    PendingState() : orig_id_(-1) {}
-    PendingState(int orig_id, const QStringList &tokens) : orig_id_(orig_id), tokens_(tokens) {}
+    PendingState() : orig_id_(-1), type_(StreamingService::SearchType::Artists) {}
+    PendingState(int orig_id, const QString &query, const StreamingService::SearchType type, const QStringList &tokens) : orig_id_(orig_id), query_(query), type_(type), tokens_(tokens) {}
     int orig_id_;
+    QString query_;
+    StreamingService::SearchType type_;
     QStringList tokens_;
 
     bool operator<(const PendingState &b) const {
@@ -112,6 +115,14 @@ class StreamingSearchView : public QWidget {
     StreamingService::SearchType type_;
   };
 
+  struct CachedSearch {
+    QString query_;
+    StreamingService::SearchType type_;
+    SongMap songs_;
+    qint64 time_;
+    bool complete_;  // Fewer results than the search limit, so there are no other matches.
+  };
+
   bool SearchKeyEvent(QKeyEvent *e);
   bool ResultsContextMenuEvent(QContextMenuEvent *e);
 
@@ -119,8 +130,13 @@ class StreamingSearchView : public QWidget {
 
   void SetSearchType(const StreamingService::SearchType type);
 
-  int SearchAsync(const QString &query, const StreamingService::SearchType type);
+  void Search(const QString &text, const bool use_cache);
+  void SearchDelayed(const int id, const QString &query, const StreamingService::SearchType type);
   void SearchAsync(const int id, const QString &query, const StreamingService::SearchType type);
+  bool SearchCached(const int id, const QString &query, const StreamingService::SearchType type);
+  void SearchLocal(const int id, const QString &query, const StreamingService::SearchType type);
+  void AddCachedSearch(const QString &query, const StreamingService::SearchType type, const SongMap &songs);
+  void AddSongs(const int id, const SongMap &songs);
   void SearchError(const int id, const QString &error);
   void CancelSearch(const int id);
 
@@ -202,6 +218,11 @@ class StreamingSearchView : public QWidget {
   QMap<int, DelayedSearch> delayed_searches_;
   QMap<int, PendingState> pending_searches_;
 
+  // Results of the most recent service searches, the most recent first.
+  QList<CachedSearch> search_cache_;
+  // Songs added for the current search, so the same song from the local collection and the service is only added once.
+  QSet<QString> result_song_keys_;
+
   QMap<quint64, QPair<QModelIndex, QString>> cover_loader_tasks_;
 };
 Q_DECLARE_METATYPE(StreamingSearchView::Result)
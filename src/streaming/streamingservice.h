@@ -59,6 +59,8 @@ class StreamingService : public QObject {
   virtual bool authenticated() const { return false; }
   virtual int Search(const QString &query, const SearchType type) { Q_UNUSED(query); Q_UNUSED(type); return 0; }
   virtual void CancelSearch() {}
+  // The most artists, albums or songs a search returns, 0 if not known.
+  virtual int search_limit(const SearchType type) const { Q_UNUSED(type); return 0; }
   virtual bool show_progress() const { return true; }
   virtual bool enable_refresh_button() const { return true; }
 
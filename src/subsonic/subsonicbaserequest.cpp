@@ -40,6 +40,7 @@
 #include <QJsonObject>
 #include <QJsonValue>
 
+#include "core/jsonreply.h"
 #include "utilities/randutils.h"
 #include "subsonicservice.h"
 #include "subsonicbaserequest.h"
@@ -132,6 +133,12 @@ void SubsonicBaseRequest::HandleSSLErrors(const QList<QSslError> &ssl_errors) {
 
 JsonBaseRequest::JsonObjectResult SubsonicBaseRequest::ParseJsonObject(QNetworkReply *reply) {
 
+  return ParseJsonObject(reply, JsonReply::Read(reply));
+
+}
+
+JsonBaseRequest::JsonObjectResult SubsonicBaseRequest::ParseJsonObject(QNetworkReply *reply, const JsonReply &json_reply) {
+
   if (reply->error() != QNetworkReply::NoError && reply->error() < 200) {
     return JsonObjectResult(ErrorCode::NetworkError, QStringLiteral("%1 (%2)").arg(reply->errorString()).arg(reply->error()));
   }
@@ -142,11 +149,9 @@ JsonBaseRequest::JsonObjectResult SubsonicBaseRequest::ParseJsonObject(QNetworkR
     result.http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   }
 
-  const QByteArray data = reply->readAll();
-  if (!data.isEmpty()) {
-    QJsonParseError json_parse_error;
-    const QJsonDocument json_document = QJsonDocument::fromJson(data, &json_parse_error);
-    if (json_parse_error.error == QJsonParseError::NoError) {
+  if (!json_reply.empty) {
+    const QJsonDocument &json_document = json_reply.json_document;
+    if (json_reply.json_parse_error.error == QJsonParseError::NoError) {
       const QJsonObject json_object = json_document.object();
       if (!json_object.isEmpty() && json_object.contains("error"_L1) && json_object["error"_L1].isObject()) {
         const QJsonObject object_error = json_object["error"_L1].toObject();
@@ -168,7 +173,7 @@ JsonBaseRequest::JsonObjectResult SubsonicBaseRequest::ParseJsonObject(QNetworkR
     }
     else {
       result.error_code = ErrorCode::ParseError;
-      result.error_message = json_parse_error.errorString();
+      result.error_message = json_reply.json_parse_error.errorString();
     }
   }
 
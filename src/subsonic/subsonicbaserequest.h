@@ -41,6 +41,7 @@
 
 class QNetworkAccessManager;
 class QNetworkReply;
+class JsonReply;
 
 class SubsonicBaseRequest : public QObject {
   Q_OBJECT
@@ -61,6 +62,7 @@ class SubsonicBaseRequest : public QObject {
  protected:
   QNetworkReply *CreateGetRequest(const QString &ressource_name, const ParamList &params_provided) const;
   JsonObjectResult ParseJsonObject(QNetworkReply *reply);
+  JsonObjectResult ParseJsonObject(QNetworkReply *reply, const JsonReply &json_reply);
 
   virtual void Error(const QString &error, const QVariant &debug = QVariant()) = 0;
 
@@ -19,6 +19,8 @@
 
 #include "config.h"
 
+#include <utility>
+
 #include <QObject>
 #include <QDir>
 #include <QMimeDatabase>
@@ -38,13 +40,16 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonValue>
+#include <QVariant>
 
 #include "core/logging.h"
 #include "core/song.h"
 #include "core/networktimeouts.h"
+#include "core/jsonreply.h"
 #include "utilities/strutils.h"
 #include "utilities/imageutils.h"
 #include "constants/timeconstants.h"
+#include "covermanager/covercacheindex.h"
 #include "subsonicservice.h"
 #include "subsonicurlhandler.h"
 #include "subsonicbaserequest.h"
@@ -56,6 +61,21 @@ namespace {
 constexpr int kMaxConcurrentAlbumsRequests = 3;
 constexpr int kMaxConcurrentAlbumSongsRequests = 3;
 constexpr int kMaxConcurrentAlbumCoverRequests = 1;
+
+// The time the album was last changed on the server, OpenSubsonic servers send "changed", others only "created".
+qint64 AlbumChangedTime(const QJsonObject &object_album) {
+
+  if (object_album.contains("changed"_L1)) {
+    return QDateTime::fromString(object_album["changed"_L1].toString(), Qt::ISODate).toSecsSinceEpoch();
+  }
+  if (object_album.contains("created"_L1)) {
+    return QDateTime::fromString(object_album["created"_L1].toString(), Qt::ISODate).toSecsSinceEpoch();
+  }
+
+  return 0;
+
+}
+
 }  // namespace
 
 SubsonicRequest::SubsonicRequest(SubsonicService *service, SubsonicUrlHandler *url_handler, QObject *parent)
@@ -72,6 +92,7 @@ SubsonicRequest::SubsonicRequest(SubsonicService *service, SubsonicUrlHandler *u
       album_covers_requests_active_(0),
       album_covers_requested_(0),
       album_covers_received_(0),
+      albums_reused_(0),
       no_results_(false) {
 
   network_->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
@@ -114,12 +135,26 @@ void SubsonicRequest::Reset() {
   album_covers_requested_ = 0;
   album_covers_received_ = 0;
 
+  albums_reused_ = 0;
+
   songs_.clear();
   cover_urls_.clear();
   errors_.clear();
   no_results_ = false;
   replies_.clear();
   album_cover_replies_.clear();
+  albums_replies_parsing_.clear();
+
+}
+
+void SubsonicRequest::SetPreviousSync(const SongList &songs) {
+
+  previous_album_songs_.clear();
+  for (const Song &song : songs) {
+    if (!song.album_id().isEmpty()) {
+      previous_album_songs_[song.album_id()] << song;
+    }
+  }
 
 }
 
@@ -131,6 +166,27 @@ void SubsonicRequest::GetAlbums() {
 
 }
 
+bool SubsonicRequest::IsAlbumUnchanged(const QString &album_id, const QString &album, const QJsonObject &object_album) const {
+
+  const SongList songs = previous_album_songs_.value(album_id);
+  if (songs.isEmpty() || !object_album.contains("songCount"_L1) || !object_album.contains("duration"_L1)) {
+    return false;
+  }
+
+  // The songs keep the time the album was changed in mtime, so retagged albums are requested again.
+  const qint64 changed = AlbumChangedTime(object_album);
+  if (changed <= 0) return false;
+
+  qint64 duration = 0;
+  for (const Song &song : songs) {
+    if (song.album() != album || song.mtime() != changed) return false;
+    duration += song.length_nanosec() / kNsecPerSec;
+  }
+
+  return songs.count() == object_album["songCount"_L1].toVariant().toLongLong() && duration == object_album["duration"_L1].toVariant().toLongLong();
+
+}
+
 void SubsonicRequest::AddAlbumsRequest(const int offset, const int size) {
 
   Request request;
@@ -154,28 +210,63 @@ void SubsonicRequest::FlushAlbumsRequests() {
 
     QNetworkReply *reply = CreateGetRequest(u"getAlbumList2"_s, params);
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.offset, request.size); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyFinished(reply, request.offset, request.size); });
     timeouts_->AddReply(reply);
 
   }
 
 }
 
-void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset_requested, const int size_requested) {
+void SubsonicRequest::AlbumsReplyFinished(QNetworkReply *reply, const int offset_requested, const int size_requested) {
 
   if (!replies_.contains(reply)) return;
   replies_.removeAll(reply);
   QObject::disconnect(reply, nullptr, this, nullptr);
-  reply->deleteLater();
+
+  // Album lists can be large, read the albums one at a time in a worker thread instead of parsing the whole reply into a document.
+  // The albums are parsed in batches by AlbumsReceived() while reading, and the reply is deleted by JsonReply after AlbumsReplyReceived().
+  const bool reply_ok = reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200;
+  albums_replies_parsing_.insert(reply, 0);
+  JsonReply::ParseArrayInBackground(reply, QByteArrayList() << "subsonic-response" << "albumList2" << "album", this,
+                                    [this, reply_ok](QNetworkReply *parsed_reply, const QList<QJsonObject> &objects_album) { if (reply_ok) AlbumsReceived(parsed_reply, objects_album); },
+                                    [this, offset_requested, size_requested](QNetworkReply *parsed_reply, const JsonReply &json_reply) { AlbumsReplyReceived(parsed_reply, json_reply, offset_requested, size_requested); });
+
+}
+
+void SubsonicRequest::AlbumsReceived(QNetworkReply *reply, const QList<QJsonObject> &objects_album) {
+
+  if (!albums_replies_parsing_.contains(reply) || finished_) return;
+
+  albums_replies_parsing_[reply] += static_cast<int>(objects_album.count());
+  for (const QJsonObject &object_album : objects_album) {
+    ParseAlbum(object_album);
+  }
+
+}
+
+void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const JsonReply &json_reply, const int offset_requested, const int size_requested) {
+
+  if (!albums_replies_parsing_.contains(reply)) return;
+  int albums_received = albums_replies_parsing_.take(reply);
 
   --albums_requests_active_;
 
-  int albums_received = 0;
   const QScopeGuard finish_check = qScopeGuard([this, offset_requested, size_requested, &albums_received]() { AlbumsFinishCheck(offset_requested, size_requested, albums_received); });
 
   if (finished_) return;
 
-  const JsonObjectResult json_object_result = ParseJsonObject(reply);
+  if (json_reply.array_found && reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
+    if (json_reply.array_error) {
+      Error(u"Invalid Json reply, could not parse album list."_s);
+    }
+    else if (albums_received == 0 && offset_requested == 0) {
+      no_results_ = true;
+    }
+    return;
+  }
+
+  // Errors, empty lists and servers only supporting albumList are parsed as a whole document.
+  const JsonObjectResult json_object_result = ParseJsonObject(reply, json_reply);
   if (!json_object_result.success()) {
     Error(json_object_result.error_message);
     return;
@@ -229,37 +320,52 @@ void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset
       Error(u"Invalid Json reply, album is not an object."_s);
       continue;
     }
-    const QJsonObject object_album = value_album.toObject();
 
-    if (!object_album.contains("id"_L1) || !object_album.contains("artist"_L1)) {
-      Error(u"Invalid Json reply, album object in array is missing ID or artist."_s, object_album);
-      continue;
-    }
+    ParseAlbum(value_album.toObject());
 
-    if (!object_album.contains("album"_L1) && !object_album.contains("name"_L1)) {
-      Error(u"Invalid Json reply, album object in array is missing album or name."_s, object_album);
-      continue;
-    }
+  }
 
-    QString album_id = object_album["id"_L1].toString();
-    if (album_id.isEmpty()) {
-      album_id = QString::number(object_album["id"_L1].toInt());
-    }
+}
 
-    const QString artist = object_album["artist"_L1].toString();
-    QString album;
-    if (object_album.contains("album"_L1)) album = object_album["album"_L1].toString();
-    else if (object_album.contains("name"_L1)) album = object_album["name"_L1].toString();
+void SubsonicRequest::ParseAlbum(const QJsonObject &object_album) {
 
-    if (album_songs_requests_pending_.contains(album_id)) continue;
+  if (!object_album.contains("id"_L1) || !object_album.contains("artist"_L1)) {
+    Error(u"Invalid Json reply, album object in array is missing ID or artist."_s, object_album);
+    return;
+  }
 
-    Request request;
-    request.album_id = album_id;
-    request.album_artist = artist;
-    album_songs_requests_pending_.insert(album_id, request);
+  if (!object_album.contains("album"_L1) && !object_album.contains("name"_L1)) {
+    Error(u"Invalid Json reply, album object in array is missing album or name."_s, object_album);
+    return;
+  }
 
+  QString album_id = object_album["id"_L1].toString();
+  if (album_id.isEmpty()) {
+    album_id = QString::number(object_album["id"_L1].toInt());
   }
 
+  const QString artist = object_album["artist"_L1].toString();
+  QString album;
+  if (object_album.contains("album"_L1)) album = object_album["album"_L1].toString();
+  else if (object_album.contains("name"_L1)) album = object_album["name"_L1].toString();
+
+  if (album_songs_requests_pending_.contains(album_id)) return;
+
+  // Use the songs from the previous sync instead of requesting them again.
+  if (IsAlbumUnchanged(album_id, album, object_album)) {
+    const SongList songs = previous_album_songs_.value(album_id);
+    for (const Song &song : songs) {
+      songs_.insert(song.song_id(), song);
+    }
+    ++albums_reused_;
+    return;
+  }
+
+  Request request;
+  request.album_id = album_id;
+  request.album_artist = artist;
+  album_songs_requests_pending_.insert(album_id, request);
+
 }
 
 void SubsonicRequest::AlbumsFinishCheck(const int offset, const int size, const int albums_received) {
@@ -277,6 +383,10 @@ void SubsonicRequest::AlbumsFinishCheck(const int offset, const int size, const
 
   if (albums_requests_queue_.isEmpty() && albums_requests_active_ <= 0) { // Albums list is finished, get songs for all albums.
 
+    if (albums_reused_ > 0) {
+      qLog(Debug) << "Subsonic:" << albums_reused_ << "albums unchanged since the previous sync," << album_songs_requests_pending_.count() << "albums to update.";
+    }
+
     for (QHash<QString, Request>::const_iterator it = album_songs_requests_pending_.constBegin(); it != album_songs_requests_pending_.constEnd(); ++it) {
       const Request request = it.value();
       AddAlbumSongsRequest(request.artist_id, request.album_id, request.album_artist);
@@ -315,7 +425,7 @@ void SubsonicRequest::FlushAlbumSongsRequests() {
     ++album_songs_requests_active_;
     QNetworkReply *reply = CreateGetRequest(u"getAlbum"_s, ParamList() << Param(u"id"_s, request.album_id));
     replies_ << reply;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist_id, request.album_id, request.album_artist); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist_id, request.album_id, request.album_artist); }); });
     timeouts_->AddReply(reply);
   }
 
@@ -331,7 +441,9 @@ void SubsonicRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const QStrin
   --album_songs_requests_active_;
   ++album_songs_received_;
 
-  Q_EMIT UpdateProgress(album_songs_received_);
+  if (progress_throttle_.Update(album_songs_received_, album_songs_requested_)) {
+    Q_EMIT UpdateProgress(album_songs_received_);
+  }
 
   const QScopeGuard finish_check = qScopeGuard([this]() { SongsFinishCheck(); });
 
@@ -375,6 +487,7 @@ void SubsonicRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const QStrin
   if (object_album.contains("created"_L1)) {
     created = QDateTime::fromString(object_album["created"_L1].toString(), Qt::ISODate).toSecsSinceEpoch();
   }
+  const qint64 changed = AlbumChangedTime(object_album);
 
   QString album_cover_id;
   if (object_album.contains("coverArt"_L1)) {
@@ -410,6 +523,7 @@ void SubsonicRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const QStrin
     if (!multidisc) {
       song.set_disc(0);
     }
+    if (changed > 0) song.set_mtime(changed);
     songs_.insert(song.song_id(), song);
   }
 
@@ -780,6 +894,7 @@ void SubsonicRequest::AlbumCoverReceived(QNetworkReply *reply, const AlbumCoverR
   QImage image;
   if (image.loadFromData(data, format)) {
     if (image.save(request.filename, format)) {
+      CoverCacheIndex::AddFile(request.filename);
       while (album_covers_requests_sent_.contains(request.cover_id)) {
         const QString song_id = album_covers_requests_sent_.take(request.cover_id);
         if (songs_.contains(song_id)) {
@@ -38,6 +38,7 @@
 #include <QJsonObject>
 
 #include "core/song.h"
+#include "streaming/progressthrottle.h"
 #include "subsonicbaserequest.h"
 
 class QNetworkAccessManager;
@@ -55,6 +56,9 @@ class SubsonicRequest : public SubsonicBaseRequest {
 
   void ReloadSettings();
 
+  // Songs from the previous sync, the songs of albums that were not changed on the server since are not requested again.
+  void SetPreviousSync(const SongList &songs);
+
   void GetAlbums();
   void Reset();
 
@@ -83,14 +87,19 @@ class SubsonicRequest : public SubsonicBaseRequest {
   void UpdateProgress(const int progress);
 
  private Q_SLOTS:
-  void AlbumsReplyReceived(QNetworkReply *reply, const int offset_requested, const int size_requested);
+  void AlbumsReplyFinished(QNetworkReply *reply, const int offset_requested, const int size_requested);
   void AlbumSongsReplyReceived(QNetworkReply *reply, const QString &artist_id, const QString &album_id, const QString &album_artist);
   void AlbumCoverReceived(QNetworkReply *reply, const SubsonicRequest::AlbumCoverRequest &request);
 
  private:
 
+  bool IsAlbumUnchanged(const QString &album_id, const QString &album, const QJsonObject &object_album) const;
+
   void AddAlbumsRequest(const int offset = 0, const int size = 500);
   void FlushAlbumsRequests();
+  void AlbumsReceived(QNetworkReply *reply, const QList<QJsonObject> &objects_album);
+  void AlbumsReplyReceived(QNetworkReply *reply, const JsonReply &json_reply, const int offset_requested, const int size_requested);
+  void ParseAlbum(const QJsonObject &object_album);
 
   void AlbumsFinishCheck(const int offset = 0, const int size = 0, const int albums_received = 0);
   void SongsFinishCheck();
@@ -115,6 +124,7 @@ class SubsonicRequest : public SubsonicBaseRequest {
   NetworkTimeouts *timeouts_;
 
   bool finished_;
+  ProgressThrottle progress_throttle_;
 
   QQueue<Request> albums_requests_queue_;
   QQueue<Request> album_songs_requests_queue_;
@@ -134,12 +144,16 @@ class SubsonicRequest : public SubsonicBaseRequest {
   int album_covers_requested_;
   int album_covers_received_;
 
+  QHash<QString, SongList> previous_album_songs_;
+  int albums_reused_;
+
   SongMap songs_;
   QMap<QString, QUrl> cover_urls_;
   QStringList errors_;
   bool no_results_;
   QList<QNetworkReply*> replies_;
   QList<QNetworkReply*> album_cover_replies_;
+  QHash<QNetworkReply*, int> albums_replies_parsing_;  // Albums received so far from each reply being parsed
 };
 
 #endif  // SUBSONICREQUEST_H
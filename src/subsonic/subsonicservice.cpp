@@ -41,6 +41,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSettings>
+#include <QDateTime>
 
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
@@ -68,6 +69,7 @@ const char *SubsonicService::kApiVersion = "1.11.0";
 namespace {
 constexpr char kSongsTable[] = "subsonic_songs";
 constexpr int kMaxRedirects = 3;
+constexpr qint64 kFullSyncIntervalSecs = 7LL * 24LL * 60LL * 60LL;
 }  // namespace
 
 SubsonicService::SubsonicService(const SharedPtr<TaskManager> task_manager,
@@ -84,7 +86,8 @@ SubsonicService::SubsonicService(const SharedPtr<TaskManager> task_manager,
       download_album_covers_(true),
       use_album_id_for_album_covers_(false),
       auth_method_(SubsonicSettings::AuthMethod::MD5),
-      ping_redirects_(0) {
+      ping_redirects_(0),
+      get_songs_id_(0) {
 
   url_handlers->Register(url_handler_);
 
@@ -92,6 +95,7 @@ SubsonicService::SubsonicService(const SharedPtr<TaskManager> task_manager,
   collection_backend_->moveToThread(database->thread());
   collection_backend_->Init(database, task_manager, Song::Source::Subsonic, QLatin1String(kSongsTable));
   collection_model_ = new CollectionModel(collection_backend_, albumcover_loader, this);
+  QObject::connect(&*collection_backend_, &CollectionBackend::GotSongs, this, &SubsonicService::PreviousSongsReceived);
 
   SubsonicService::ReloadSettings();
 
@@ -423,18 +427,66 @@ void SubsonicService::GetSongs() {
   QObject::connect(&*songs_request_, &SubsonicRequest::ProgressSetMaximum, this, &SubsonicService::SongsProgressSetMaximum);
   QObject::connect(&*songs_request_, &SubsonicRequest::UpdateProgress, this, &SubsonicService::SongsUpdateProgress);
 
+  // Only reuse the songs in the collection if they were synced from the same server, and do a full sync now and then.
+  Settings s;
+  s.beginGroup(SubsonicSettings::kSettingsGroup);
+  const bool reuse_songs = s.value(SubsonicSettings::kSyncServer).toString() == SyncServer() && QDateTime::currentSecsSinceEpoch() - s.value(SubsonicSettings::kSyncFullTime, 0).toLongLong() < kFullSyncIntervalSecs;
+  s.endGroup();
+
+  ++get_songs_id_;
+  if (reuse_songs) {
+    collection_backend_->GetAllSongsAsync(get_songs_id_);
+  }
+  else {
+    songs_request_->GetAlbums();
+  }
+
+}
+
+void SubsonicService::PreviousSongsReceived(const SongList &songs, const int id) {
+
+  if (id != get_songs_id_ || !songs_request_) return;
+
+  songs_request_->SetPreviousSync(songs);
   songs_request_->GetAlbums();
 
 }
 
 void SubsonicService::DeleteSongs() {
 
+  ResetSync();
   collection_backend_->DeleteAllAsync();
 
 }
 
+void SubsonicService::ResetSync() {
+
+  Settings s;
+  s.beginGroup(SubsonicSettings::kSettingsGroup);
+  s.remove(SubsonicSettings::kSyncServer);
+  s.remove(SubsonicSettings::kSyncFullTime);
+  s.endGroup();
+
+}
+
+QString SubsonicService::SyncServer() const {
+
+  return server_url_.toString() + QLatin1Char('|') + username_;
+
+}
+
 void SubsonicService::SongsResultsReceived(const SongMap &songs, const QString &error) {
 
+  if (error.isEmpty() && songs_request_) {
+    Settings s;
+    s.beginGroup(SubsonicSettings::kSettingsGroup);
+    if (s.value(SubsonicSettings::kSyncServer).toString() != SyncServer() || QDateTime::currentSecsSinceEpoch() - s.value(SubsonicSettings::kSyncFullTime, 0).toLongLong() >= kFullSyncIntervalSecs) {
+      s.setValue(SubsonicSettings::kSyncFullTime, QDateTime::currentSecsSinceEpoch());
+    }
+    s.setValue(SubsonicSettings::kSyncServer, SyncServer());
+    s.endGroup();
+  }
+
   Q_EMIT SongsResults(songs, error);
 
   ResetSongsRequest();
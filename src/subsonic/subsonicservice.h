@@ -100,15 +100,18 @@ class SubsonicService : public StreamingService {
   void SendPingWithCredentials(QUrl url, const QString &username, const QString &password, const SubsonicSettings::AuthMethod auth_method, const bool redirect = false);
   void GetSongs() override;
   void DeleteSongs();
+  void ResetSync();
   void ResetSongsRequest() override;
 
  private Q_SLOTS:
   void HandlePingSSLErrors(const QList<QSslError> &ssl_errors);
   void HandlePingReply(QNetworkReply *reply, const QUrl &url, const QString &username, const QString &password, const SubsonicSettings::AuthMethod auth_method);
   void SongsResultsReceived(const SongMap &songs, const QString &error);
+  void PreviousSongsReceived(const SongList &songs, const int id);
 
  private:
   void PingError(const QString &error = QString(), const QVariant &debug = QVariant());
+  QString SyncServer() const;
 
   ScopedPtr<QNetworkAccessManager> network_;
   SubsonicUrlHandler *url_handler_;
@@ -130,6 +133,7 @@ class SubsonicService : public StreamingService {
 
   QStringList errors_;
   int ping_redirects_;
+  int get_songs_id_;
 
   QList<QNetworkReply*> replies_;
 };
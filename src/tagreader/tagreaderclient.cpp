@@ -31,6 +31,7 @@
 
 #include "core/logging.h"
 #include "core/song.h"
+#include "core/tracing.h"
 
 #include "tagreaderclient.h"
 #include "tagreadertaglib.h"
@@ -106,6 +107,7 @@ void TagReaderClient::EnqueueRequest(TagReaderRequestPtr request) {
   {
     QMutexLocker l(&mutex_requests_);
     requests_.enqueue(request);
+    tracing::SetCounter("tagreader", "Queue depth", requests_.count());
   }
 
   if (!processing_.value()) {
@@ -121,7 +123,9 @@ TagReaderRequestPtr TagReaderClient::DequeueRequest() {
   {
     QMutexLocker l(&mutex_requests_);
     if (requests_.isEmpty()) return TagReaderRequestPtr();
-    return requests_.dequeue();
+    TagReaderRequestPtr request = requests_.dequeue();
+    tracing::SetCounter("tagreader", "Queue depth", requests_.count());
+    return request;
   }
 
 }
@@ -155,6 +159,8 @@ void TagReaderClient::ProcessRequest(TagReaderRequestPtr request) {
 
   Q_ASSERT(QThread::currentThread() == thread());
 
+  TRACE_SCOPE("tagreader", "Process request");
+
   TagReaderReplyPtr reply = request->reply;
 
   TagReaderResult result;
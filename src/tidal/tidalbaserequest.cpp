@@ -28,6 +28,7 @@
 #include "includes/shared_ptr.h"
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
+#include "core/jsonreply.h"
 #include "tidalservice.h"
 #include "tidalbaserequest.h"
 
@@ -88,11 +89,10 @@ JsonBaseRequest::JsonObjectResult TidalBaseRequest::ParseJsonObject(QNetworkRepl
     result.http_status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   }
 
-  const QByteArray data = reply->readAll();
-  if (!data.isEmpty()) {
-    QJsonParseError json_parse_error;
-    const QJsonDocument json_document = QJsonDocument::fromJson(data, &json_parse_error);
-    if (json_parse_error.error == QJsonParseError::NoError) {
+  const JsonReply json_reply = JsonReply::Read(reply);
+  if (!json_reply.empty) {
+    const QJsonDocument &json_document = json_reply.json_document;
+    if (json_reply.json_parse_error.error == QJsonParseError::NoError) {
       const QJsonObject json_object = json_document.object();
       if (json_object.contains("status"_L1) && json_object.contains("subStatus"_L1) && json_object.contains("userMessage"_L1)) {
         const int status = json_object["status"_L1].toInt();
@@ -108,7 +108,7 @@ JsonBaseRequest::JsonObjectResult TidalBaseRequest::ParseJsonObject(QNetworkRepl
     }
     else {
       result.error_code = ErrorCode::ParseError;
-      result.error_message = json_parse_error.errorString();
+      result.error_message = json_reply.json_parse_error.errorString();
     }
   }
 
@@ -40,9 +40,11 @@
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
+#include "core/jsonreply.h"
 #include "constants/timeconstants.h"
 #include "utilities/imageutils.h"
 #include "utilities/coverutils.h"
+#include "covermanager/covercacheindex.h"
 #include "tidalservice.h"
 #include "tidalurlhandler.h"
 #include "tidalbaserequest.h"
@@ -223,7 +225,7 @@ void TidalRequest::FlushArtistsRequests() {
       reply = CreateRequest(u"search/artists"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++artists_requests_active_;
 
@@ -270,7 +272,7 @@ void TidalRequest::FlushAlbumsRequests() {
       reply = CreateRequest(u"search/albums"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++albums_requests_active_;
 
@@ -317,7 +319,7 @@ void TidalRequest::FlushSongsRequests() {
       reply = CreateRequest(u"search/tracks"_s, parameters);
     }
     if (!reply) continue;
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { SongsReplyReceived(reply, request.limit, request.offset); }); });
 
     ++songs_requests_active_;
 
@@ -416,7 +418,7 @@ void TidalRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
 
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+    SetProgress(artists_received_, artists_total_);
   }
 
   const JsonArrayResult json_array_result = GetJsonArray(json_object, u"items"_s);
@@ -472,7 +474,7 @@ void TidalRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
   artists_received_ += artists_received;
 
-  if (offset_requested != 0) Q_EMIT UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
+  if (offset_requested != 0) SetProgress(artists_received_, artists_total_);
 
 }
 
@@ -539,7 +541,7 @@ void TidalRequest::FlushArtistAlbumsRequests() {
     ParamList parameters;
     if (request.offset > 0) parameters << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters);
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); }); });
 
     ++artist_albums_requests_active_;
 
@@ -551,7 +553,7 @@ void TidalRequest::ArtistAlbumsReplyReceived(QNetworkReply *reply, const Artist
 
   --artist_albums_requests_active_;
   ++artist_albums_requests_received_;
-  Q_EMIT UpdateProgress(query_id_, GetProgress(artist_albums_requests_received_, artist_albums_requests_total_));
+  SetProgress(artist_albums_requests_received_, artist_albums_requests_total_);
   AlbumsReceived(reply, artist, 0, offset_requested);
 
 }
@@ -720,7 +722,7 @@ void TidalRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
 
   if (query_type_ == Type::FavouriteAlbums || query_type_ == Type::SearchAlbums) {
     albums_received_ += albums_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
+    SetProgress(albums_received_, albums_total_);
   }
 
 }
@@ -813,7 +815,7 @@ void TidalRequest::FlushAlbumSongsRequests() {
     ParamList parameters;
     if (request.offset > 0) parameters << Param(u"offset"_s, QString::number(request.offset));
     QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters);
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { JsonReply::ParseInBackground(reply, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); }); });
 
     ++album_songs_requests_active_;
 
@@ -826,7 +828,7 @@ void TidalRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const Artist &a
   --album_songs_requests_active_;
   ++album_songs_requests_received_;
   if (offset_requested == 0) {
-    Q_EMIT UpdateProgress(query_id_, GetProgress(album_songs_requests_received_, album_songs_requests_total_));
+    SetProgress(album_songs_requests_received_, album_songs_requests_total_);
   }
   SongsReceived(reply, artist, album, 0, offset_requested);
 
@@ -922,7 +924,7 @@ void TidalRequest::SongsReceived(QNetworkReply *reply, const Artist &artist, con
 
   if (query_type_ == Type::FavouriteSongs || query_type_ == Type::SearchSongs) {
     songs_received_ += songs_received;
-    Q_EMIT UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
+    SetProgress(songs_received_, songs_total_);
   }
 
 }
@@ -1203,7 +1205,7 @@ void TidalRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &album
 
   const QScopeGuard finish_check = qScopeGuard([this]() { AlbumCoverFinishCheck(); });
 
-  Q_EMIT UpdateProgress(query_id_, GetProgress(album_covers_requests_received_, album_covers_requests_total_));
+  SetProgress(album_covers_requests_received_, album_covers_requests_total_);
 
   if (!album_covers_requests_sent_.contains(album_id)) {
     return;
@@ -1247,6 +1249,7 @@ void TidalRequest::AlbumCoverReceived(QNetworkReply *reply, const QString &album
   QImage image;
   if (image.loadFromData(data, format)) {
     if (image.save(filename, format)) {
+      CoverCacheIndex::AddFile(filename);
       while (album_covers_requests_sent_.contains(album_id)) {
         const QString song_id = album_covers_requests_sent_.take(album_id);
         if (songs_.contains(song_id)) {
@@ -1322,6 +1325,15 @@ int TidalRequest::GetProgress(const int count, const int total) {
 
 }
 
+void TidalRequest::SetProgress(const int count, const int total) {
+
+  const int progress = GetProgress(count, total);
+  if (progress_throttle_.Update(progress, 100)) {
+    Q_EMIT UpdateProgress(query_id_, progress);
+  }
+
+}
+
 void TidalRequest::Error(const QString &error_message, const QVariant &debug_output) {
 
   qLog(Error) << "Tidal:" << error_message;
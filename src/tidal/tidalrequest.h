@@ -34,6 +34,7 @@
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
+#include "streaming/progressthrottle.h"
 
 #include "tidalbaserequest.h"
 
@@ -156,6 +157,7 @@ class TidalRequest : public TidalBaseRequest {
   void AlbumCoverFinishCheck();
 
   int GetProgress(const int count, const int total);
+  void SetProgress(const int count, const int total);
 
   void FinishCheck();
   static void Warn(const QString &error_message, const QVariant &debug_output = QVariant());
@@ -174,6 +176,7 @@ class TidalRequest : public TidalBaseRequest {
   QString search_text_;
 
   bool finished_;
+  ProgressThrottle progress_throttle_;
   QString error_;
 
   QQueue<Request> artists_requests_queue_;
@@ -436,6 +436,21 @@ void TidalService::StartSearch() {
 
 void TidalService::CancelSearch() {}
 
+int TidalService::search_limit(const SearchType type) const {
+
+  switch (type) {
+    case SearchType::Artists:
+      return artistssearchlimit_;
+    case SearchType::Albums:
+      return albumssearchlimit_;
+    case SearchType::Songs:
+      return songssearchlimit_;
+  }
+
+  return 0;
+
+}
+
 void TidalService::SendSearch() {
 
   TidalBaseRequest::Type query_type = TidalBaseRequest::Type::None;
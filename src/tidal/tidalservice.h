@@ -84,6 +84,7 @@ class TidalService : public StreamingService {
   int artistssearchlimit() const { return artistssearchlimit_; }
   int albumssearchlimit() const { return albumssearchlimit_; }
   int songssearchlimit() const { return songssearchlimit_; }
+  int search_limit(const SearchType type) const override;
   bool fetchalbums() const { return fetchalbums_; }
   QString coversize() const { return coversize_; }
   bool download_album_covers() const { return download_album_covers_; }
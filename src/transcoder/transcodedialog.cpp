@@ -61,6 +61,7 @@
 #include "constants/filefilterconstants.h"
 #include "constants/transcodersettings.h"
 #include "utilities/screenutils.h"
+#include "utilities/timeutils.h"
 #include "transcodedialog.h"
 #include "transcoder.h"
 #include "transcoderoptionsdialog.h"
@@ -318,6 +319,13 @@ void TranscodeDialog::UpdateStatusText() {
     sections << u"<font color=\"#b60000\">"_s + tr("%n failed", "", finished_failed_) + u"</font>"_s;
   }
 
+  if (progress_timer_.isActive()) {
+    const Transcoder::Statistics statistics = transcoder_->GetStatistics();
+    if (statistics.eta_seconds >= 0.0) {
+      sections << tr("%1 left at %2x").arg(Utilities::PrettyTime(static_cast<int>(statistics.eta_seconds)), QString::number(statistics.throughput, 'f', 1));
+    }
+  }
+
   ui_->progress_text->setText(sections.join(", "_L1));
 
 }
@@ -410,6 +418,7 @@ void TranscodeDialog::timerEvent(QTimerEvent *e) {
 
   if (e->timerId() == progress_timer_.timerId()) {
     UpdateProgress();
+    UpdateStatusText();
   }
 
 }
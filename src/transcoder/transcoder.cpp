@@ -37,8 +37,10 @@
 #include <QFileInfo>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
 #include <QSettings>
 
 #include "includes/shared_ptr.h"
@@ -101,44 +103,56 @@ GstElement *Transcoder::CreateElementForMimeType(GstElementFactoryListType eleme
     return CreateElement(u"mp4mux"_s, bin);
   }
 
-  // Keep track of all the suitable elements we find and figure out which is the best at the end.
-  QList<SuitableElement> suitable_elements_;
-
-  // The caps we're trying to find
-  GstCaps *target_caps = gst_caps_from_string(mime_type.toUtf8().constData());
-
-  GstRegistry *registry = gst_registry_get();
-  GList *const features = gst_registry_get_feature_list(registry, GST_TYPE_ELEMENT_FACTORY);
-
-  for (GList *f = features; f; f = g_list_next(f)) {
-    GstElementFactory *factory = GST_ELEMENT_FACTORY(f->data);
-
-    // Is this the right type of plugin?
-    if (gst_element_factory_list_is_type(factory, element_type)) {
-      // check if the element factory supports the target caps
-      if (gst_element_factory_can_src_any_caps(factory, target_caps)) {
-        const QString name = QString::fromUtf8(GST_OBJECT_NAME(factory));
-        int rank = static_cast<int>(gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory)));
-        if (name.startsWith("avmux"_L1) || name.startsWith("avenc"_L1)) {
-          rank = -1;  // ffmpeg usually sucks
+  // Scanning the registry is slow, so only do it for the first job using this mime type.
+  const QString cache_key = QString::number(element_type) + QLatin1Char('/') + mime_type;
+  QString best_name;
+  if (element_for_mime_type_.contains(cache_key)) {
+    best_name = element_for_mime_type_.value(cache_key);
+  }
+  else {
+    // Keep track of all the suitable elements we find and figure out which is the best at the end.
+    QList<SuitableElement> suitable_elements_;
+
+    // The caps we're trying to find
+    GstCaps *target_caps = gst_caps_from_string(mime_type.toUtf8().constData());
+
+    GstRegistry *registry = gst_registry_get();
+    GList *const features = gst_registry_get_feature_list(registry, GST_TYPE_ELEMENT_FACTORY);
+
+    for (GList *f = features; f; f = g_list_next(f)) {
+      GstElementFactory *factory = GST_ELEMENT_FACTORY(f->data);
+
+      // Is this the right type of plugin?
+      if (gst_element_factory_list_is_type(factory, element_type)) {
+        // check if the element factory supports the target caps
+        if (gst_element_factory_can_src_any_caps(factory, target_caps)) {
+          const QString name = QString::fromUtf8(GST_OBJECT_NAME(factory));
+          int rank = static_cast<int>(gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory)));
+          if (name.startsWith("avmux"_L1) || name.startsWith("avenc"_L1)) {
+            rank = -1;  // ffmpeg usually sucks
+          }
+          suitable_elements_ << SuitableElement(name, rank);
         }
-        suitable_elements_ << SuitableElement(name, rank);
       }
     }
-  }
 
-  gst_plugin_feature_list_free(features);
-  gst_caps_unref(target_caps);
+    gst_plugin_feature_list_free(features);
+    gst_caps_unref(target_caps);
 
-  if (suitable_elements_.isEmpty()) return nullptr;
+    if (!suitable_elements_.isEmpty()) {
+      // Sort by rank
+      std::sort(suitable_elements_.begin(), suitable_elements_.end());
+      const SuitableElement &best = suitable_elements_.last();
+      best_name = best.name_;
+      Q_EMIT LogLine(QStringLiteral("Using '%1' (rank %2)").arg(best.name_).arg(best.rank_));
+    }
 
-  // Sort by rank
-  std::sort(suitable_elements_.begin(), suitable_elements_.end());
-  const SuitableElement &best = suitable_elements_.last();
+    element_for_mime_type_.insert(cache_key, best_name);
+  }
 
-  Q_EMIT LogLine(QStringLiteral("Using '%1' (rank %2)").arg(best.name_).arg(best.rank_));
+  if (best_name.isEmpty()) return nullptr;
 
-  if (best.name_ == "lamemp3enc"_L1) {
+  if (best_name == "lamemp3enc"_L1) {
     // Special case: we need to add xingmux and id3v2mux to the pipeline when using lamemp3enc because it doesn't write the VBR or ID3v2 headers itself.
 
     Q_EMIT LogLine(u"Adding xingmux and id3v2mux to the pipeline"_s);
@@ -171,7 +185,7 @@ GstElement *Transcoder::CreateElementForMimeType(GstElementFactoryListType eleme
     return mp3bin;
   }
   else {
-    return CreateElement(best.name_, bin);
+    return CreateElement(best_name, bin);
   }
 
 }
@@ -192,7 +206,10 @@ void Transcoder::JobState::PostFinished(const bool success) {
 Transcoder::Transcoder(QObject *parent, const QString &settings_postfix)
     : QObject(parent),
       max_threads_(QThread::idealThreadCount()),
-      settings_postfix_(settings_postfix) {
+      settings_postfix_(settings_postfix),
+      running_(false),
+      finished_audio_nsec_(0),
+      finished_input_bytes_(0) {
 
   if (JobFinishedEvent::sEventType == -1)
     JobFinishedEvent::sEventType = QEvent::registerEventType();
@@ -317,13 +334,29 @@ void Transcoder::AddJob(const QString &input, const TranscoderPreset &preset, co
   job.input = input;
   job.preset = preset;
   job.output = output;
+  job.input_size = QFileInfo(input).size();
   queued_jobs_ << job;
 
 }
 
 void Transcoder::Start() {
 
-  Q_EMIT LogLine(tr("Transcoding %1 files using %2 threads").arg(queued_jobs_.count()).arg(max_threads()));
+  // Jobs can be added and started while others are running, as organize does for every file, they are part of the same run.
+  if (!running_) {
+    running_ = true;
+
+    // Pick up any changes made in the transcoder settings since the last run.
+    element_for_mime_type_.clear();
+    element_properties_.clear();
+
+    finished_audio_nsec_ = 0;
+    finished_input_bytes_ = 0;
+    elapsed_timer_.start();
+
+    Q_EMIT LogLine(tr("Transcoding %1 files using %2 threads").arg(queued_jobs_.count()).arg(max_threads()));
+  }
+
+  SortQueuedJobs();
 
   Q_FOREVER {
     StartJobStatus status = MaybeStartNextJob();
@@ -332,11 +365,22 @@ void Transcoder::Start() {
 
 }
 
+void Transcoder::SortQueuedJobs() {
+
+  // Start the longest files first, so the short ones fill up the idle threads at the end instead of a single long file running alone.
+  // The file size is used as an estimate of the duration, reading the real duration would mean opening every file up front.
+  std::stable_sort(queued_jobs_.begin(), queued_jobs_.end(), [](const Job &a, const Job &b) { return a.input_size > b.input_size; });
+
+}
+
 Transcoder::StartJobStatus Transcoder::MaybeStartNextJob() {
 
   if (current_jobs_.count() >= max_threads()) return StartJobStatus::AllThreadsBusy;
   if (queued_jobs_.isEmpty()) {
     if (current_jobs_.isEmpty()) {
+      running_ = false;
+      const Statistics statistics = GetStatistics();
+      Q_EMIT LogLine(tr("Transcoded %1 seconds of audio in %2 seconds (%3x realtime)").arg(statistics.audio_seconds, 0, 'f', 1).arg(statistics.elapsed_seconds, 0, 'f', 1).arg(statistics.throughput, 0, 'f', 1));
       Q_EMIT AllJobsComplete();
     }
 
@@ -497,6 +541,10 @@ bool Transcoder::event(QEvent *e) {
     // Remove event handlers from the gstreamer pipeline, so they don't get called after the pipeline is shutting down
     gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(finished_event->state_->pipeline_)), nullptr, nullptr, nullptr);
 
+    if (finished_event->success_) {
+      JobFinished(finished_event->state_);
+    }
+
     // Remove it from the list - this will also destroy the GStreamer pipeline
     current_jobs_.erase(it);
 
@@ -517,6 +565,7 @@ void Transcoder::Cancel() {
 
   // Remove all pending jobs
   queued_jobs_.clear();
+  running_ = false;
 
   // Stop the running ones
   JobStateList::iterator it = current_jobs_.begin();
@@ -538,6 +587,81 @@ void Transcoder::Cancel() {
 
 }
 
+void Transcoder::JobFinished(const JobState *state) {
+
+  qint64 position = 0;
+  qint64 duration = 0;
+  if (QueryPosition(state->pipeline_, &position, &duration)) {
+    finished_audio_nsec_ += duration;
+    finished_input_bytes_ += state->job_.input_size;
+  }
+
+}
+
+bool Transcoder::QueryPosition(GstElement *pipeline, qint64 *position, qint64 *duration) {
+
+  if (!pipeline) return false;
+
+  gint64 g_position = 0;
+  gint64 g_duration = 0;
+  if (!gst_element_query_duration(pipeline, GST_FORMAT_TIME, &g_duration) || g_duration <= 0) return false;
+  gst_element_query_position(pipeline, GST_FORMAT_TIME, &g_position);
+
+  *position = qBound(static_cast<qint64>(0), static_cast<qint64>(g_position), static_cast<qint64>(g_duration));
+  *duration = static_cast<qint64>(g_duration);
+
+  return true;
+
+}
+
+Transcoder::Statistics Transcoder::GetStatistics() const {
+
+  Statistics statistics;
+  if (!elapsed_timer_.isValid()) return statistics;
+
+  qint64 audio_nsec = finished_audio_nsec_;
+  qint64 remaining_nsec = 0;
+
+  // Bytes and audio duration of the jobs with a known duration, used to estimate the duration of the queued jobs.
+  qint64 known_nsec = finished_audio_nsec_;
+  qint64 known_bytes = finished_input_bytes_;
+
+  for (const SharedPtr<JobState> &state : current_jobs_) {
+    qint64 position = 0;
+    qint64 duration = 0;
+    if (!QueryPosition(state->pipeline_, &position, &duration)) continue;
+    audio_nsec += position;
+    remaining_nsec += duration - position;
+    known_nsec += duration;
+    known_bytes += state->job_.input_size;
+  }
+
+  bool remaining_known = true;
+  if (!queued_jobs_.isEmpty()) {
+    if (known_bytes > 0) {
+      const double nsec_per_byte = static_cast<double>(known_nsec) / static_cast<double>(known_bytes);
+      for (const Job &job : queued_jobs_) {
+        remaining_nsec += static_cast<qint64>(static_cast<double>(job.input_size) * nsec_per_byte);
+      }
+    }
+    else {
+      remaining_known = false;
+    }
+  }
+
+  statistics.audio_seconds = static_cast<double>(audio_nsec) / 1e9;
+  statistics.elapsed_seconds = static_cast<double>(elapsed_timer_.nsecsElapsed()) / 1e9;
+  if (statistics.elapsed_seconds > 0.0) {
+    statistics.throughput = statistics.audio_seconds / statistics.elapsed_seconds;
+  }
+  if (remaining_known && statistics.throughput > 0.0) {
+    statistics.eta_seconds = static_cast<double>(remaining_nsec) / 1e9 / statistics.throughput;
+  }
+
+  return statistics;
+
+}
+
 QMap<QString, float> Transcoder::GetProgress() const {
 
   QMap<QString, float> ret;
@@ -560,8 +684,18 @@ QMap<QString, float> Transcoder::GetProgress() const {
 
 void Transcoder::SetElementProperties(const QString &name, GObject *object) {
 
-  Settings s;
-  s.beginGroup("Transcoder/"_L1 + name + settings_postfix_);
+  if (!element_properties_.contains(name)) {
+    QVariantMap values;
+    Settings s;
+    s.beginGroup("Transcoder/"_L1 + name + settings_postfix_);
+    const QStringList keys = s.childKeys();
+    for (const QString &key : keys) {
+      values.insert(key, s.value(key));
+    }
+    s.endGroup();
+    element_properties_.insert(name, values);
+  }
+  const QVariantMap &values = element_properties_[name];
 
   guint properties_count = 0;
   GParamSpec **properties = g_object_class_list_properties(G_OBJECT_GET_CLASS(object), &properties_count);
@@ -569,11 +703,7 @@ void Transcoder::SetElementProperties(const QString &name, GObject *object) {
   for (uint i = 0; i < properties_count; ++i) {
     GParamSpec *property = properties[i];
 
-    if (!s.contains(QString::fromUtf8(property->name))) {
-      continue;
-    }
-
-    const QVariant value = s.value(QString::fromUtf8(property->name));
+    const QVariant value = values.value(QString::fromUtf8(property->name));
     if (value.isNull()) {
       continue;
     }
@@ -637,6 +767,4 @@ void Transcoder::SetElementProperties(const QString &name, GObject *object) {
 
   g_free(properties);
 
-  s.endGroup();
-
 }
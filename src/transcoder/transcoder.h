@@ -33,8 +33,11 @@
 #include <QMap>
 #include <QMetaType>
 #include <QSet>
+#include <QHash>
 #include <QString>
+#include <QVariant>
 #include <QEvent>
+#include <QElapsedTimer>
 
 #include "includes/shared_ptr.h"
 #include "core/song.h"
@@ -57,6 +60,15 @@ class Transcoder : public QObject {
  public:
   explicit Transcoder(QObject *parent = nullptr, const QString &settings_postfix = QLatin1String(""));
 
+  // Aggregate numbers for the jobs started since the last call to Start().
+  struct Statistics {
+    Statistics() : audio_seconds(0.0), elapsed_seconds(0.0), throughput(0.0), eta_seconds(-1.0) {}
+    double audio_seconds;    // Seconds of audio transcoded, including the running jobs.
+    double elapsed_seconds;  // Wall-clock seconds since the transcoder was started.
+    double throughput;       // Audio seconds per wall-clock second.
+    double eta_seconds;      // Estimated seconds until all jobs are done, -1 if unknown.
+  };
+
   static TranscoderPreset PresetForFileType(const Song::FileType filetype);
   static QList<TranscoderPreset> GetAllPresets();
   static Song::FileType PickBestFormat(const QList<Song::FileType> &supported);
@@ -68,6 +80,7 @@ class Transcoder : public QObject {
   void AddJob(const QString &input, const TranscoderPreset &preset, const QString &output);
 
   QMap<QString, float> GetProgress() const;
+  Statistics GetStatistics() const;
   qint64 QueuedJobsCount() const { return queued_jobs_.count(); }
 
  public Q_SLOTS:
@@ -85,9 +98,11 @@ class Transcoder : public QObject {
  private:
   // The description of a file to transcode - lives in the main thread.
   struct Job {
+    Job() : input_size(0) {}
     QString input;
     QString output;
     TranscoderPreset preset;
+    qint64 input_size;
   };
 
   // State held by a job and shared across gstreamer callbacks - lives in the job's thread.
@@ -131,6 +146,9 @@ class Transcoder : public QObject {
 
   StartJobStatus MaybeStartNextJob();
   bool StartJob(const Job &job);
+  void SortQueuedJobs();
+  void JobFinished(const JobState *state);
+  static bool QueryPosition(GstElement *pipeline, qint64 *position, qint64 *duration);
 
   GstElement *CreateElement(const QString &factory_name, GstElement *bin = nullptr, const QString &name = QString());
   GstElement *CreateElementForMimeType(GstElementFactoryListType element_type, const QString &mime_type, GstElement *bin = nullptr);
@@ -146,6 +164,15 @@ class Transcoder : public QObject {
   QList<Job> queued_jobs_;
   JobStateList current_jobs_;
   QString settings_postfix_;
+  bool running_;
+
+  // Encoder setup is looked up once per run and reused for every job.
+  QHash<QString, QString> element_for_mime_type_;
+  QHash<QString, QVariantMap> element_properties_;
+
+  QElapsedTimer elapsed_timer_;
+  qint64 finished_audio_nsec_;
+  qint64 finished_input_bytes_;
 };
 
 #endif  // TRANSCODER_H
@@ -22,6 +22,13 @@
 
 #include <memory>
 
+#ifdef Q_OS_LINUX
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/ioctl.h>
+#  include <linux/fs.h>
+#endif
+
 #include <QByteArray>
 #include <QString>
 #include <QIODevice>
@@ -37,6 +44,62 @@ namespace Utilities {
 
 using std::unique_ptr;
 
+namespace {
+
+constexpr qint64 kCopyBufferSize = 1048576;
+constexpr qint64 kCopyRangeChunkSize = 8388608;
+
+void ReportCopyProgress(const CopyProgressFunction &progress, const qint64 bytes_copied, const qint64 bytes_total) {
+
+  if (progress && bytes_total > 0) {
+    progress(static_cast<float>(bytes_copied) / static_cast<float>(bytes_total));
+  }
+
+}
+
+#ifdef Q_OS_LINUX
+bool CopyFileRange(const int source_fd, const int destination_fd, const qint64 size, const CopyProgressFunction &progress) {
+
+#ifdef FICLONE
+  // Shares the extents on filesystems with reflink support, like Btrfs and XFS.
+  if (::ioctl(destination_fd, FICLONE, source_fd) == 0) {
+    ReportCopyProgress(progress, size, size);
+    return true;
+  }
+#endif
+
+  qint64 bytes_copied = 0;
+  while (bytes_copied < size) {
+    const ssize_t bytes = ::copy_file_range(source_fd, nullptr, destination_fd, nullptr, static_cast<size_t>(qMin(kCopyRangeChunkSize, size - bytes_copied)), 0);
+    if (bytes <= 0) return false;
+    bytes_copied += bytes;
+    ReportCopyProgress(progress, bytes_copied, size);
+  }
+
+  return true;
+
+}
+#endif
+
+bool CopyFileStream(QFile *source, QFile *destination, const qint64 size, const CopyProgressFunction &progress) {
+
+  unique_ptr<char[]> buffer(new char[static_cast<size_t>(kCopyBufferSize)]);
+  qint64 bytes_copied = 0;
+  while (!source->atEnd()) {
+    const qint64 bytes_read = source->read(buffer.get(), kCopyBufferSize);
+    if (bytes_read < 0) return false;
+    if (bytes_read == 0) break;
+    if (destination->write(buffer.get(), bytes_read) != bytes_read) return false;
+    bytes_copied += bytes_read;
+    ReportCopyProgress(progress, bytes_copied, size);
+  }
+
+  return destination->flush();
+
+}
+
+}  // namespace
+
 QByteArray ReadDataFromFile(const QString &filename) {
 
   QFile file(filename);
@@ -83,6 +146,65 @@ bool Copy(QIODevice *source, QIODevice *destination) {
 
 }
 
+bool CopyLocalFile(const QString &source_filename, const QString &destination_filename, const CopyProgressFunction &progress) {
+
+  QFile source(source_filename);
+  if (!source.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+    qLog(Error) << "Failed to open file" << source_filename << "for reading:" << source.errorString();
+    return false;
+  }
+
+  QFile destination(destination_filename);
+  if (!destination.open(QIODevice::WriteOnly | QIODevice::NewOnly | QIODevice::Unbuffered)) {
+    qLog(Error) << "Failed to open file" << destination_filename << "for writing:" << destination.errorString();
+    return false;
+  }
+
+  const qint64 size = source.size();
+  bool success = false;
+
+#ifdef Q_OS_LINUX
+  success = CopyFileRange(source.handle(), destination.handle(), size, progress);
+  if (!success) {
+    // Not supported between these filesystems, start over with a regular copy.
+    success = source.seek(0) && destination.seek(0) && destination.resize(0);
+    if (success) {
+      success = CopyFileStream(&source, &destination, size, progress);
+    }
+  }
+#else
+  success = CopyFileStream(&source, &destination, size, progress);
+#endif
+
+  if (!success) {
+    qLog(Error) << "Failed to copy" << source_filename << "to" << destination_filename << destination.errorString();
+    destination.close();
+    destination.remove();
+    return false;
+  }
+
+  destination.close();
+  destination.setPermissions(source.permissions());
+
+  return true;
+
+}
+
+bool SyncFilesystem(const QString &path) {
+
+#ifdef Q_OS_LINUX
+  const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd == -1) return false;
+  const bool success = ::syncfs(fd) == 0;
+  ::close(fd);
+  return success;
+#else
+  Q_UNUSED(path)
+  return true;
+#endif
+
+}
+
 bool CopyRecursive(const QString &source, const QString &destination) {
 
   // Make the destination directory
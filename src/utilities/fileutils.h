@@ -21,14 +21,25 @@
 #ifndef FILEUTILS_H
 #define FILEUTILS_H
 
+#include <functional>
+
 #include <QString>
 
 class QIODevice;
 
 namespace Utilities {
 
+using CopyProgressFunction = std::function<void(const float progress)>;
+
 QByteArray ReadDataFromFile(const QString &filename);
 bool Copy(QIODevice *source, QIODevice *destination);
+
+// Copies a file without overwriting the destination.
+// Uses reflink or copy_file_range where available, and falls back to streaming the file through a large buffer.
+bool CopyLocalFile(const QString &source_filename, const QString &destination_filename, const CopyProgressFunction &progress = CopyProgressFunction());
+
+// Flushes all pending writes on the filesystem containing path, used to sync once after copying many files.
+bool SyncFilesystem(const QString &path);
 bool CopyRecursive(const QString &source, const QString &destination);
 bool RemoveRecursive(const QString &path);
 
@@ -0,0 +1,221 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <optional>
+#include <memory>
+
+#include "gtest_include.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QEventLoop>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+
+#include "includes/shared_ptr.h"
+#include "core/song.h"
+#include "core/database.h"
+#include "tagreader/tagreaderclient.h"
+#include "engine/audiocontentkey.h"
+#include "engine/ebur128measures.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionlibrary.h"
+#include "collection/collectionwatcher.h"
+
+#include "test_utils.h"
+
+using namespace Qt::Literals::StringLiterals;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+class AudioContentKeyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+
+    ASSERT_TRUE(temp_dir_.isValid());
+
+    tagreader_client_ = new TagReaderClient();
+    tagreader_client_thread_ = new QThread();
+    tagreader_client_->moveToThread(tagreader_client_thread_);
+    tagreader_client_thread_->start();
+
+  }
+
+  void TearDown() override {
+
+    tagreader_client_thread_->exit();
+    tagreader_client_thread_->wait(5000);
+    tagreader_client_->deleteLater();
+    tagreader_client_thread_->deleteLater();
+
+  }
+
+  QString WriteFile(const QString &name, const QByteArray &data) const {
+
+    const QString filename = temp_dir_.filePath(name);
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) return QString();
+    file.write(data);
+    file.close();
+
+    return filename;
+
+  }
+
+  // Writes a FLAC file with the given number of seconds of a sine wave.
+  QString CreateFlacFile(const int index, const int seconds, const int frequency) const {
+
+    const QString filename = temp_dir_.filePath(u"input-%1.flac"_s.arg(index));
+    return CreateAudioFile(filename, u"flacenc"_s, seconds, frequency) ? filename : QString();
+
+  }
+
+  // Changes only the tags of the file.
+  void WriteTitle(const QString &filename, const QString &title) const {
+
+    Song song;
+    {
+      TagReaderReadFileReplyPtr reply = tagreader_client_->ReadFileAsync(filename);
+      QEventLoop loop;
+      QObject::connect(&*reply, &TagReaderReadFileReply::Finished, &loop, &QEventLoop::quit);
+      loop.exec();
+      song = reply->song();
+    }
+
+    song.set_title(title);
+    song.set_comment(title.repeated(64));
+
+    TagReaderReplyPtr reply = tagreader_client_->WriteFileAsync(filename, song, SaveTagsOption::Tags, SaveTagCoverData());
+    QEventLoop loop;
+    QObject::connect(&*reply, &TagReaderReply::Finished, &loop, &QEventLoop::quit);
+    loop.exec();
+
+  }
+
+  QTemporaryDir temp_dir_;
+  TagReaderClient *tagreader_client_;
+  QThread *tagreader_client_thread_;
+};
+
+TEST_F(AudioContentKeyTest, SkipsID3AndAPETags) {
+
+  const QByteArray audio = QByteArray(4096, '\x5A');
+
+  QByteArray id3v2_tag("ID3\x04\x00\x00\x00\x00\x01\x00", 10);  // 128 bytes after the header.
+  id3v2_tag.append(QByteArray(128, '\0'));
+
+  QByteArray id3v1_tag("TAG");
+  id3v1_tag.append(QByteArray(125, 'x'));
+
+  QByteArray ape_footer("APETAGEX", 8);
+  ape_footer.append(QByteArray("\xD0\x07\x00\x00", 4));  // Version
+  ape_footer.append(QByteArray("\x30\x00\x00\x00", 4));  // Size of the items and the footer
+  ape_footer.append(QByteArray("\x01\x00\x00\x00", 4));  // Item count
+  ape_footer.append(QByteArray(12, '\0'));  // Flags and reserved bytes
+  const QByteArray ape_tag = QByteArray(16, 'y') + ape_footer;
+
+  const QString plain_key = AudioContentKey::FromFile(WriteFile(u"plain.mp3"_s, audio));
+  ASSERT_FALSE(plain_key.isEmpty());
+
+  EXPECT_EQ(plain_key, AudioContentKey::FromFile(WriteFile(u"id3v2.mp3"_s, id3v2_tag + audio)));
+  EXPECT_EQ(plain_key, AudioContentKey::FromFile(WriteFile(u"id3v1.mp3"_s, audio + id3v1_tag)));
+  EXPECT_EQ(plain_key, AudioContentKey::FromFile(WriteFile(u"ape.mp3"_s, audio + ape_tag)));
+  EXPECT_EQ(plain_key, AudioContentKey::FromFile(WriteFile(u"all.mp3"_s, id3v2_tag + audio + ape_tag + id3v1_tag)));
+
+  QByteArray changed_audio = audio;
+  changed_audio[2048] = '\x5B';
+  EXPECT_NE(plain_key, AudioContentKey::FromFile(WriteFile(u"changed.mp3"_s, id3v2_tag + changed_audio)));
+
+  EXPECT_TRUE(AudioContentKey::FromFile(temp_dir_.filePath(u"missing.mp3"_s)).isEmpty());
+
+}
+
+TEST_F(AudioContentKeyTest, TagEditKeepsFlacKey) {
+
+  if (!HasGstElements(QStringList() << u"audiotestsrc"_s << u"flacenc"_s)) GTEST_SKIP() << "Missing GStreamer elements";
+
+  const QString filename = CreateFlacFile(0, 2, 440);
+  ASSERT_FALSE(filename.isEmpty());
+  const QString other_filename = CreateFlacFile(1, 2, 880);
+  ASSERT_FALSE(other_filename.isEmpty());
+
+  const QString key = AudioContentKey::FromFile(filename);
+  ASSERT_FALSE(key.isEmpty());
+  EXPECT_NE(key, AudioContentKey::FromFile(other_filename));
+
+  WriteTitle(filename, u"A title long enough to need more room than the padding has"_s);
+  EXPECT_EQ(key, AudioContentKey::FromFile(filename));
+
+}
+
+TEST_F(AudioContentKeyTest, CachedAnalysisSkipsDecoding) {
+
+  if (!HasGstElements(QStringList() << u"decodebin"_s)) GTEST_SKIP() << "Missing GStreamer elements";
+
+  SharedPtr<Database> database = make_shared<Database>(nullptr, nullptr, temp_dir_.filePath(u"strawberry.db"_s));
+  CollectionBackend backend;
+  backend.Init(database, nullptr, Song::Source::Collection, QLatin1String(CollectionLibrary::kSongsTable), QLatin1String(CollectionLibrary::kDirsTable), QLatin1String(CollectionLibrary::kSubdirsTable));
+
+  // Neither file can be decoded, so analyzing them gives no fingerprint and no loudness.
+  const QString cached_filename = WriteFile(u"cached.flac"_s, QByteArray(4096, '\x5A'));
+  const QString uncached_filename = WriteFile(u"uncached.flac"_s, QByteArray(4096, '\x5B'));
+  ASSERT_FALSE(cached_filename.isEmpty());
+  ASSERT_FALSE(uncached_filename.isEmpty());
+
+  // The loudness range is not cached, only the integrated loudness is needed for a hit.
+  EBUR128Measures cached_measures;
+  cached_measures.loudness_lufs = -14.0;
+  backend.AddAudioAnalysis(AudioContentKey::FromFile(cached_filename), u"cached-fingerprint"_s, cached_measures);
+
+  QString cached_fingerprint;
+  std::optional<EBUR128Measures> cached_result;
+  QString uncached_fingerprint;
+  std::optional<EBUR128Measures> uncached_result;
+  QtConcurrent::run([&]() {
+    QByteArray moodbar_data;
+    cached_fingerprint = CollectionWatcher::AnalyzeAudio(&backend, cached_filename, true, true, false, &cached_result, &moodbar_data);
+    uncached_fingerprint = CollectionWatcher::AnalyzeAudio(&backend, uncached_filename, true, true, false, &uncached_result, &moodbar_data);
+    database->Close();
+  }).waitForFinished();
+
+  EXPECT_EQ(u"cached-fingerprint"_s, cached_fingerprint);
+  ASSERT_TRUE(cached_result.has_value());
+  EXPECT_EQ(-14.0, cached_result->loudness_lufs.value_or(0.0));
+  EXPECT_FALSE(cached_result->range_lu.has_value());
+
+  EXPECT_EQ(u"NONE"_s, uncached_fingerprint);
+
+  // Tag edits don't change the key, so the failed analysis isn't repeated either.
+  QString fingerprint;
+  EXPECT_TRUE(backend.GetAudioAnalysis(AudioContentKey::FromFile(uncached_filename), &fingerprint, nullptr));
+  EXPECT_EQ(u"NONE"_s, fingerprint);
+
+  backend.Close();
+
+}
+
+}  // namespace
@@ -20,18 +20,30 @@
  */
 
 #include <memory>
+#include <utility>
 
 #include "gtest_include.h"
 
+#include <QHash>
+#include <QUrl>
 #include <QFileInfo>
 #include <QSignalSpy>
 #include <QThread>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QTemporaryDir>
+#include <QFuture>
+#include <QtConcurrentRun>
+#include <QSqlDatabase>
 #include <QtDebug>
 
 #include "includes/scoped_ptr.h"
 #include "includes/shared_ptr.h"
 #include "core/song.h"
 #include "core/memorydatabase.h"
+#include "core/database.h"
+#include "core/scopedtransaction.h"
+#include "core/sqlquery.h"
 #include "constants/timeconstants.h"
 #include "collection/collectionbackend.h"
 #include "collection/collectionlibrary.h"
@@ -231,6 +243,25 @@ TEST_F(SingleSong, GetSongs) {
 
 }
 
+TEST_F(SingleSong, SearchSongs) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  const QStringList columns = QStringList() << u"artist"_s << u"title"_s;
+
+  SongList songs = backend_->SearchSongs(QStringList() << u"artist"_s << u"itl"_s, columns, 10);
+  ASSERT_EQ(1, songs.size());
+  EXPECT_EQ(1, songs[0].id());
+
+  EXPECT_TRUE(backend_->SearchSongs(QStringList() << u"itl"_s, QStringList() << u"artist"_s << u"album"_s, 10).isEmpty());
+  EXPECT_TRUE(backend_->SearchSongs(QStringList() << u"artist"_s << u"other"_s, columns, 10).isEmpty());
+  EXPECT_TRUE(backend_->SearchSongs(QStringList() << u"%"_s, columns, 10).isEmpty());
+  EXPECT_TRUE(backend_->SearchSongs(QStringList(), columns, 10).isEmpty());
+  EXPECT_TRUE(backend_->SearchSongs(QStringList() << u"artist"_s, QStringList(), 10).isEmpty());
+
+}
+
 TEST_F(SingleSong, GetSongById) {
 
   AddDummySong();
@@ -350,6 +381,101 @@ TEST_F(SingleSong, MarkSongsUnavailable) {
 
 }
 
+TEST_F(SingleSong, StatisticsAreQueuedAndMerged) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  // Imported statistics are written right away, the increments are queued on top of them.
+  ImportedPlayStatistics imported_statistics;
+  imported_statistics.artist = u"Artist"_s;
+  imported_statistics.title = u"Title"_s;
+  imported_statistics.playcount = 10;
+  backend_->ImportPlayStatistics(ImportedPlayStatisticsList() << imported_statistics);
+  ASSERT_EQ(10, backend_->GetSongById(1).playcount());
+
+  QSignalSpy statistics_spy(&*backend_, &CollectionBackend::SongsStatisticsChanged);
+  QSignalSpy rating_spy(&*backend_, &CollectionBackend::SongsRatingChanged);
+
+  backend_->IncrementPlayCount(1);
+  backend_->IncrementPlayCount(1);
+  backend_->IncrementSkipCount(1, 0.5F);
+  backend_->UpdateSongRating(1, 0.2F);
+  backend_->UpdateSongRating(1, 0.8F, true);
+
+  // Nothing is written until the queue is flushed.
+  EXPECT_EQ(0, statistics_spy.count());
+  EXPECT_EQ(0, rating_spy.count());
+  EXPECT_EQ(10, backend_->GetSongById(1).playcount());
+
+  backend_->FlushStatistics();
+
+  ASSERT_EQ(1, statistics_spy.count());
+  ASSERT_EQ(1, rating_spy.count());
+  EXPECT_TRUE(rating_spy[0][1].toBool());
+
+  const SongList songs = *(reinterpret_cast<SongList*>(statistics_spy[0][0].data()));
+  ASSERT_EQ(1, songs.count());
+  EXPECT_EQ(12, songs[0].playcount());
+
+  const Song song = backend_->GetSongById(1);
+  EXPECT_EQ(12, song.playcount());
+  EXPECT_EQ(1, song.skipcount());
+  EXPECT_GT(song.lastplayed(), 0);
+  EXPECT_FLOAT_EQ(0.8F, song.rating());
+
+  // Flushing again does nothing.
+  backend_->FlushStatistics();
+  EXPECT_EQ(1, statistics_spy.count());
+  EXPECT_EQ(1, rating_spy.count());
+
+}
+
+TEST_F(SingleSong, ImportPlayStatistics) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  QSignalSpy statistics_spy(&*backend_, &CollectionBackend::SongsStatisticsChanged);
+
+  ImportedPlayStatisticsList statistics;
+  ImportedPlayStatistics playcount;
+  playcount.artist = u"artist"_s;
+  playcount.title = u"TITLE"_s;
+  playcount.playcount = 7;
+  statistics << playcount;
+  ImportedPlayStatistics lastplayed;
+  lastplayed.artist = u"Artist"_s;
+  lastplayed.album = u"Album"_s;
+  lastplayed.title = u"Title"_s;
+  lastplayed.lastplayed = 1000;
+  statistics << lastplayed;
+  ImportedPlayStatistics other_album;
+  other_album.artist = u"Artist"_s;
+  other_album.album = u"Other album"_s;
+  other_album.title = u"Title"_s;
+  other_album.lastplayed = 2000;
+  statistics << other_album;
+  ImportedPlayStatistics other_song;
+  other_song.artist = u"Artist"_s;
+  other_song.title = u"Other title"_s;
+  other_song.playcount = 3;
+  statistics << other_song;
+
+  backend_->ImportPlayStatistics(statistics);
+
+  ASSERT_EQ(1, statistics_spy.count());
+  const SongList songs = *(reinterpret_cast<SongList*>(statistics_spy[0][0].data()));
+  ASSERT_EQ(1, songs.count());
+  EXPECT_EQ(7, songs[0].playcount());
+  EXPECT_EQ(1000, songs[0].lastplayed());
+
+  // Importing again only reports songs that changed.
+  backend_->ImportPlayStatistics(ImportedPlayStatisticsList() << lastplayed);
+  EXPECT_EQ(1, statistics_spy.count());
+
+}
+
 class TestUrls : public CollectionBackendTest {
  protected:
   void SetUp() override {
@@ -429,6 +555,14 @@ TEST_F(TestUrls, TestUrls) {
 
   }
 
+
+  // All songs are found with one query, unknown URLs are ignored.
+  const SongList songs_by_urls = backend_->GetSongsByUrls(QList<QUrl>() << urls << QUrl::fromLocalFile(u"/mnt/music/missing.flac"_s));
+  ASSERT_EQ(urls.count(), songs_by_urls.count());
+  for (const Song &song : songs_by_urls) {
+    EXPECT_TRUE(urls.contains(song.url()));
+  }
+
 }
 
 class UpdateSongsBySongID : public CollectionBackendTest {
@@ -609,4 +743,270 @@ TEST_F(UpdateSongsBySongID, UpdateSongsBySongID) {
 
 }
 
+class CompilationsTest : public CollectionBackendTest {
+ protected:
+  void SetUp() override {
+    CollectionBackendTest::SetUp();
+    backend_->AddDirectory(u"/mnt/music"_s);
+  }
+
+  static Song MakeSong(const QString &path, const QString &artist, const QString &album) {
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_title(QFileInfo(path).baseName());
+    song.set_artist(artist);
+    song.set_album(album);
+    song.set_url(QUrl::fromLocalFile(path));
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    return song;
+  }
+};
+
+TEST_F(CompilationsTest, OnlyTouchedAlbumsAreUpdated) {
+
+  backend_->AddOrUpdateSongs(SongList() << MakeSong(u"/mnt/music/various/1.flac"_s, u"Artist 1"_s, u"Various"_s)
+                                        << MakeSong(u"/mnt/music/various/2.flac"_s, u"Artist 2"_s, u"Various"_s)
+                                        << MakeSong(u"/mnt/music/album/1.flac"_s, u"Artist 3"_s, u"Album"_s));
+
+  backend_->CompilationsNeedUpdating();
+
+  SongList songs = backend_->GetAllSongs();
+  ASSERT_EQ(3, songs.count());
+  for (const Song &song : std::as_const(songs)) {
+    EXPECT_EQ(song.album() == u"Various"_s, song.compilation_detected());
+  }
+
+  // Adding a song by another artist to the second album turns it into a compilation.
+  backend_->AddOrUpdateSongs(SongList() << MakeSong(u"/mnt/music/album/2.flac"_s, u"Artist 4"_s, u"Album"_s));
+  backend_->CompilationsNeedUpdating();
+
+  songs = backend_->GetAllSongs();
+  ASSERT_EQ(4, songs.count());
+  for (const Song &song : std::as_const(songs)) {
+    EXPECT_TRUE(song.compilation_detected());
+  }
+
+  // Removing it again reverts the album, the other one is left alone.
+  for (const Song &song : std::as_const(songs)) {
+    if (song.artist() == u"Artist 4"_s) {
+      backend_->DeleteSongs(SongList() << song);
+    }
+  }
+  backend_->CompilationsNeedUpdating();
+
+  songs = backend_->GetAllSongs();
+  ASSERT_EQ(3, songs.count());
+  for (const Song &song : std::as_const(songs)) {
+    EXPECT_EQ(song.album() == u"Various"_s, song.compilation_detected());
+  }
+
+}
+
+TEST_F(CompilationsTest, InterruptedScanIsUpdatedAfterRestart) {
+
+  backend_->AddOrUpdateSongs(SongList() << MakeSong(u"/mnt/music/various/1.flac"_s, u"Artist 1"_s, u"Various"_s)
+                                        << MakeSong(u"/mnt/music/various/2.flac"_s, u"Artist 2"_s, u"Various"_s));
+
+  // The scan stops before the compilations are updated, the next start uses a new backend.
+  backend_ = make_unique<CollectionBackend>();
+  backend_->Init(database_, nullptr, Song::Source::Collection, QLatin1String(CollectionLibrary::kSongsTable), QLatin1String(CollectionLibrary::kDirsTable), QLatin1String(CollectionLibrary::kSubdirsTable));
+  backend_->CompilationsNeedUpdating();
+
+  const SongList songs = backend_->GetAllSongs();
+  ASSERT_EQ(2, songs.count());
+  for (const Song &song : songs) {
+    EXPECT_TRUE(song.compilation_detected());
+  }
+
+}
+
+class GetAllSongsTest : public CollectionBackendTest {
+ protected:
+  void SetUp() override {
+    CollectionBackendTest::SetUp();
+    backend_->AddDirectory(u"/mnt/music"_s);
+  }
+};
+
+TEST_F(GetAllSongsTest, DecodesEveryRow) {
+
+  constexpr int song_count = 200;
+
+  SongList songs;
+  songs.reserve(song_count);
+  for (int i = 0; i < song_count; ++i) {
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_title(u"Title %1"_s.arg(i));
+    song.set_album(u"Album %1"_s.arg(i / 12));
+    song.set_artist(u"Artist %1"_s.arg(i / 120));
+    song.set_track(i % 12 + 1);
+    song.set_year(1970 + (i % 50));
+    song.set_url(QUrl::fromLocalFile(u"/mnt/music/%1.flac"_s.arg(i)));
+    song.set_length_nanosec(180 * kNsecPerSec);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    songs << song;
+  }
+  backend_->AddOrUpdateSongs(songs);
+
+  const SongList result = backend_->GetAllSongs();
+  ASSERT_EQ(song_count, result.count());
+
+  QHash<QUrl, Song> songs_by_url;
+  for (const Song &song : result) {
+    songs_by_url.insert(song.url(), song);
+  }
+
+  // Every column must come back in the field it was written from.
+  for (const Song &song : std::as_const(songs)) {
+    ASSERT_TRUE(songs_by_url.contains(song.url()));
+    const Song &loaded_song = songs_by_url[song.url()];
+    EXPECT_TRUE(loaded_song.is_valid());
+    EXPECT_EQ(1, loaded_song.directory_id());
+    EXPECT_EQ(song.title(), loaded_song.title());
+    EXPECT_EQ(song.album(), loaded_song.album());
+    EXPECT_EQ(song.artist(), loaded_song.artist());
+    EXPECT_EQ(song.track(), loaded_song.track());
+    EXPECT_EQ(song.year(), loaded_song.year());
+    EXPECT_EQ(song.length_nanosec(), loaded_song.length_nanosec());
+    EXPECT_EQ(song.filesize(), loaded_song.filesize());
+  }
+
+}
+
+class FileDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+
+    ASSERT_TRUE(temp_dir_.isValid());
+
+    // WAL and the read-only connections need a database file.
+    database_ = make_shared<Database>(nullptr, nullptr, temp_dir_.filePath(u"strawberry.db"_s));
+    backend_ = make_unique<CollectionBackend>();
+    backend_->Init(database_, nullptr, Song::Source::Collection, QLatin1String(CollectionLibrary::kSongsTable), QLatin1String(CollectionLibrary::kDirsTable), QLatin1String(CollectionLibrary::kSubdirsTable));
+    backend_->AddDirectory(u"/mnt/music"_s);
+
+  }
+
+  void TearDown() override {
+
+    backend_->Close();
+    backend_.reset();
+    database_.reset();
+
+  }
+
+  static SongList MakeSongs(const int first, const int count) {
+
+    SongList songs;
+    songs.reserve(count);
+    for (int i = first; i < first + count; ++i) {
+      Song song(Song::Source::Collection);
+      song.set_directory_id(1);
+      song.set_title(u"Title %1"_s.arg(i));
+      song.set_album(u"Album %1"_s.arg(i / 12));
+      song.set_artist(u"Artist %1"_s.arg(i / 120));
+      song.set_track(i % 12 + 1);
+      song.set_url(QUrl::fromLocalFile(u"/mnt/music/%1.flac"_s.arg(i)));
+      song.set_length_nanosec(180 * kNsecPerSec);
+      song.set_mtime(1);
+      song.set_ctime(1);
+      song.set_filesize(1);
+      songs << song;
+    }
+
+    return songs;
+
+  }
+
+  QTemporaryDir temp_dir_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  ScopedPtr<CollectionBackend> backend_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(FileDatabaseTest, ReadersDontWaitForWriter) {
+
+  backend_->AddOrUpdateSongs(MakeSongs(0, 100));
+
+  // Hold the database lock and an uncommitted write, like a scan does.
+  QMutexLocker l(database_->Mutex());
+  QSqlDatabase db(database_->Connect());
+  ScopedTransaction transaction(&db);
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("UPDATE %1 SET title = 'Uncommitted'").arg(QLatin1String(CollectionLibrary::kSongsTable)));
+  ASSERT_TRUE(q.Exec());
+
+  QFuture<SongList> future = QtConcurrent::run([this]() {
+    const SongList songs = backend_->GetAllSongs();
+    database_->Close();
+    return songs;
+  });
+
+  QElapsedTimer timer;
+  timer.start();
+  while (!future.isFinished() && timer.elapsed() < 10000) {
+    QThread::msleep(10);
+  }
+  const bool finished_while_writing = future.isFinished();
+
+  l.unlock();
+  future.waitForFinished();
+
+  EXPECT_TRUE(finished_while_writing);
+
+  const SongList songs = future.result();
+  ASSERT_EQ(100, songs.count());
+  for (const Song &song : songs) {
+    EXPECT_NE(u"Uncommitted"_s, song.title());
+  }
+
+}
+
+TEST_F(FileDatabaseTest, SameSongIdInOneBatch) {
+
+  // The second song must find the first one inside the uncommitted transaction and update it.
+  SongList songs = MakeSongs(0, 2);
+  songs[0].set_song_id(u"song-1"_s);
+  songs[1].set_song_id(u"song-1"_s);
+  backend_->AddOrUpdateSongs(songs);
+
+  const SongList all_songs = backend_->GetAllSongs();
+  ASSERT_EQ(1, all_songs.count());
+  EXPECT_EQ(u"song-1"_s, all_songs.first().song_id());
+  EXPECT_EQ(u"Title 1"_s, all_songs.first().title());
+
+}
+
+TEST_F(FileDatabaseTest, BrowseDuringScan) {
+
+  constexpr int song_count = 2000;
+  constexpr int kBatchSize = 100;
+
+  backend_->AddOrUpdateSongs(MakeSongs(0, song_count));
+
+  // Add a second copy of the collection in batches from another thread, like the collection watcher does.
+  QFuture<void> scan = QtConcurrent::run([this]() {
+    for (int i = song_count; i < song_count * 2; i += kBatchSize) {
+      backend_->AddOrUpdateSongs(MakeSongs(i, kBatchSize));
+    }
+    database_->Close();
+  });
+
+  // Browsing albums while the scan runs must see each of them complete.
+  int reads = 0;
+  do {
+    const SongList songs = backend_->GetAlbumSongs(u"Artist 0"_s, u"Album %1"_s.arg(reads % 10));
+    EXPECT_EQ(12, songs.count());
+    ++reads;
+  } while (!scan.isFinished());
+  scan.waitForFinished();
+
+  EXPECT_EQ(song_count * 2, backend_->GetAllSongs().count());
+
+}
+
 } // namespace
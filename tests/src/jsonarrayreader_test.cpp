@@ -0,0 +1,358 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gtest_include.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QBuffer>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+
+#include "core/jsonarrayreader.h"
+#include "core/jsonreply.h"
+
+// Count the bytes allocated with malloc, which both Qt containers and operator new use, and the most bytes alive at the same time.
+// The allocator functions are replaced with ones calling the glibc allocator, other C libraries and sanitizers are not supported.
+// They are declared noexcept like glibc declares them.
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#  define HAVE_MALLOC_COUNTING
+#  include <malloc.h>
+#endif
+
+namespace {
+std::atomic<qint64> sAllocations(0);
+std::atomic<qint64> sLiveBytes(0);
+std::atomic<qint64> sPeakLiveBytes(0);
+
+#ifdef HAVE_MALLOC_COUNTING
+
+void CountAllocated(void *ptr) {
+
+  if (!ptr) return;
+  ++sAllocations;
+  const qint64 live = sLiveBytes += static_cast<qint64>(malloc_usable_size(ptr));
+  qint64 peak = sPeakLiveBytes;
+  while (live > peak && !sPeakLiveBytes.compare_exchange_weak(peak, live)) {}
+
+}
+
+void CountFreed(void *ptr) {
+
+  if (!ptr) return;
+  sLiveBytes -= static_cast<qint64>(malloc_usable_size(ptr));
+
+}
+
+#endif  // HAVE_MALLOC_COUNTING
+
+// Starts measuring the peak, returns the bytes alive now.
+qint64 StartCounting() {
+
+  const qint64 live = sLiveBytes;
+  sPeakLiveBytes = live;
+  return live;
+
+}
+
+}  // namespace
+
+#ifdef HAVE_MALLOC_COUNTING
+
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(std::size_t size) noexcept {
+
+  void *ptr = __libc_malloc(size);
+  CountAllocated(ptr);
+  return ptr;
+
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept {
+
+  void *ptr = __libc_calloc(count, size);
+  CountAllocated(ptr);
+  return ptr;
+
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept {
+
+  CountFreed(ptr);
+  void *new_ptr = __libc_realloc(ptr, size);
+  // A failed realloc keeps the old block.
+  CountAllocated(new_ptr || size == 0 ? new_ptr : ptr);
+  return new_ptr;
+
+}
+
+void *memalign(std::size_t alignment, std::size_t size) noexcept {
+
+  void *ptr = __libc_memalign(alignment, size);
+  CountAllocated(ptr);
+  return ptr;
+
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  return memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, std::size_t alignment, std::size_t size) noexcept {
+
+  *ptr = memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+
+}
+
+void free(void *ptr) noexcept {
+
+  CountFreed(ptr);
+  __libc_free(ptr);
+
+}
+
+}  // extern "C"
+
+#endif  // HAVE_MALLOC_COUNTING
+
+namespace {
+
+// Same layout as a Subsonic getAlbumList2 reply.
+QByteArray AlbumListReply(const int albums) {
+
+  QJsonArray array_albums;
+  for (int i = 0; i < albums; ++i) {
+    array_albums.append(QJsonObject{ { u"id"_s, QString::number(i) },
+                                     { u"name"_s, u"Album \"%1\""_s.arg(i) },
+                                     { u"artist"_s, u"Artist [%1] {}"_s.arg(i) },
+                                     { u"artistId"_s, QString::number(i / 10) },
+                                     { u"coverArt"_s, u"al-%1"_s.arg(i) },
+                                     { u"songCount"_s, 12 },
+                                     { u"duration"_s, 2700 + i },
+                                     { u"year"_s, 2000 + (i % 25) },
+                                     { u"genre"_s, u"Rock"_s },
+                                     { u"starred"_s, false },
+                                     { u"created"_s, u"2024-01-01T00:00:00.000Z"_s },
+                                     { u"genres"_s, QJsonArray{ QJsonObject{ { u"name"_s, u"Rock"_s } } } } });
+  }
+
+  QJsonObject object_response{ { u"status"_s, u"ok"_s },
+                               { u"version"_s, u"1.16.1"_s },
+                               { u"albumList2"_s, QJsonObject{ { u"album"_s, array_albums } } } };
+
+  return QJsonDocument(QJsonObject{ { u"subsonic-response"_s, object_response } }).toJson(QJsonDocument::Indented);
+
+}
+
+// Reads the album ids like the requests do for replies that are parsed as a whole document.
+QStringList ReadDocument(QIODevice *device) {
+
+  QStringList ids;
+  const JsonReply json_reply = JsonReply::Parse(device->readAll());
+  const QJsonObject json_object = json_reply.json_document.object()["subsonic-response"_L1].toObject()["albumList2"_L1].toObject();
+  const QJsonArray array_albums = json_object["album"_L1].toArray();
+  for (const QJsonValue &value_album : array_albums) {
+    ids << value_album.toObject()["id"_L1].toString();
+  }
+
+  return ids;
+
+}
+
+QStringList ReadDocument(const QByteArray &data) {
+
+  QBuffer buffer;
+  buffer.setData(data);
+  buffer.open(QIODevice::ReadOnly);
+  return ReadDocument(&buffer);
+
+}
+
+// Reads the album ids like SubsonicRequest does for album lists.
+QStringList ReadStreaming(QIODevice *device) {
+
+  QStringList ids;
+  const JsonReply json_reply = JsonReply::ParseArray(device, QByteArrayList() << "subsonic-response" << "albumList2" << "album", [&ids](const QJsonObject &object_album) { ids << object_album["id"_L1].toString(); });
+  EXPECT_TRUE(json_reply.array_found);
+  EXPECT_FALSE(json_reply.array_error);
+
+  return ids;
+
+}
+
+TEST(JsonArrayReaderTest, ReadsNestedArray) {
+
+  const QByteArray data = R"({"a": 1, "b": {"x": [1, {"y": "]}"}], "c": [{"id": "1"}, {"id": "2\"}"} , {"id": 3}]}})";
+  JsonArrayReader json_array_reader(data, QByteArrayList() << "b" << "c");
+  ASSERT_TRUE(json_array_reader.found());
+
+  QJsonObject json_object;
+  ASSERT_TRUE(json_array_reader.Next(json_object));
+  EXPECT_EQ(u"1"_s, json_object["id"_L1].toString());
+  ASSERT_TRUE(json_array_reader.Next(json_object));
+  EXPECT_EQ(u"2\"}"_s, json_object["id"_L1].toString());
+  ASSERT_TRUE(json_array_reader.Next(json_object));
+  EXPECT_EQ(3, json_object["id"_L1].toInt());
+  EXPECT_FALSE(json_array_reader.Next(json_object));
+  EXPECT_FALSE(json_array_reader.error());
+
+}
+
+TEST(JsonArrayReaderTest, MissingPath) {
+
+  QJsonObject json_object;
+
+  JsonArrayReader missing_key(R"({"subsonic-response": {"status": "failed", "error": {"code": 40}}})", QByteArrayList() << "subsonic-response" << "albumList2" << "album");
+  EXPECT_FALSE(missing_key.found());
+  EXPECT_FALSE(missing_key.Next(json_object));
+
+  JsonArrayReader not_array(R"({"a": {"b": null}})", QByteArrayList() << "a" << "b");
+  EXPECT_FALSE(not_array.found());
+
+  JsonArrayReader empty(R"({"a": {"b": []}})", QByteArrayList() << "a" << "b");
+  EXPECT_TRUE(empty.found());
+  EXPECT_FALSE(empty.Next(json_object));
+  EXPECT_FALSE(empty.error());
+
+}
+
+TEST(JsonArrayReaderTest, InvalidElement) {
+
+  QJsonObject json_object;
+
+  JsonArrayReader not_object(R"({"a": [{"id": 1}, 2]})", QByteArrayList() << "a");
+  ASSERT_TRUE(not_object.found());
+  EXPECT_TRUE(not_object.Next(json_object));
+  EXPECT_FALSE(not_object.Next(json_object));
+  EXPECT_TRUE(not_object.error());
+
+  JsonArrayReader truncated(R"({"a": [{"id": 1}, {"id": )", QByteArrayList() << "a");
+  ASSERT_TRUE(truncated.found());
+  EXPECT_TRUE(truncated.Next(json_object));
+  EXPECT_FALSE(truncated.Next(json_object));
+  EXPECT_TRUE(truncated.error());
+
+}
+
+TEST(JsonArrayReaderTest, ReadsFromDevice) {
+
+  // Larger than the chunks read from the device, so elements span chunks and read elements are dropped.
+  const QByteArray data = AlbumListReply(2000);
+
+  QBuffer buffer;
+  buffer.setData(data);
+  ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+
+  QStringList ids;
+  JsonArrayReader json_array_reader(&buffer, QByteArrayList() << "subsonic-response" << "albumList2" << "album");
+  ASSERT_TRUE(json_array_reader.found());
+  QJsonObject object_album;
+  while (json_array_reader.Next(object_album)) {
+    ids << object_album["id"_L1].toString();
+  }
+
+  EXPECT_FALSE(json_array_reader.error());
+  EXPECT_EQ(ReadDocument(data), ids);
+
+}
+
+TEST(JsonArrayReaderTest, ReadAllFromDevice) {
+
+  const QByteArray data = R"({"subsonic-response": {"status": "failed", "error": {"code": 40}}})";
+
+  QBuffer buffer;
+  buffer.setData(data);
+  ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+
+  JsonArrayReader json_array_reader(&buffer, QByteArrayList() << "subsonic-response" << "albumList2" << "album");
+  EXPECT_FALSE(json_array_reader.found());
+  EXPECT_EQ(data, json_array_reader.ReadAll());
+
+}
+
+TEST(JsonReplyTest, ParseArrayFromDevice) {
+
+  const QByteArray data = AlbumListReply(500);
+
+  QBuffer buffer;
+  buffer.setData(data);
+  ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+
+  const QStringList ids = ReadStreaming(&buffer);
+  ASSERT_EQ(500, ids.count());
+  EXPECT_EQ(ReadDocument(data), ids);
+
+}
+
+TEST(JsonReplyTest, ParseArrayPeakMemory) {
+
+#ifndef HAVE_MALLOC_COUNTING
+  GTEST_SKIP() << "Allocations are only counted with the glibc allocator";
+#endif
+
+  // The reply data is alive for both ways of reading it, like the data of a finished network reply.
+  const QByteArray data = AlbumListReply(2000);
+
+  QBuffer document_buffer;
+  document_buffer.setData(data);
+  ASSERT_TRUE(document_buffer.open(QIODevice::ReadOnly));
+  const qint64 document_allocations_start = sAllocations;
+  const qint64 document_start = StartCounting();
+  const QStringList document_ids = ReadDocument(&document_buffer);
+  const qint64 document_peak = sPeakLiveBytes - document_start;
+  const qint64 document_allocations = sAllocations - document_allocations_start;
+
+  QBuffer streaming_buffer;
+  streaming_buffer.setData(data);
+  ASSERT_TRUE(streaming_buffer.open(QIODevice::ReadOnly));
+  const qint64 streaming_allocations_start = sAllocations;
+  const qint64 streaming_start = StartCounting();
+  const QStringList streaming_ids = ReadStreaming(&streaming_buffer);
+  const qint64 streaming_peak = sPeakLiveBytes - streaming_start;
+  const qint64 streaming_allocations = sAllocations - streaming_allocations_start;
+
+  std::cout << "Document: " << document_allocations << " allocations, " << document_peak << " bytes at most alive" << std::endl;
+  std::cout << "Streaming: " << streaming_allocations << " allocations, " << streaming_peak << " bytes at most alive" << std::endl;
+
+  ASSERT_EQ(2000, streaming_ids.count());
+  EXPECT_EQ(document_ids, streaming_ids);
+  // The document holds a copy of the reply data and the whole tree, the streaming reader only one chunk and one album.
+  EXPECT_LT(streaming_peak * 4, document_peak);
+
+}
+
+}  // namespace
@@ -31,6 +31,7 @@
 #include "mock_playlistitem.h"
 
 #include <QtDebug>
+#include <QStringList>
 #include <QUndoStack>
 
 using ::testing::Return;
@@ -65,6 +66,26 @@ class PlaylistTest : public ::testing::Test {
     return PlaylistItemPtr(MakeMockItem(title, artist, album, length));
   }
 
+  PlaylistItemPtr MakeMockTrackP(const QString &title, const QString &album, const int disc, const int track) const {
+    Song metadata;
+    metadata.Init(title, u"Artist"_s, album, 123);
+    metadata.set_disc(disc);
+    metadata.set_track(track);
+
+    MockPlaylistItem *ret = new MockPlaylistItem;
+    EXPECT_CALL(*ret, OriginalMetadata()).WillRepeatedly(Return(metadata));
+
+    return PlaylistItemPtr(ret);
+  }
+
+  QStringList Titles() const {
+    QStringList titles;
+    for (int i = 0; i < playlist_.rowCount(QModelIndex()); ++i) {
+      titles << playlist_.item_at(i)->EffectiveMetadata().title();
+    }
+    return titles;
+  }
+
   Playlist playlist_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
   PlaylistSequence sequence_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
 
@@ -474,6 +495,47 @@ TEST_F(PlaylistTest, ShuffleThenNext) {
 
 }
 
+TEST_F(PlaylistTest, SortByAlbum) {
+
+  playlist_.InsertItems(PlaylistItemPtrList()
+      << MakeMockTrackP(u"B2"_s, u"b album"_s, 1, 2)
+      << MakeMockTrackP(u"A3"_s, u"A album"_s, 2, 1)
+      << MakeMockTrackP(u"B1"_s, u"b album"_s, 1, 1)
+      << MakeMockTrackP(u"A2"_s, u"a album"_s, 1, 2)
+      << MakeMockTrackP(u"A1"_s, u"A album"_s, 1, 1));
+  ASSERT_EQ(5, playlist_.rowCount(QModelIndex()));
+
+  // Albums are compared case insensitively, then by disc and track.
+  playlist_.sort(static_cast<int>(Playlist::Column::Album), Qt::AscendingOrder);
+  EXPECT_EQ(QStringList() << u"A1"_s << u"A2"_s << u"A3"_s << u"B1"_s << u"B2"_s, Titles());
+
+  playlist_.sort(static_cast<int>(Playlist::Column::Album), Qt::DescendingOrder);
+  EXPECT_EQ(QStringList() << u"B2"_s << u"B1"_s << u"A3"_s << u"A2"_s << u"A1"_s, Titles());
+
+}
+
+TEST_F(PlaylistTest, SortIsStable) {
+
+  // More items than one sort chunk, so the merge of the chunks is covered too.
+  PlaylistItemPtrList items;
+  for (int i = 0; i < 4500; ++i) {
+    items << MakeMockItemP(QString::number(i), i % 3 == 0 ? u"Artist"_s : u"artist"_s);
+  }
+  items << MakeMockItemP(u"first"_s, u"Another artist"_s);
+  playlist_.InsertItems(items);
+  ASSERT_EQ(4501, playlist_.rowCount(QModelIndex()));
+
+  playlist_.sort(static_cast<int>(Playlist::Column::Artist), Qt::AscendingOrder);
+
+  // Artists that compare equal keep the order they were inserted in.
+  QStringList expected_titles = QStringList() << u"first"_s;
+  for (int i = 0; i < 4500; ++i) {
+    expected_titles << QString::number(i);
+  }
+  EXPECT_EQ(expected_titles, Titles());
+
+}
+
 TEST_F(PlaylistTest, CollectionIdMapSingle) {
 
   Song song(Song::Source::Collection);
@@ -0,0 +1,147 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <memory>
+
+#include "gtest_include.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QThread>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+
+#include "includes/shared_ptr.h"
+#include "core/song.h"
+#include "core/memorydatabase.h"
+#include "core/sqlquery.h"
+#include "core/songloader.h"
+#include "core/urlhandlers.h"
+#include "tagreader/tagreaderclient.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionlibrary.h"
+
+#include "test_utils.h"
+
+using namespace Qt::Literals::StringLiterals;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+class SongLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+
+    ASSERT_TRUE(temp_dir_.isValid());
+
+    database_ = make_shared<MemoryDatabase>(nullptr);
+    backend_ = make_shared<CollectionBackend>();
+    backend_->Init(database_, nullptr, Song::Source::Collection, QLatin1String(CollectionLibrary::kSongsTable), QLatin1String(CollectionLibrary::kDirsTable), QLatin1String(CollectionLibrary::kSubdirsTable));
+    backend_->AddDirectory(temp_dir_.path());
+
+    tagreader_client_ = make_shared<TagReaderClient>();
+    tagreader_client_thread_ = new QThread();
+    tagreader_client_->moveToThread(tagreader_client_thread_);
+    tagreader_client_thread_->start();
+
+  }
+
+  void TearDown() override {
+
+    tagreader_client_thread_->exit();
+    tagreader_client_thread_->wait(5000);
+    delete tagreader_client_thread_;
+
+  }
+
+  // Writes a file that is not real audio, so its tags can only come from the collection.
+  QString WriteFile(const QString &name) const {
+
+    const QString filename = temp_dir_.filePath(name);
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) return QString();
+    file.write(QByteArray(1024, '\0'));
+    file.close();
+
+    return filename;
+
+  }
+
+  // Adds the song to the collection, with the URL stored in the given encoding.
+  void AddSong(const QString &filename, const QString &title, const QString &stored_url) {
+
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_title(title);
+    song.set_url(QUrl::fromLocalFile(filename));
+    song.set_filetype(Song::FileType::FLAC);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1024);
+    backend_->AddOrUpdateSongs(SongList() << song);
+
+    QSqlDatabase db(database_->Connect());
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("UPDATE %1 SET url = :stored_url WHERE url = :url").arg(QLatin1String(CollectionLibrary::kSongsTable)));
+    q.BindValue(u":stored_url"_s, stored_url);
+    q.BindValue(u":url"_s, song.url().toString(QUrl::FullyEncoded));
+    ASSERT_TRUE(q.Exec());
+
+  }
+
+  QTemporaryDir temp_dir_;
+  SharedPtr<Database> database_;
+  SharedPtr<CollectionBackend> backend_;
+  SharedPtr<TagReaderClient> tagreader_client_;
+  QThread *tagreader_client_thread_;
+};
+
+TEST_F(SongLoaderTest, LoadsSongsStoredWithAnotherUrlEncoding) {
+
+  const QStringList names = QStringList() << u"1 100% Été.flac"_s << u"2 Ünïcödé [Live].flac"_s << u"3 A & B.flac"_s;
+  for (const QString &name : names) {
+    const QString filename = WriteFile(name);
+    ASSERT_FALSE(filename.isEmpty());
+    const QUrl url = QUrl::fromLocalFile(filename);
+    // Stored the way older versions did, not fully percent-encoded.
+    AddSong(filename, u"Title of "_s + name, url.toString());
+  }
+
+  SongLoader loader(make_shared<UrlHandlers>(), backend_, tagreader_client_);
+  ASSERT_EQ(SongLoader::Result::BlockingLoadRequired, loader.Load(QUrl::fromLocalFile(temp_dir_.path())));
+  ASSERT_EQ(SongLoader::Result::Success, loader.LoadFilenamesBlocking());
+  loader.LoadMetadataBlocking();
+
+  const SongList songs = loader.songs();
+  ASSERT_EQ(names.count(), songs.count());
+  for (const Song &song : songs) {
+    EXPECT_EQ(u"Title of "_s + song.url().fileName(), song.title());
+    EXPECT_EQ(Song::Source::Collection, song.source());
+  }
+
+}
+
+}  // namespace
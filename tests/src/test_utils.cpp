@@ -20,6 +20,8 @@
 
 #include "test_utils.h"
 
+#include <gst/gst.h>
+
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
@@ -62,6 +64,40 @@ void PrintTo(const ::QUrl &url, std::ostream &os) {
   os << url.toString().toStdString();
 }
 
+bool HasGstElements(const QStringList &factory_names) {
+
+  gst_init(nullptr, nullptr);
+
+  for (const QString &factory_name : factory_names) {
+    GstElementFactory *factory = gst_element_factory_find(factory_name.toUtf8().constData());
+    if (!factory) return false;
+    gst_object_unref(factory);
+  }
+
+  return true;
+
+}
+
+bool CreateAudioFile(const QString &filename, const QString &encoder, const int seconds, const int frequency) {
+
+  const QString description = u"audiotestsrc num-buffers=%1 samplesperbuffer=44100 freq=%2 ! audio/x-raw,rate=44100,channels=2 ! %3 ! filesink location=\"%4\""_s.arg(seconds).arg(frequency).arg(encoder, filename);
+
+  GstElement *pipeline = gst_parse_launch(description.toUtf8().constData(), nullptr);
+  if (!pipeline) return false;
+
+  gst_element_set_state(pipeline, GST_STATE_PLAYING);
+  GstBus *bus = gst_element_get_bus(pipeline);
+  GstMessage *msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE, static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  const bool success = msg && GST_MESSAGE_TYPE(msg) == GST_MESSAGE_EOS;
+  if (msg) gst_message_unref(msg);
+  gst_object_unref(bus);
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+  gst_object_unref(pipeline);
+
+  return success;
+
+}
+
 TemporaryResource::TemporaryResource(const QString &filename, QObject *parent) : QTemporaryFile(parent) {
 
   setFileTemplate(QDir::tempPath() + u"/strawberry_test-XXXXXX."_s + filename.section(u'.', -1, -1));
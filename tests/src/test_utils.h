@@ -26,6 +26,7 @@
 #include <QMetaType>
 #include <QModelIndex>
 #include <QTemporaryFile>
+#include <QStringList>
 
 class QNetworkRequest;
 class QString;
@@ -60,6 +61,12 @@ void PrintTo(const ::QUrl& url, std::ostream& os);
 
 Q_DECLARE_METATYPE(QModelIndex)
 
+// Returns false if any of the GStreamer elements is not installed.
+bool HasGstElements(const QStringList &factory_names);
+
+// Writes an audio file with the given number of seconds of a sine wave, encoded by the encoder element, for example wavenc or flacenc.
+bool CreateAudioFile(const QString &filename, const QString &encoder, const int seconds, const int frequency = 440);
+
 class TemporaryResource : public QTemporaryFile {
   Q_OBJECT
 
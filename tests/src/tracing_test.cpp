@@ -0,0 +1,109 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gtest_include.h"
+
+#include <QMutex>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+
+#include "core/tracing.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace {
+
+TEST(TracingTest, WritesChromeTrace) {
+
+  QTemporaryDir temp_dir;
+  ASSERT_TRUE(temp_dir.isValid());
+  const QString filename = temp_dir.filePath(u"trace.json"_s);
+
+  EXPECT_FALSE(tracing::IsEnabled());
+  {
+    TRACE_SCOPE("test", "Before init");
+  }
+
+  tracing::Init(filename, false);
+  ASSERT_TRUE(tracing::IsEnabled());
+
+  {
+    TRACE_SCOPE("test", "Scope");
+  }
+  QMutex mutex;
+  {
+    tracing::MutexLocker<QMutex> l(&mutex, "test", "Lock wait");
+  }
+  EXPECT_TRUE(mutex.tryLock());
+  mutex.unlock();
+  tracing::SetCounter("test", "Counter", 5);
+  tracing::IncrementCounter("test", "Counter", 2);
+  tracing::AddInstant("test", "Instant");
+
+  const QString summary = tracing::Summary();
+  EXPECT_TRUE(summary.contains(u"test/Scope: 1,"_s));
+  EXPECT_TRUE(summary.contains(u"test/Counter: 7, 7"_s));
+  // Only contended locks are recorded.
+  EXPECT_FALSE(summary.contains(u"test/Lock wait"_s));
+  EXPECT_FALSE(summary.contains(u"test/Before init"_s));
+
+  tracing::Shutdown();
+  EXPECT_FALSE(tracing::IsEnabled());
+
+  QFile file(filename);
+  ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+  const QJsonDocument json_document = QJsonDocument::fromJson(file.readAll());
+  ASSERT_TRUE(json_document.isObject());
+  const QJsonArray events = json_document.object()[u"traceEvents"_s].toArray();
+
+  bool found_thread_name = false;
+  bool found_scope = false;
+  bool found_instant = false;
+  qint64 counter_value = -1;
+  for (const QJsonValue &value : events) {
+    const QJsonObject event = value.toObject();
+    const QString name = event[u"name"_s].toString();
+    const QString phase = event[u"ph"_s].toString();
+    if (phase == "M"_L1 && name == "thread_name"_L1) {
+      found_thread_name = true;
+    }
+    else if (phase == "X"_L1 && name == "Scope"_L1) {
+      found_scope = event[u"cat"_s].toString() == "test"_L1 && event.contains(u"dur"_s) && event.contains(u"ts"_s);
+    }
+    else if (phase == "i"_L1 && name == "Instant"_L1) {
+      found_instant = true;
+    }
+    else if (phase == "C"_L1 && name == "Counter"_L1) {
+      counter_value = event[u"args"_s].toObject()[u"Counter"_s].toInteger();
+    }
+  }
+
+  EXPECT_TRUE(found_thread_name);
+  EXPECT_TRUE(found_scope);
+  EXPECT_TRUE(found_instant);
+  EXPECT_EQ(7, counter_value);
+
+}
+
+}  // namespace
@@ -0,0 +1,166 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, agent <agent@local>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include "gtest_include.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QEventLoop>
+#include <QTemporaryDir>
+
+#include "core/song.h"
+#include "transcoder/transcoder.h"
+
+#include "test_utils.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static
+
+namespace {
+
+class TranscoderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+
+    if (!HasGstElements(QStringList() << u"audiotestsrc"_s << u"wavenc"_s << u"wavparse"_s << u"flacenc"_s)) {
+      GTEST_SKIP() << "Missing GStreamer elements";
+    }
+
+    ASSERT_TRUE(temp_dir_.isValid());
+
+  }
+
+  // Writes a wav file with the given number of seconds of a sine wave.
+  QString CreateWavFile(const int index, const int seconds) const {
+
+    const QString filename = temp_dir_.filePath(u"input-%1.wav"_s.arg(index));
+    return CreateAudioFile(filename, u"wavenc"_s, seconds) ? filename : QString();
+
+  }
+
+  static void RunTranscoder(Transcoder *transcoder) {
+
+    QEventLoop loop;
+    QObject::connect(transcoder, &Transcoder::AllJobsComplete, &loop, &QEventLoop::quit);
+    transcoder->Start();
+    if (transcoder->QueuedJobsCount() > 0 || !transcoder->GetProgress().isEmpty()) {
+      loop.exec();
+    }
+
+  }
+
+  QTemporaryDir temp_dir_;
+};
+
+TEST_F(TranscoderTest, StartsLongestJobFirst) {
+
+  const QList<int> lengths = QList<int>() << 1 << 4 << 2 << 3;
+
+  Transcoder transcoder;
+  transcoder.set_max_threads(1);
+  const TranscoderPreset preset = Transcoder::PresetForFileType(Song::FileType::FLAC);
+  for (int i = 0; i < lengths.count(); ++i) {
+    const QString input = CreateWavFile(i, lengths[i]);
+    ASSERT_FALSE(input.isEmpty());
+    transcoder.AddJob(input, preset, temp_dir_.filePath(u"output-%1.flac"_s.arg(i)));
+  }
+
+  QStringList completed;
+  QObject::connect(&transcoder, &Transcoder::JobComplete, &transcoder, [&completed](const QString &input, const QString&, const bool success) {
+    EXPECT_TRUE(success);
+    completed << input;
+  });
+
+  RunTranscoder(&transcoder);
+
+  ASSERT_EQ(4, completed.count());
+  EXPECT_EQ(temp_dir_.filePath(u"input-1.wav"_s), completed[0]);
+  EXPECT_EQ(temp_dir_.filePath(u"input-3.wav"_s), completed[1]);
+  EXPECT_EQ(temp_dir_.filePath(u"input-2.wav"_s), completed[2]);
+  EXPECT_EQ(temp_dir_.filePath(u"input-0.wav"_s), completed[3]);
+
+}
+
+TEST_F(TranscoderTest, StartAfterEachJobKeepsOneRun) {
+
+  const QList<int> lengths = QList<int>() << 2 << 3 << 1;
+
+  Transcoder transcoder;
+  transcoder.set_max_threads(1);
+
+  int runs = 0;
+  QObject::connect(&transcoder, &Transcoder::LogLine, &transcoder, [&runs](const QString &message) {
+    if (message.startsWith("Transcoding "_L1)) ++runs;
+  });
+
+  // Add and start the jobs one at a time, like organize does.
+  const TranscoderPreset preset = Transcoder::PresetForFileType(Song::FileType::FLAC);
+  int total_seconds = 0;
+  for (int i = 0; i < lengths.count(); ++i) {
+    const QString input = CreateWavFile(i, lengths[i]);
+    ASSERT_FALSE(input.isEmpty());
+    transcoder.AddJob(input, preset, temp_dir_.filePath(u"output-%1.flac"_s.arg(i)));
+    transcoder.Start();
+    total_seconds += lengths[i];
+  }
+
+  RunTranscoder(&transcoder);
+
+  EXPECT_EQ(1, runs);
+  EXPECT_NEAR(static_cast<double>(total_seconds), transcoder.GetStatistics().audio_seconds, 0.5 * lengths.count());
+
+}
+
+TEST_F(TranscoderTest, ReportsStatistics) {
+
+  constexpr int corpus_size = 4;
+
+  Transcoder transcoder;
+  const TranscoderPreset preset = Transcoder::PresetForFileType(Song::FileType::FLAC);
+  int total_seconds = 0;
+  for (int i = 0; i < corpus_size; ++i) {
+    // Mix of short and long tracks, like a typical album.
+    const int seconds = 2 + ((i * 7) % 11);
+    const QString input = CreateWavFile(i, seconds);
+    ASSERT_FALSE(input.isEmpty());
+    transcoder.AddJob(input, preset, temp_dir_.filePath(u"output-%1.flac"_s.arg(i)));
+    total_seconds += seconds;
+  }
+
+  int succeeded = 0;
+  QObject::connect(&transcoder, &Transcoder::JobComplete, &transcoder, [&succeeded](const QString&, const QString&, const bool success) {
+    if (success) ++succeeded;
+  });
+
+  RunTranscoder(&transcoder);
+
+  const Transcoder::Statistics statistics = transcoder.GetStatistics();
+
+  EXPECT_EQ(corpus_size, succeeded);
+  EXPECT_NEAR(static_cast<double>(total_seconds), statistics.audio_seconds, 0.5 * corpus_size);
+  EXPECT_GT(statistics.throughput, 0.0);
+  EXPECT_DOUBLE_EQ(0.0, statistics.eta_seconds);
+
+}
+
+}  // namespace